@@ -0,0 +1,23 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Entry-point for benchmarks.
+ **/
+#include "benchmarks/Benchmark.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main( int   i_argc,
+          char* i_argv[] ) {
+  // optional filter: only benchmarks whose name contains the given string are run
+  std::string l_filter = i_argc > 1 ? i_argv[1] : "";
+
+  unsigned int l_count = tsunami_lab::benchmarks::Benchmark::run( l_filter,
+                                                                  std::cout );
+  std::cout << std::flush;
+
+  return l_count > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
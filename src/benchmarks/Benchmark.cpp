@@ -0,0 +1,47 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Minimal registry and reporting for benchmarks.
+ **/
+#include "Benchmark.h"
+#include <iomanip>
+
+using namespace tsunami_lab::benchmarks;
+
+std::vector< std::pair< std::string, Benchmark::t_function > > & Benchmark::registry() {
+	static std::vector< std::pair< std::string, t_function > > benchmarks;
+	return benchmarks;
+}
+
+Benchmark::Benchmark( std::string const & in_name,
+                      t_function in_function ) {
+	registry().push_back( std::make_pair( in_name, in_function ) );
+}
+
+unsigned int Benchmark::run( std::string const & in_filter,
+                             std::ostream & io_stream ) {
+	unsigned int count = 0;
+	for( std::size_t benchmark = 0; benchmark < registry().size(); benchmark++ ) {
+		if( registry()[benchmark].first.find( in_filter ) == std::string::npos ) continue;
+
+		io_stream << "# " << registry()[benchmark].first << std::endl;
+		registry()[benchmark].second( io_stream );
+		count++;
+	}
+	return count;
+}
+
+void Benchmark::report( std::ostream & io_stream,
+                        std::string const & in_name,
+                        std::string const & in_metric,
+                        double in_value,
+                        std::string const & in_unit ) {
+	std::ios_base::fmtflags flags = io_stream.flags();
+	io_stream << std::left << std::setw(48) << in_name << " "
+	          << std::setw(24) << in_metric << " "
+	          << std::right << std::setw(14) << std::fixed << std::setprecision(3) << in_value << " "
+	          << in_unit << "\n";
+	io_stream.flags( flags );
+}
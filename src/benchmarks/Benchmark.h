@@ -0,0 +1,103 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Minimal registry and reporting for benchmarks.
+ **/
+#ifndef TSUNAMI_LAB_BENCHMARKS_BENCHMARK
+#define TSUNAMI_LAB_BENCHMARKS_BENCHMARK
+
+#include "../instrumentation/Profiler.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tsunami_lab {
+	namespace benchmarks {
+		class Benchmark;
+	}
+}
+
+/**
+ * @brief Registers a benchmark when constructed as a static object in a *.bench.cpp file.
+ **/
+class tsunami_lab::benchmarks::Benchmark {
+	public:
+		//! signature of a benchmark; results are reported to the given stream
+		typedef void (*t_function)( std::ostream & io_stream );
+
+	private:
+		/**
+		 * @brief Gets all registered benchmarks.
+		 *
+		 * @return registered benchmarks; first: name, second: function.
+		 **/
+		static std::vector< std::pair< std::string, t_function > > & registry();
+
+	public:
+		/**
+		 * @brief Registers a benchmark.
+		 *
+		 * @param in_name name of the benchmark.
+		 * @param in_function function which runs the benchmark.
+		 **/
+		Benchmark( std::string const & in_name,
+		           t_function in_function );
+
+		/**
+		 * @brief Runs all registered benchmarks whose name contains the filter.
+		 *
+		 * @param in_filter substring of the names to run; empty string runs all benchmarks.
+		 * @param io_stream stream to which the results are written.
+		 * @return number of benchmarks which were run.
+		 **/
+		static unsigned int run( std::string const & in_filter,
+		                         std::ostream & io_stream );
+
+		/**
+		 * @brief Measures the median duration of a repeated run; a first, unmeasured run warms up caches and page tables.
+		 *
+		 * The median is insensitive to single outliers, which keeps the results comparable between versions.
+		 *
+		 * @param in_repetitions number of measured runs.
+		 * @param in_run callable which performs one run.
+		 * @return median duration of a run in seconds.
+		 *
+		 * @tparam t_run type of the callable.
+		 **/
+		template< typename t_run >
+		static double median( unsigned int in_repetitions,
+		                      t_run in_run ) {
+			in_run();
+
+			std::vector< double > times( in_repetitions );
+			for( unsigned int repetition = 0; repetition < in_repetitions; repetition++ ) {
+				double start = instrumentation::Profiler::now();
+				in_run();
+				times[repetition] = instrumentation::Profiler::now() - start;
+			}
+
+			std::sort( times.begin(), times.end() );
+			return in_repetitions % 2 == 1 ? times[in_repetitions / 2] : ( times[in_repetitions / 2 - 1] + times[in_repetitions / 2] ) / 2;
+		}
+
+		/**
+		 * @brief Writes a single result as one line; the format is stable to allow diffs between versions.
+		 *
+		 * @param io_stream stream to which the result is written.
+		 * @param in_name name of the benchmark (including its parameters).
+		 * @param in_metric name of the metric.
+		 * @param in_value measured value.
+		 * @param in_unit unit of the measured value.
+		 **/
+		static void report( std::ostream & io_stream,
+		                    std::string const & in_name,
+		                    std::string const & in_metric,
+		                    double in_value,
+		                    std::string const & in_unit );
+};
+
+#endif
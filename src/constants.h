@@ -14,12 +14,36 @@ namespace tsunami_lab {
   typedef std::size_t t_idx;
   typedef t_idx idx;
 
-  //! floating point type
+  //! floating point type of the stored quantities, selected by the build (scons precision=single|double|mixed)
+#ifdef TSUNAMI_LAB_USE_DOUBLE
+  typedef double t_real;
+#else
   typedef float t_real;
+#endif
   typedef t_real real;
 
+  //! floating point type of the f-wave solver and of the updates of the cells; double in mixed precision builds
+#ifdef TSUNAMI_LAB_USE_MIXED_PRECISION
+  typedef double t_realCompute;
+#else
+  typedef t_real t_realCompute;
+#endif
+  typedef t_realCompute realCompute;
+
+  //! name of the floating point configuration of the build
+#if defined(TSUNAMI_LAB_USE_DOUBLE) && defined(TSUNAMI_LAB_USE_MIXED_PRECISION)
+#error "double and mixed precision are mutually exclusive"
+#elif defined(TSUNAMI_LAB_USE_DOUBLE)
+  char const * const precisionName = "double";
+#elif defined(TSUNAMI_LAB_USE_MIXED_PRECISION)
+  char const * const precisionName = "mixed";
+#else
+  char const * const precisionName = "single";
+#endif
+
   enum Solver { ROE, FWAVE };
   enum Boundary { OUTFLOW, REFLECTING };
+  enum Splitting { UNSPLIT, GODUNOV, STRANG };
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Low-overhead timers of the phases of the time loop.
+ **/
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace tsunami_lab::instrumentation;
+
+namespace {
+	//! accumulated values of a thread
+	struct Counters {
+		double seconds[Profiler::PHASE_COUNT] = {};
+		tsunami_lab::idx calls[Profiler::PHASE_COUNT] = {};
+	};
+
+	//! names of the phases in the report and keys of the JSON report
+	char const * const phaseNames[Profiler::PHASE_COUNT] = { "ghost cells", "x-sweeps", "y-sweeps", "solver", "output" };
+	char const * const phaseKeys[Profiler::PHASE_COUNT] = { "ghost_cells", "sweep_x", "sweep_y", "solver", "output" };
+
+	/**
+	 * @brief Gets the counters of all threads which timed a phase; they outlive their threads.
+	 *
+	 * @return counters.
+	 **/
+	std::vector< std::unique_ptr< Counters > > & registry() {
+		static std::vector< std::unique_ptr< Counters > > counters;
+		return counters;
+	}
+
+	/**
+	 * @brief Gets the mutex which guards the registry.
+	 *
+	 * @return mutex.
+	 **/
+	std::mutex & registryMutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	//! counters of the calling thread, registered on its first timed call
+	thread_local Counters * countersLocal = nullptr;
+}
+
+bool Profiler::enabled = false;
+tsunami_lab::idx Profiler::stepCount = 0;
+double Profiler::stepTotal = 0;
+double Profiler::stepMin = 0;
+double Profiler::stepMax = 0;
+tsunami_lab::idx Profiler::cellUpdates = 0;
+
+void Profiler::reset() {
+	std::lock_guard< std::mutex > lock( registryMutex() );
+	for( std::size_t thread = 0; thread < registry().size(); thread++ ) {
+		*registry()[thread] = Counters();
+	}
+
+	stepCount = 0;
+	stepTotal = 0;
+	stepMin = 0;
+	stepMax = 0;
+	cellUpdates = 0;
+}
+
+double Profiler::now() {
+	return std::chrono::duration< double >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+void Profiler::add( Phase in_phase,
+                    double in_seconds ) {
+	if( countersLocal == nullptr ) {
+		std::lock_guard< std::mutex > lock( registryMutex() );
+		registry().push_back( std::unique_ptr< Counters >( new Counters() ) );
+		countersLocal = registry().back().get();
+	}
+
+	countersLocal->seconds[in_phase] += in_seconds;
+	countersLocal->calls[in_phase]++;
+}
+
+void Profiler::addStep( double in_seconds,
+                        idx in_cellCount ) {
+	stepMin = stepCount > 0 ? std::min( stepMin, in_seconds ) : in_seconds;
+	stepMax = std::max( stepMax, in_seconds );
+	stepTotal += in_seconds;
+	stepCount++;
+	cellUpdates += in_cellCount;
+}
+
+double Profiler::getSeconds( Phase in_phase ) {
+	std::lock_guard< std::mutex > lock( registryMutex() );
+	double seconds = 0;
+	for( std::size_t thread = 0; thread < registry().size(); thread++ ) {
+		seconds += registry()[thread]->seconds[in_phase];
+	}
+	return seconds;
+}
+
+tsunami_lab::idx Profiler::getCalls( Phase in_phase ) {
+	std::lock_guard< std::mutex > lock( registryMutex() );
+	idx calls = 0;
+	for( std::size_t thread = 0; thread < registry().size(); thread++ ) {
+		calls += registry()[thread]->calls[in_phase];
+	}
+	return calls;
+}
+
+void Profiler::report( std::ostream & io_stream ) {
+	io_stream << "timing (thread time of the phases, the solver is part of the sweeps)" << std::endl;
+	for( unsigned short phase = 0; phase < PHASE_COUNT; phase++ ) {
+		std::string label = std::string( phaseNames[phase] ) + ":";
+		label.resize( 32, ' ' );
+		io_stream << "  " << label << getSeconds( Phase( phase ) ) << " s in " << getCalls( Phase( phase ) ) << " calls" << std::endl;
+	}
+	io_stream << "  number of time steps:           " << stepCount << std::endl;
+	io_stream << "  time step min / avg / max:      " << getStepMin() * 1000 << " / " << getStepAverage() * 1000 << " / " << getStepMax() * 1000 << " ms" << std::endl;
+	io_stream << "  cell updates per second:        " << getCellUpdatesPerSecond() << std::endl;
+}
+
+void Profiler::reportJson( std::ostream & io_stream ) {
+	std::streamsize precision = io_stream.precision( 9 );
+
+	io_stream << "{\n  \"phases\": {\n";
+	for( unsigned short phase = 0; phase < PHASE_COUNT; phase++ ) {
+		io_stream << "    \"" << phaseKeys[phase] << "\": { \"seconds\": " << getSeconds( Phase( phase ) )
+		          << ", \"calls\": " << getCalls( Phase( phase ) ) << " }" << ( phase + 1 < PHASE_COUNT ? "," : "" ) << "\n";
+	}
+	io_stream << "  },\n";
+	io_stream << "  \"steps\": { \"count\": " << stepCount
+	          << ", \"min_seconds\": " << getStepMin()
+	          << ", \"avg_seconds\": " << getStepAverage()
+	          << ", \"max_seconds\": " << getStepMax() << " },\n";
+	io_stream << "  \"cell_updates\": " << cellUpdates << ",\n";
+	io_stream << "  \"cell_updates_per_second\": " << getCellUpdatesPerSecond() << "\n}\n";
+
+	io_stream.precision( precision );
+}
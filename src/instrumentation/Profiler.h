@@ -0,0 +1,215 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Low-overhead timers of the phases of the time loop.
+ **/
+#ifndef TSUNAMI_LAB_INSTRUMENTATION_PROFILER
+#define TSUNAMI_LAB_INSTRUMENTATION_PROFILER
+
+#include "../constants.h"
+#include <iostream>
+
+namespace tsunami_lab {
+	namespace instrumentation {
+		class Profiler;
+		class ScopedTimer;
+	}
+}
+
+/**
+ * @brief Accumulates the time spent in the phases of the time loop and the durations of the time steps.
+ *
+ * The profiler is always compiled and disabled by default. A disabled profiler costs one branch per timer.
+ * Every thread accumulates into its own counters, such that the timers of OpenMP regions and of the I/O thread do not synchronize;
+ * the totals of a phase are summed over the threads (thread time).
+ * Reading the totals, reset and addStep have to be called when no other thread times a phase.
+ **/
+class tsunami_lab::instrumentation::Profiler {
+	public:
+		//! instrumented phases; the solver calls are part of the sweeps
+		enum Phase {
+			GHOST_CELLS = 0,
+			SWEEP_X,
+			SWEEP_Y,
+			SOLVER,
+			OUTPUT,
+			PHASE_COUNT
+		};
+
+	private:
+		//! true if the timers measure
+		static bool enabled;
+
+		//! number of time steps
+		static idx stepCount;
+
+		//! total, shortest and longest duration of a time step in seconds
+		static double stepTotal, stepMin, stepMax;
+
+		//! number of cell updates of all time steps
+		static idx cellUpdates;
+
+	public:
+		/**
+		 * @brief Checks if the timers measure.
+		 *
+		 * @return true if enabled.
+		 **/
+		static bool isEnabled() {
+			return enabled;
+		}
+
+		/**
+		 * @brief Enables or disables the timers; the accumulated values are kept.
+		 *
+		 * @param in_enabled true to enable the timers.
+		 **/
+		static void setEnabled( bool in_enabled ) {
+			enabled = in_enabled;
+		}
+
+		/**
+		 * @brief Discards the accumulated values of all threads.
+		 **/
+		static void reset();
+
+		/**
+		 * @brief Gets the time of a monotonic clock.
+		 *
+		 * @return time in seconds.
+		 **/
+		static double now();
+
+		/**
+		 * @brief Adds the duration of a timed call of a phase to the counters of the calling thread.
+		 *
+		 * @param in_phase phase.
+		 * @param in_seconds duration in seconds.
+		 **/
+		static void add( Phase in_phase,
+		                 double in_seconds );
+
+		/**
+		 * @brief Adds a time step.
+		 *
+		 * @param in_seconds duration of the time step in seconds.
+		 * @param in_cellCount number of cells updated by the time step.
+		 **/
+		static void addStep( double in_seconds,
+		                     idx in_cellCount );
+
+		/**
+		 * @brief Gets the time spent in a phase, summed over the threads.
+		 *
+		 * @param in_phase phase.
+		 * @return time in seconds.
+		 **/
+		static double getSeconds( Phase in_phase );
+
+		/**
+		 * @brief Gets the number of timed calls of a phase, summed over the threads.
+		 *
+		 * @param in_phase phase.
+		 * @return number of calls.
+		 **/
+		static idx getCalls( Phase in_phase );
+
+		/**
+		 * @brief Gets the number of time steps.
+		 *
+		 * @return number of time steps.
+		 **/
+		static idx getStepCount() {
+			return stepCount;
+		}
+
+		/**
+		 * @brief Gets the shortest duration of a time step.
+		 *
+		 * @return duration in seconds; 0 without time steps.
+		 **/
+		static double getStepMin() {
+			return stepCount > 0 ? stepMin : 0;
+		}
+
+		/**
+		 * @brief Gets the average duration of a time step.
+		 *
+		 * @return duration in seconds; 0 without time steps.
+		 **/
+		static double getStepAverage() {
+			return stepCount > 0 ? stepTotal / stepCount : 0;
+		}
+
+		/**
+		 * @brief Gets the longest duration of a time step.
+		 *
+		 * @return duration in seconds.
+		 **/
+		static double getStepMax() {
+			return stepMax;
+		}
+
+		/**
+		 * @brief Gets the number of cell updates per second of the time steps.
+		 *
+		 * @return cell updates per second; 0 without time steps.
+		 **/
+		static double getCellUpdatesPerSecond() {
+			return stepTotal > 0 ? cellUpdates / stepTotal : 0;
+		}
+
+		/**
+		 * @brief Reports the phases and the time steps in human-readable form.
+		 *
+		 * @param io_stream stream to which the report is written.
+		 **/
+		static void report( std::ostream & io_stream );
+
+		/**
+		 * @brief Reports the phases and the time steps as JSON object.
+		 *
+		 * @param io_stream stream to which the report is written.
+		 **/
+		static void reportJson( std::ostream & io_stream );
+};
+
+/**
+ * @brief Times a phase from construction to destruction if the profiler is enabled.
+ **/
+class tsunami_lab::instrumentation::ScopedTimer {
+	private:
+		//! timed phase
+		Profiler::Phase phase;
+
+		//! true if the profiler was enabled at construction
+		bool active;
+
+		//! start of the timer in seconds
+		double start = 0;
+
+	public:
+		/**
+		 * @brief Starts the timer.
+		 *
+		 * @param in_phase timed phase.
+		 **/
+		explicit ScopedTimer( Profiler::Phase in_phase ): phase( in_phase ),
+		                                                   active( Profiler::isEnabled() ) {
+			if( active ) start = Profiler::now();
+		}
+
+		/**
+		 * @brief Stops the timer and adds the duration to the phase.
+		 **/
+		~ScopedTimer() {
+			if( active ) Profiler::add( phase, Profiler::now() - start );
+		}
+
+		ScopedTimer( ScopedTimer const & ) = delete;
+		ScopedTimer & operator=( ScopedTimer const & ) = delete;
+};
+
+#endif
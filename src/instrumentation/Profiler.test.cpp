@@ -0,0 +1,79 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the timers of the time loop.
+ **/
+#include <catch2/catch.hpp>
+#include "Profiler.h"
+#include <sstream>
+#include <string>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+TEST_CASE( "Test the timers of the time loop.", "[Profiler]" ) {
+  typedef tsunami_lab::instrumentation::Profiler Profiler;
+  typedef tsunami_lab::instrumentation::ScopedTimer ScopedTimer;
+
+  Profiler::reset();
+
+  // disabled timers do not count
+  REQUIRE( !Profiler::isEnabled() );
+  {
+    ScopedTimer timer( Profiler::SOLVER );
+  }
+  REQUIRE( Profiler::getCalls( Profiler::SOLVER ) == 0 );
+
+  // every thread counts its own calls, the totals are summed over the threads
+  Profiler::setEnabled( true );
+  int threadCount = 1;
+#pragma omp parallel
+  {
+#ifdef _OPENMP
+#pragma omp single
+    threadCount = omp_get_num_threads();
+#endif
+    for( unsigned short call = 0; call < 100; call++ ) {
+      ScopedTimer timer( Profiler::SWEEP_X );
+    }
+  }
+  {
+    ScopedTimer timer( Profiler::OUTPUT );
+    double start = Profiler::now();
+    while( Profiler::now() - start < 0.001 );
+  }
+  Profiler::setEnabled( false );
+
+  REQUIRE( Profiler::getCalls( Profiler::SWEEP_X ) == tsunami_lab::idx( 100 * threadCount ) );
+  REQUIRE( Profiler::getCalls( Profiler::SWEEP_Y ) == 0 );
+  REQUIRE( Profiler::getCalls( Profiler::OUTPUT ) == 1 );
+  REQUIRE( Profiler::getSeconds( Profiler::OUTPUT ) >= 0.001 );
+
+  // time steps
+  REQUIRE( Profiler::getStepMin() == 0 );
+  REQUIRE( Profiler::getCellUpdatesPerSecond() == 0 );
+  Profiler::addStep( 0.5, 100 );
+  Profiler::addStep( 0.25, 100 );
+  Profiler::addStep( 0.75, 100 );
+  REQUIRE( Profiler::getStepCount() == 3 );
+  REQUIRE( Profiler::getStepMin() == 0.25 );
+  REQUIRE( Profiler::getStepAverage() == 0.5 );
+  REQUIRE( Profiler::getStepMax() == 0.75 );
+  REQUIRE( Profiler::getCellUpdatesPerSecond() == 200 );
+
+  std::stringstream json;
+  Profiler::reportJson( json );
+  REQUIRE( json.str().find( "\"sweep_x\": { \"seconds\": " ) != std::string::npos );
+  REQUIRE( json.str().find( "\"steps\": { \"count\": 3, \"min_seconds\": 0.25, \"avg_seconds\": 0.5, \"max_seconds\": 0.75 }" ) != std::string::npos );
+  REQUIRE( json.str().find( "\"cell_updates_per_second\": 200\n}" ) != std::string::npos );
+
+  std::stringstream text;
+  Profiler::report( text );
+  REQUIRE( text.str().find( "  output:" ) != std::string::npos );
+
+  Profiler::reset();
+  REQUIRE( Profiler::getCalls( Profiler::SWEEP_X ) == 0 );
+  REQUIRE( Profiler::getStepCount() == 0 );
+}
@@ -0,0 +1,119 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for binary checkpoints of a simulation.
+ **/
+#include "Checkpoint.h"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+  //! identifies checkpoints, including the terminating zero
+  char const c_magic[8] = "TSLCKPT";
+
+  //! version of the layout
+  std::uint32_t const c_version = 1;
+}
+
+void tsunami_lab::io::Checkpoint::write( Header       const & i_header,
+                                         t_idx                i_stride,
+                                         t_real       const * i_h,
+                                         t_real       const * i_hu,
+                                         t_real       const * i_hv,
+                                         t_real       const * i_b,
+                                         std::ostream       & io_stream ) {
+  std::uint32_t l_format[2] = { c_version, sizeof(t_real) };
+  std::uint64_t l_counts[6] = { i_header.nx, i_header.ny,
+                                i_header.offsetX, i_header.offsetY,
+                                i_header.timeStep, i_header.snapshotCount };
+  double l_reals[2] = { i_header.time, i_header.waveSpeedMax };
+
+  io_stream.write( c_magic, sizeof(c_magic) );
+  io_stream.write( reinterpret_cast< char const * >( l_format ), sizeof(l_format) );
+  io_stream.write( reinterpret_cast< char const * >( l_counts ), sizeof(l_counts) );
+  io_stream.write( reinterpret_cast< char const * >( l_reals ), sizeof(l_reals) );
+
+  // one unformatted write per row; a single one per field if the rows are not padded
+  t_real const * l_fields[4] = { i_h, i_hu, i_hv, i_b };
+  std::vector< t_real > l_zeros;
+  for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) {
+    // missing fields are zero
+    if( l_fields[l_fi] == nullptr ) {
+      l_zeros.assign( i_header.nx, 0 );
+      for( t_idx l_iy = 0; l_iy < i_header.ny; l_iy++ ) {
+        io_stream.write( reinterpret_cast< char const * >( l_zeros.data() ),
+                         i_header.nx * sizeof(t_real) );
+      }
+      continue;
+    }
+
+    if( i_stride == i_header.nx ) {
+      io_stream.write( reinterpret_cast< char const * >( l_fields[l_fi] ),
+                       i_header.nx * i_header.ny * sizeof(t_real) );
+      continue;
+    }
+
+    for( t_idx l_iy = 0; l_iy < i_header.ny; l_iy++ ) {
+      io_stream.write( reinterpret_cast< char const * >( l_fields[l_fi] + l_iy * i_stride ),
+                       i_header.nx * sizeof(t_real) );
+    }
+  }
+  io_stream << std::flush;
+}
+
+bool tsunami_lab::io::Checkpoint::read( std::istream          & io_stream,
+                                        Header                & o_header,
+                                        std::vector< t_real > & o_h,
+                                        std::vector< t_real > & o_hu,
+                                        std::vector< t_real > & o_hv,
+                                        std::vector< t_real > & o_b ) {
+  char l_magic[8] = {};
+  std::uint32_t l_format[2] = {};
+  std::uint64_t l_counts[6] = {};
+  double l_reals[2] = {};
+
+  io_stream.read( l_magic, sizeof(l_magic) );
+  io_stream.read( reinterpret_cast< char * >( l_format ), sizeof(l_format) );
+  io_stream.read( reinterpret_cast< char * >( l_counts ), sizeof(l_counts) );
+  io_stream.read( reinterpret_cast< char * >( l_reals ), sizeof(l_reals) );
+
+  if( !io_stream ) return false;
+  if( std::memcmp( l_magic, c_magic, sizeof(c_magic) ) != 0 ) return false;
+  if( l_format[0] != c_version || l_format[1] != sizeof(t_real) ) return false;
+
+  // the fields have to fit into the rest of the stream before they are allocated, which rejects corrupt extents
+  std::uint64_t l_fieldsMax = std::numeric_limits< std::uint64_t >::max() / ( 4 * sizeof(t_real) );
+  if( l_counts[1] != 0 && l_counts[0] > l_fieldsMax / l_counts[1] ) return false;
+  std::uint64_t l_fieldsSize = 4 * sizeof(t_real) * l_counts[0] * l_counts[1];
+  if( l_fieldsSize > std::numeric_limits< std::size_t >::max() ) return false;
+
+  std::istream::pos_type l_position = io_stream.tellg();
+  if( l_position != std::istream::pos_type(-1) ) {
+    io_stream.seekg( 0, std::ios::end );
+    std::istream::pos_type l_end = io_stream.tellg();
+    io_stream.seekg( l_position );
+    if( !io_stream || std::uint64_t( l_end - l_position ) < l_fieldsSize ) return false;
+  }
+
+  o_header.nx = l_counts[0];
+  o_header.ny = l_counts[1];
+  o_header.offsetX = l_counts[2];
+  o_header.offsetY = l_counts[3];
+  o_header.timeStep = l_counts[4];
+  o_header.snapshotCount = l_counts[5];
+  o_header.time = l_reals[0];
+  o_header.waveSpeedMax = l_reals[1];
+
+  std::vector< t_real > * l_fields[4] = { &o_h, &o_hu, &o_hv, &o_b };
+  for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) {
+    l_fields[l_fi]->resize( o_header.nx * o_header.ny );
+    io_stream.read( reinterpret_cast< char * >( l_fields[l_fi]->data() ),
+                    o_header.nx * o_header.ny * sizeof(t_real) );
+  }
+
+  return bool( io_stream );
+}
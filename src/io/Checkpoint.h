@@ -0,0 +1,97 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for binary checkpoints of a simulation.
+ **/
+#ifndef TSUNAMI_LAB_IO_CHECKPOINT
+#define TSUNAMI_LAB_IO_CHECKPOINT
+
+#include "../constants.h"
+#include <iostream>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class Checkpoint;
+  }
+}
+
+/**
+ * Binary checkpoints which hold the state of a patch (or of a block of a distributed run) and of the time loop.
+ *
+ * Layout (native byte order):
+ *   magic "TSLCKPT" (8 bytes), format version and size of t_real in bytes (uint32 each),
+ *   nx, ny, offsetX, offsetY, timeStep, snapshotCount (uint64 each), time and waveSpeedMax (double each),
+ *   followed by the water height, momentum in x-direction, momentum in y-direction and bathymetry;
+ *   every field has nx * ny values of t_real in row-major order without padding.
+ * The fields are written without any formatting, i.e., a checkpoint costs about as much as a copy of the fields.
+ **/
+class tsunami_lab::io::Checkpoint {
+  public:
+    //! state of the time loop and extent of the fields
+    struct Header {
+      //! number of cells in x- and y-direction
+      t_idx nx = 0;
+      t_idx ny = 0;
+
+      //! id of the first cell in the domain, e.g., of a block of a distributed run
+      t_idx offsetX = 0;
+      t_idx offsetY = 0;
+
+      //! number of time steps performed
+      t_idx timeStep = 0;
+
+      //! number of snapshots written
+      t_idx snapshotCount = 0;
+
+      //! simulation time
+      t_real time = 0;
+
+      //! maximum wave speed, which determines the next time step
+      t_real waveSpeedMax = 0;
+    };
+
+    /**
+     * Writes a checkpoint.
+     *
+     * @param i_header state of the time loop and extent of the fields.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_h water height of the cells.
+     * @param i_hu momentum in x-direction of the cells.
+     * @param i_hv momentum in y-direction of the cells; nullptr writes zeros, e.g., for 1d patches.
+     * @param i_b bathymetry of the cells.
+     * @param io_stream binary stream to which the checkpoint is written.
+     **/
+    static void write( Header       const & i_header,
+                       t_idx                i_stride,
+                       t_real       const * i_h,
+                       t_real       const * i_hu,
+                       t_real       const * i_hv,
+                       t_real       const * i_b,
+                       std::ostream       & io_stream );
+
+    /**
+     * Reads a checkpoint.
+     *
+     * @param io_stream binary stream from which the checkpoint is read.
+     * @param o_header will be set to the state of the time loop and the extent of the fields.
+     * @param o_h will be set to the water height (nx * ny values, row-major).
+     * @param o_hu will be set to the momentum in x-direction.
+     * @param o_hv will be set to the momentum in y-direction.
+     * @param o_b will be set to the bathymetry.
+     * The extent of the fields is checked against the rest of the stream before the fields are allocated if the stream is seekable.
+     *
+     * @return true if the checkpoint was read; false if the stream ended early or is too short for the extent of the fields, is not a checkpoint or was written with a different t_real.
+     **/
+    static bool read( std::istream          & io_stream,
+                      Header                & o_header,
+                      std::vector< t_real > & o_h,
+                      std::vector< t_real > & o_hu,
+                      std::vector< t_real > & o_hv,
+                      std::vector< t_real > & o_b );
+};
+
+#endif
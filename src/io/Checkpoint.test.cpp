@@ -0,0 +1,84 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the binary checkpoints.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include "Checkpoint.h"
+
+TEST_CASE( "Test the round trip of a checkpoint.", "[Checkpoint]" ) {
+  // 3x2 cells with a padded stride of 4
+  tsunami_lab::t_real l_h[8]  = { 1, 2, 3, -1,  4, 5, 6, -1 };
+  tsunami_lab::t_real l_hu[8] = { 7, 8, 9, -1, 10, 11, 12, -1 };
+  tsunami_lab::t_real l_hv[8] = { 0.1f, 0.2f, 0.3f, -1,  0.4f, 0.5f, 0.6f, -1 };
+  tsunami_lab::t_real l_b[8]  = { -5, -4, -3, -1,  -2, -1, 1, -1 };
+
+  tsunami_lab::io::Checkpoint::Header l_header;
+  l_header.nx = 3;
+  l_header.ny = 2;
+  l_header.offsetX = 10;
+  l_header.offsetY = 20;
+  l_header.timeStep = 125;
+  l_header.snapshotCount = 6;
+  l_header.time = 0.7321f;
+  l_header.waveSpeedMax = 9.87f;
+
+  std::stringstream l_stream;
+  tsunami_lab::io::Checkpoint::write( l_header, 4, l_h, l_hu, l_hv, l_b, l_stream );
+
+  // header of 80 bytes and four fields without padding
+  REQUIRE( l_stream.str().size() == 80 + 4 * 6 * sizeof(tsunami_lab::t_real) );
+
+  tsunami_lab::io::Checkpoint::Header l_headerRead;
+  std::vector< tsunami_lab::t_real > l_fields[4];
+  REQUIRE( tsunami_lab::io::Checkpoint::read( l_stream, l_headerRead, l_fields[0], l_fields[1], l_fields[2], l_fields[3] ) );
+
+  REQUIRE( l_headerRead.nx == 3 );
+  REQUIRE( l_headerRead.ny == 2 );
+  REQUIRE( l_headerRead.offsetX == 10 );
+  REQUIRE( l_headerRead.offsetY == 20 );
+  REQUIRE( l_headerRead.timeStep == 125 );
+  REQUIRE( l_headerRead.snapshotCount == 6 );
+  REQUIRE( l_headerRead.time == 0.7321f );
+  REQUIRE( l_headerRead.waveSpeedMax == 9.87f );
+
+  // the values are bitwise identical
+  tsunami_lab::t_real const * l_refs[4] = { l_h, l_hu, l_hv, l_b };
+  for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) {
+    REQUIRE( l_fields[l_fi].size() == 6 );
+    for( tsunami_lab::t_idx l_ce = 0; l_ce < 6; l_ce++ ) {
+      REQUIRE( l_fields[l_fi][l_ce] == l_refs[l_fi][ (l_ce / 3) * 4 + l_ce % 3 ] );
+    }
+  }
+
+  // a 1d patch has no momentum in y-direction
+  std::stringstream l_stream1d;
+  tsunami_lab::io::Checkpoint::write( l_header, 4, l_h, l_hu, nullptr, l_b, l_stream1d );
+  REQUIRE( tsunami_lab::io::Checkpoint::read( l_stream1d, l_headerRead, l_fields[0], l_fields[1], l_fields[2], l_fields[3] ) );
+  REQUIRE( l_fields[2] == std::vector< tsunami_lab::t_real >( 6, 0 ) );
+  REQUIRE( l_fields[3][5] == 1 );
+
+  // truncated checkpoint
+  std::stringstream l_truncated( l_stream.str().substr( 0, 100 ) );
+  REQUIRE( !tsunami_lab::io::Checkpoint::read( l_truncated, l_headerRead, l_fields[0], l_fields[1], l_fields[2], l_fields[3] ) );
+
+  // corrupt extents: huge fields and an overflowing number of values
+  std::uint64_t l_extents[2][2] = { { std::uint64_t(1) << 40, 2 }, { std::uint64_t(1) << 33, std::uint64_t(1) << 33 } };
+  for( unsigned short l_ex = 0; l_ex < 2; l_ex++ ) {
+    std::string l_corrupt = l_stream.str();
+    std::memcpy( &l_corrupt[16], l_extents[l_ex], sizeof(l_extents[l_ex]) );
+    std::stringstream l_corruptStream( l_corrupt );
+    REQUIRE( !tsunami_lab::io::Checkpoint::read( l_corruptStream, l_headerRead, l_fields[0], l_fields[1], l_fields[2], l_fields[3] ) );
+  }
+
+  // no checkpoint
+  std::stringstream l_csv( "x,y,height\n0.5,0.5,1\n" );
+  REQUIRE( !tsunami_lab::io::Checkpoint::read( l_csv, l_headerRead, l_fields[0], l_fields[1], l_fields[2], l_fields[3] ) );
+}
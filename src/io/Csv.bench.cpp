@@ -0,0 +1,89 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the CSV-interface.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "Csv.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  /**
+   * Line-by-line reader which was used before the memory-mapped one; kept as baseline.
+   *
+   * @param in_file name of csv input file
+   * @param out_bathymetry values of bathymetry in vector
+   **/
+  void readGetline( std::string in_file,
+                    std::vector<tsunami_lab::t_real> &out_bathymetry ) {
+    std::ifstream file(in_file);
+
+    std::string line;
+    std::string value;
+
+    while(std::getline(file, line)) {
+      std::stringstream lineSs(line);
+
+      //only extract bathymetry
+      for(int i = 0; i <= 2; i++) {
+        std::getline(lineSs, value, ',');
+      }
+      std::getline(lineSs, value, ',');
+
+      out_bathymetry.push_back(tsunami_lab::t_real(std::stod(value)));
+    }
+  }
+
+  void benchRead( std::ostream & io_stream ) {
+    std::string const path = "csv_bench.csv";
+    unsigned int const rowCount = 1000000;
+
+    // bathymetry-like file: x, y, z, bathymetry
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution< double > distribution( -8000, 100 );
+
+    std::ofstream file( path );
+    for( unsigned int row = 0; row < rowCount; row++ ) {
+      file << row % 1000 * 25.0 << "," << row / 1000 * 25.0 << ",0," << distribution( generator ) << "\n";
+    }
+    file.close();
+
+    std::ifstream size( path, std::ios::binary | std::ios::ate );
+    double bytes = size.tellg();
+    size.close();
+
+    // old reader: fourth column only
+    std::vector< tsunami_lab::t_real > bathymetry;
+    double start = tsunami_lab::instrumentation::Profiler::now();
+    readGetline( path, bathymetry );
+    double timeGetline = tsunami_lab::instrumentation::Profiler::now() - start;
+
+    // memory-mapped reader: all columns
+    tsunami_lab::t_idx columnCount = 0;
+    std::vector< tsunami_lab::t_real > values;
+    start = tsunami_lab::instrumentation::Profiler::now();
+    tsunami_lab::io::Csv::read( path, columnCount, values );
+    double timeMapped = tsunami_lab::instrumentation::Profiler::now() - start;
+
+    std::remove( path.c_str() );
+
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "Csv/read_getline", "time", timeGetline * 1E3, "ms" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "Csv/read_getline", "rows_per_second", rowCount / timeGetline * 1E-6, "M/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "Csv/read_getline", "bandwidth", bytes / timeGetline * 1E-6, "MB/s" );
+
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "Csv/read_mapped", "time", timeMapped * 1E3, "ms" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "Csv/read_mapped", "rows_per_second", rowCount / timeMapped * 1E-6, "M/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "Csv/read_mapped", "bandwidth", bytes / timeMapped * 1E-6, "MB/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "Csv/read_mapped", "speedup", timeGetline / timeMapped, "" );
+  }
+
+  tsunami_lab::benchmarks::Benchmark read( "Csv/read", benchRead );
+}
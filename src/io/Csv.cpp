@@ -5,10 +5,16 @@
  * IO-routines for writing a snapshot as Comma Separated Values (CSV).
  **/
 #include "Csv.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <string>
-#include <fstream>
 #include <vector>
-#include <sstream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 void tsunami_lab::io::Csv::write( t_real               i_dxy,
                                   t_idx                i_nx,
@@ -18,7 +24,9 @@ void tsunami_lab::io::Csv::write( t_real               i_dxy,
                                   t_real       const * i_b,
                                   t_real       const * i_hu,
                                   t_real       const * i_hv,
-                                  std::ostream       & io_stream ) {
+                                  std::ostream       & io_stream,
+                                  t_idx                i_offsetX,
+                                  t_idx                i_offsetY ) {
   // write the CSV header
   io_stream << "x,y";
   if( i_h  != nullptr ) io_stream << ",height";
@@ -31,8 +39,8 @@ void tsunami_lab::io::Csv::write( t_real               i_dxy,
   for( t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
     for( t_idx l_ix = 0; l_ix < i_nx; l_ix++ ) {
       // derive coordinates of cell center
-      t_real l_posX = (l_ix + 0.5) * i_dxy;
-      t_real l_posY = (l_iy + 0.5) * i_dxy;
+      t_real l_posX = (i_offsetX + l_ix + 0.5) * i_dxy;
+      t_real l_posY = (i_offsetY + l_iy + 0.5) * i_dxy;
 
       t_idx l_id = l_iy * i_stride + l_ix;
 
@@ -48,24 +56,275 @@ void tsunami_lab::io::Csv::write( t_real               i_dxy,
   io_stream << std::flush;
 }
 
-void tsunami_lab::io::Csv::read(std::string in_file,
+bool tsunami_lab::io::Csv::read(std::string in_file,
                                 std::vector<t_real> &out_bathymetry) {
-  
-  // Create an input filestream
-  std::ifstream file(in_file);
+  t_idx l_columnCount = 0;
+  std::vector< t_real > l_values;
+  if( !read( in_file, l_columnCount, l_values ) || l_columnCount < 4 ) return false;
 
-  std::string line;
-  std::string value;
+  //only extract bathymetry
+  t_idx l_rowCount = l_values.size() / l_columnCount;
+  out_bathymetry.reserve( out_bathymetry.size() + l_rowCount );
+  for( t_idx l_ro = 0; l_ro < l_rowCount; l_ro++ ) {
+    out_bathymetry.push_back( l_values[ l_ro * l_columnCount + 3 ] );
+  }
+
+  return true;
+}
+
+char const * tsunami_lab::io::Csv::parseReal( char const * i_first,
+                                              char const * i_last,
+                                              t_real     & o_value ) {
+  // exactly representable powers of ten
+  static double const l_powers[23] = { 1E0,  1E1,  1E2,  1E3,  1E4,  1E5,  1E6,  1E7,
+                                       1E8,  1E9,  1E10, 1E11, 1E12, 1E13, 1E14, 1E15,
+                                       1E16, 1E17, 1E18, 1E19, 1E20, 1E21, 1E22 };
+
+  char const * l_ch = i_first;
+
+  bool l_negative = false;
+  if( l_ch < i_last && ( *l_ch == '-' || *l_ch == '+' ) ) {
+    l_negative = *l_ch == '-';
+    l_ch++;
+  }
+
+  // accumulate up to 19 significant digits in an integer, further digits only shift the exponent
+  std::uint64_t l_mantissa = 0;
+  int l_digits = 0;
+  int l_exponent = 0;
+  bool l_any = false;
+
+  for( ; l_ch < i_last && *l_ch >= '0' && *l_ch <= '9'; l_ch++ ) {
+    l_any = true;
+    if( l_digits < 19 ) {
+      l_mantissa = l_mantissa * 10 + (*l_ch - '0');
+      if( l_mantissa != 0 ) l_digits++;
+    }
+    else {
+      l_exponent++;
+    }
+  }
+
+  if( l_ch < i_last && *l_ch == '.' ) {
+    l_ch++;
+    for( ; l_ch < i_last && *l_ch >= '0' && *l_ch <= '9'; l_ch++ ) {
+      l_any = true;
+      if( l_digits < 19 ) {
+        l_mantissa = l_mantissa * 10 + (*l_ch - '0');
+        if( l_mantissa != 0 ) l_digits++;
+        l_exponent--;
+      }
+    }
+  }
+
+  if( !l_any ) return i_first;
+
+  if( l_ch < i_last && ( *l_ch == 'e' || *l_ch == 'E' ) ) {
+    char const * l_chExp = l_ch + 1;
+    bool l_negativeExp = false;
+    if( l_chExp < i_last && ( *l_chExp == '-' || *l_chExp == '+' ) ) {
+      l_negativeExp = *l_chExp == '-';
+      l_chExp++;
+    }
+
+    // the exponent is only consumed if it has digits
+    if( l_chExp < i_last && *l_chExp >= '0' && *l_chExp <= '9' ) {
+      int l_exp = 0;
+      for( ; l_chExp < i_last && *l_chExp >= '0' && *l_chExp <= '9'; l_chExp++ ) {
+        if( l_exp < 10000 ) l_exp = l_exp * 10 + (*l_chExp - '0');
+      }
+      l_exponent += l_negativeExp ? -l_exp : l_exp;
+      l_ch = l_chExp;
+    }
+  }
+
+  // zero for any exponent; the scaling below would give 0 * inf = NaN for large exponents
+  if( l_mantissa == 0 ) {
+    o_value = l_negative ? -t_real(0) : t_real(0);
+    return l_ch;
+  }
+
+  double l_value = double( l_mantissa );
+  if( l_exponent >= 0 ) {
+    l_value *= l_exponent <= 22 ? l_powers[l_exponent] : std::pow( 10.0, l_exponent );
+  }
+  else {
+    l_value /= -l_exponent <= 22 ? l_powers[-l_exponent] : std::pow( 10.0, -l_exponent );
+  }
+
+  o_value = t_real( l_negative ? -l_value : l_value );
+  return l_ch;
+}
+
+namespace {
+  /**
+   * Gets the first non-blank character of a line; carriage returns of CRLF line endings are blanks.
+   *
+   * @param i_first first character of the line.
+   * @param i_last character behind the line.
+   * @return first non-blank character.
+   **/
+  char const * skipBlanks( char const * i_first,
+                           char const * i_last ) {
+    while( i_first < i_last && ( *i_first == ' ' || *i_first == '\t' || *i_first == '\r' ) ) i_first++;
+    return i_first;
+  }
+
+  /**
+   * Checks if a line is empty or only holds blanks.
+   *
+   * @param i_first first character of the line.
+   * @param i_last character behind the line.
+   * @return true if the line is blank.
+   **/
+  bool isBlankLine( char const * i_first,
+                    char const * i_last ) {
+    return skipBlanks( i_first, i_last ) == i_last;
+  }
 
-  while(std::getline(file, line)) {
-    std::stringstream lineSs(line);
+  /**
+   * Checks if a line holds data, i.e., starts with a number.
+   *
+   * @param i_first first character of the line.
+   * @param i_last character behind the line.
+   * @return true if the line holds data.
+   **/
+  bool isDataLine( char const * i_first,
+                   char const * i_last ) {
+    i_first = skipBlanks( i_first, i_last );
+    if( i_first == i_last ) return false;
 
-    //only extract bathymetry
-    for(int i = 0; i <= 2; i++) {
-      std::getline(lineSs, value, ',');
+    char l_ch = *i_first;
+    return ( l_ch >= '0' && l_ch <= '9' ) || l_ch == '-' || l_ch == '+' || l_ch == '.';
+  }
+
+  /**
+   * Gets the end of the line.
+   *
+   * @param i_first first character of the line.
+   * @param i_last character behind the input.
+   * @return line break or i_last.
+   **/
+  char const * endOfLine( char const * i_first,
+                          char const * i_last ) {
+    char const * l_end = static_cast< char const * >( std::memchr( i_first, '\n', i_last - i_first ) );
+    return l_end == nullptr ? i_last : l_end;
+  }
+
+  /**
+   * Parses the values of a line.
+   *
+   * @param i_first first character of the line.
+   * @param i_last character behind the line.
+   * @param i_columnCount maximum number of values which are written.
+   * @param o_values will be set to the values; nullptr if only the values are counted.
+   * @return number of values in the line.
+   **/
+  tsunami_lab::t_idx parseLine( char const          * i_first,
+                                char const          * i_last,
+                                tsunami_lab::t_idx    i_columnCount,
+                                tsunami_lab::t_real * o_values ) {
+    tsunami_lab::t_idx l_count = 0;
+    tsunami_lab::t_real l_value = 0;
+
+    while( true ) {
+      i_first = skipBlanks( i_first, i_last );
+      char const * l_end = tsunami_lab::io::Csv::parseReal( i_first, i_last, l_value );
+      if( l_end == i_first ) break;
+
+      if( o_values != nullptr && l_count < i_columnCount ) o_values[l_count] = l_value;
+      l_count++;
+
+      i_first = skipBlanks( l_end, i_last );
+      if( i_first == i_last || *i_first != ',' ) break;
+      i_first++;
+    }
+
+    return l_count;
+  }
+}
+
+bool tsunami_lab::io::Csv::read( std::string           const & i_file,
+                                 t_idx                       & o_columnCount,
+                                 std::vector< t_real >       & o_values ) {
+  o_columnCount = 0;
+  o_values.clear();
+
+  MappedFile l_file( i_file );
+  if( !l_file.isOpen() ) return false;
+
+  char const * l_data = l_file.getData();
+  char const * l_last = l_data + l_file.getSize();
+
+  // the first data line defines the number of columns; lines before it, e.g., a header, are skipped
+  char const * l_line = l_data;
+  while( l_line < l_last ) {
+    char const * l_end = endOfLine( l_line, l_last );
+    if( isDataLine( l_line, l_end ) ) {
+      o_columnCount = parseLine( l_line, l_end, 0, nullptr );
+      break;
+    }
+    l_line = l_end + 1;
+  }
+  if( o_columnCount == 0 ) return true;
+
+  // split the data lines into chunks of at least 1 MiB at line breaks; all non-blank lines have to be rows
+  l_data = l_line;
+  t_idx l_chunkCount = 1;
+#ifdef _OPENMP
+  l_chunkCount = 4 * omp_get_max_threads();
+#endif
+  t_idx l_size = l_last - l_data;
+  l_chunkCount = std::max( t_idx(1), std::min( l_chunkCount, l_size / (1 << 20) ) );
+
+  std::vector< char const * > l_chunks( l_chunkCount + 1 );
+  l_chunks[0] = l_data;
+  l_chunks[l_chunkCount] = l_last;
+  for( t_idx l_ch = 1; l_ch < l_chunkCount; l_ch++ ) {
+    char const * l_split = l_data + l_ch * ( l_size / l_chunkCount );
+    l_split = std::max( l_split, l_chunks[l_ch-1] );
+    l_chunks[l_ch] = std::min( endOfLine( l_split, l_last ) + 1, l_last );
+  }
+
+  // count the rows of the chunks and size the output once
+  std::vector< t_idx > l_rowOffsets( l_chunkCount + 1, 0 );
+
+#pragma omp parallel for schedule(dynamic)
+  for( t_idx l_ch = 0; l_ch < l_chunkCount; l_ch++ ) {
+    t_idx l_rows = 0;
+    for( char const * l_li = l_chunks[l_ch]; l_li < l_chunks[l_ch+1]; ) {
+      char const * l_end = endOfLine( l_li, l_chunks[l_ch+1] );
+      if( !isBlankLine( l_li, l_end ) ) l_rows++;
+      l_li = l_end + 1;
+    }
+    l_rowOffsets[l_ch+1] = l_rows;
+  }
+
+  for( t_idx l_ch = 0; l_ch < l_chunkCount; l_ch++ ) {
+    l_rowOffsets[l_ch+1] += l_rowOffsets[l_ch];
+  }
+  o_values.resize( l_rowOffsets[l_chunkCount] * o_columnCount );
+
+  // parse the chunks into their rows of the output
+  bool l_valid = true;
+
+#pragma omp parallel for schedule(dynamic) reduction(&&: l_valid)
+  for( t_idx l_ch = 0; l_ch < l_chunkCount; l_ch++ ) {
+    t_real * l_values = o_values.data() + l_rowOffsets[l_ch] * o_columnCount;
+
+    for( char const * l_li = l_chunks[l_ch]; l_li < l_chunks[l_ch+1]; ) {
+      char const * l_end = endOfLine( l_li, l_chunks[l_ch+1] );
+      if( !isBlankLine( l_li, l_end ) ) {
+        if( parseLine( l_li, l_end, o_columnCount, l_values ) != o_columnCount ) l_valid = false;
+        l_values += o_columnCount;
+      }
+      l_li = l_end + 1;
     }
-    std::getline(lineSs, value, ',');
+  }
 
-    out_bathymetry.push_back(t_real(std::stod(value)));
-   }
-}
\ No newline at end of file
+  if( !l_valid ) {
+    o_columnCount = 0;
+    o_values.clear();
+  }
+  return l_valid;
+}
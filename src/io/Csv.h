@@ -32,6 +32,8 @@ class tsunami_lab::io::Csv {
      * @param i_hu momentum in x-direction of the cells; optional: use nullptr if not required.
      * @param i_hv momentum in y-direction of the cells; optional: use nullptr if not required.
      * @param io_stream stream to which the CSV-data is written.
+     * @param i_offsetX id of the first cell in x-direction in the domain, e.g., of a block of a distributed run.
+     * @param i_offsetY id of the first cell in y-direction in the domain.
      **/
     static void write( t_real               i_dxy,
                        t_idx                i_nx,
@@ -41,16 +43,48 @@ class tsunami_lab::io::Csv {
                        t_real       const * i_b,
                        t_real       const * i_hu,
                        t_real       const * i_hv,
-                       std::ostream       & io_stream );
+                       std::ostream       & io_stream,
+                       t_idx                i_offsetX = 0,
+                       t_idx                i_offsetY = 0 );
     
     /**
      *@brief reads the bathymetry from a given csv file.
      *
      * @param in_file name of csv input file
-     * @param out_bathymetry values of bathymetry in vector 
+     * @param out_bathymetry values of bathymetry in vector; the fourth column of every row is appended
+     * @return true if successful, false if the file could not be read or has less than four columns; nothing is appended then.
     */
-    static void read( std::string in_file, 
+    static bool read( std::string in_file, 
 	                   std::vector<t_real> &out_bathymetry );
+
+    /**
+     * Reads all columns of a CSV file with numeric values.
+     *
+     * The file is mapped into memory and split into chunks at line breaks, which are parsed in parallel.
+     * The output is sized once after counting the rows of all chunks.
+     * Lines before the first line which starts with a number (e.g., a header) and empty lines are skipped.
+     * All other lines have to be rows of numbers, such that, e.g., a text row or a NaN in the data is an error.
+     *
+     * @param i_file path of the CSV file.
+     * @param o_columnCount will be set to the number of columns.
+     * @param o_values will be set to the values in row-major order, i.e., value (row, column) is at row * o_columnCount + column.
+     * @return true if successful, false if the file could not be opened, a row is not numeric or the rows have different numbers of columns.
+     **/
+    static bool read( std::string           const & i_file,
+                      t_idx                       & o_columnCount,
+                      std::vector< t_real >       & o_values );
+
+    /**
+     * Parses a floating point number (e.g., -1.25e-3).
+     *
+     * @param i_first first character of the number.
+     * @param i_last character behind the input.
+     * @param o_value will be set to the parsed value.
+     * @return character behind the number; i_first if no number was parsed.
+     **/
+    static char const * parseReal( char const * i_first,
+                                   char const * i_last,
+                                   t_real     & o_value );
 };
 
 #endif
\ No newline at end of file
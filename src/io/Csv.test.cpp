@@ -6,7 +6,14 @@
  **/
 #include <catch2/catch.hpp>
 #include "../constants.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
 #include <sstream>
+#include <string>
+#include <vector>
 #define private public
 #include "Csv.h"
 #undef public
@@ -74,4 +81,162 @@ TEST_CASE( "Test the CSV-writer for 2D settings.", "[CsvWrite2d]" ) {
 
   REQUIRE( l_stream1.str().size() == l_ref1.size() );
   REQUIRE( l_stream1.str() == l_ref1 );
-}
\ No newline at end of file
+
+  // block of a distributed run: coordinates of the domain
+  std::stringstream l_stream2;
+  tsunami_lab::io::Csv::write( 10,
+                               1,
+                               1,
+                               4,
+                               l_h+4+1,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               l_stream2,
+                               3,
+                               2 );
+  REQUIRE( l_stream2.str() == "x,y,height\n35,25,5\n" );
+}
+
+TEST_CASE( "Test the parsing of floating point numbers.", "[CsvParseReal]" ) {
+  std::string l_numbers[9] = { "0", "-1", "+2.5", "1.25e2", "-3.5E-2", ".5", "10.", "0.000123456789", "123456789012345678901234" };
+  tsunami_lab::t_real l_refs[9] = { 0, -1, 2.5f, 125, -0.035f, 0.5f, 10, 0.000123456789f, 1.23456789012345678901234E23f };
+
+  for( unsigned short l_nu = 0; l_nu < 9; l_nu++ ) {
+    tsunami_lab::t_real l_value = -99;
+    char const * l_first = l_numbers[l_nu].data();
+    char const * l_last = l_first + l_numbers[l_nu].size();
+
+    REQUIRE( tsunami_lab::io::Csv::parseReal( l_first, l_last, l_value ) == l_last );
+    REQUIRE( l_value == Approx( l_refs[l_nu] ) );
+  }
+
+  // zero mantissa with exponents beyond the range of double
+  std::string l_zeros[3] = { "0e400", "-0.0E999", "0.000e-400" };
+  for( unsigned short l_ze = 0; l_ze < 3; l_ze++ ) {
+    tsunami_lab::t_real l_value = -99;
+    char const * l_first = l_zeros[l_ze].data();
+    char const * l_last = l_first + l_zeros[l_ze].size();
+
+    REQUIRE( tsunami_lab::io::Csv::parseReal( l_first, l_last, l_value ) == l_last );
+    REQUIRE( l_value == 0 );
+    REQUIRE( std::signbit( l_value ) == ( l_ze == 1 ) );
+  }
+
+  // no number: nothing is consumed
+  std::string l_text = "x";
+  tsunami_lab::t_real l_value = 0;
+  REQUIRE( tsunami_lab::io::Csv::parseReal( l_text.data(), l_text.data() + 1, l_value ) == l_text.data() );
+
+  // an exponent without digits is not part of the number
+  l_text = "2e,";
+  REQUIRE( tsunami_lab::io::Csv::parseReal( l_text.data(), l_text.data() + 3, l_value ) == l_text.data() + 1 );
+  REQUIRE( l_value == 2 );
+}
+
+TEST_CASE( "Test the CSV-reader.", "[CsvRead]" ) {
+  std::string l_path = "csv_read_test.csv";
+
+  // header, CRLF line endings, blanks and an empty line
+  std::ofstream l_file( l_path );
+  l_file << "x,y,z,bathymetry\r\n"
+         << "0, 0, 1.5, -10\r\n"
+         << "1,0,2.5e1,-2.5E-1\r\n"
+         << "\n"
+         << "2,0,-3,7";
+  l_file.close();
+
+  tsunami_lab::t_idx l_columnCount = 0;
+  std::vector< tsunami_lab::t_real > l_values;
+  REQUIRE( tsunami_lab::io::Csv::read( l_path, l_columnCount, l_values ) );
+
+  REQUIRE( l_columnCount == 4 );
+  REQUIRE( l_values.size() == 12 );
+
+  tsunami_lab::t_real l_refs[12] = { 0, 0, 1.5, -10,
+                                     1, 0, 25, -0.25,
+                                     2, 0, -3, 7 };
+  for( unsigned short l_va = 0; l_va < 12; l_va++ ) {
+    REQUIRE( l_values[l_va] == l_refs[l_va] );
+  }
+
+  // bathymetry is the fourth column
+  std::vector< tsunami_lab::t_real > l_bathymetry;
+  REQUIRE( tsunami_lab::io::Csv::read( l_path, l_bathymetry ) );
+  REQUIRE( l_bathymetry.size() == 3 );
+  REQUIRE( l_bathymetry[0] == -10 );
+  REQUIRE( l_bathymetry[1] == -0.25 );
+  REQUIRE( l_bathymetry[2] == 7 );
+
+  // inconsistent number of columns
+  l_file.open( l_path );
+  l_file << "0,1,2\n"
+         << "3,4\n";
+  l_file.close();
+  REQUIRE( !tsunami_lab::io::Csv::read( l_path, l_columnCount, l_values ) );
+  REQUIRE( !tsunami_lab::io::Csv::read( l_path, l_bathymetry ) );
+
+  // non-numeric rows after the first data line
+  l_file.open( l_path );
+  l_file << "x,y,z,bathymetry\n"
+         << "0,1,2,3\n"
+         << "nan,1,2,3\n"
+         << "4,5,6,7\n";
+  l_file.close();
+  REQUIRE( !tsunami_lab::io::Csv::read( l_path, l_columnCount, l_values ) );
+
+  l_file.open( l_path );
+  l_file << "0,1,2,3\n"
+         << "x,y,z,bathymetry\n"
+         << "4,5,6,7\n";
+  l_file.close();
+  REQUIRE( !tsunami_lab::io::Csv::read( l_path, l_columnCount, l_values ) );
+
+  // less than four columns: no bathymetry
+  l_file.open( l_path );
+  l_file << "0,1,2\n";
+  l_file.close();
+  REQUIRE( !tsunami_lab::io::Csv::read( l_path, l_bathymetry ) );
+  REQUIRE( l_bathymetry.size() == 3 );
+
+  std::remove( l_path.c_str() );
+
+  // missing file
+  REQUIRE( !tsunami_lab::io::Csv::read( l_path, l_columnCount, l_values ) );
+  REQUIRE( !tsunami_lab::io::Csv::read( l_path, l_bathymetry ) );
+}
+
+TEST_CASE( "Test the CSV-reader with a file of several chunks.", "[CsvReadChunks]" ) {
+  std::string l_path = "csv_read_chunks_test.csv";
+
+  // ~4 MiB of random values
+  std::mt19937 l_generator( 42 );
+  std::uniform_real_distribution< double > l_distribution( -10000, 10000 );
+
+  std::vector< double > l_refs;
+  std::ofstream l_file( l_path );
+  l_file.precision( std::numeric_limits< tsunami_lab::t_real >::max_digits10 );
+  for( unsigned int l_ro = 0; l_ro < 100000; l_ro++ ) {
+    for( unsigned short l_co = 0; l_co < 4; l_co++ ) {
+      double l_value = l_distribution( l_generator );
+      l_refs.push_back( l_value );
+      l_file << l_value << ( l_co < 3 ? "," : "\n" );
+    }
+  }
+  l_file.close();
+
+  tsunami_lab::t_idx l_columnCount = 0;
+  std::vector< tsunami_lab::t_real > l_values;
+  REQUIRE( tsunami_lab::io::Csv::read( l_path, l_columnCount, l_values ) );
+  std::remove( l_path.c_str() );
+
+  REQUIRE( l_columnCount == 4 );
+  REQUIRE( l_values.size() == l_refs.size() );
+
+  // values agree within the precision of t_real
+  std::size_t l_mismatches = 0;
+  for( std::size_t l_va = 0; l_va < l_refs.size(); l_va++ ) {
+    if( l_values[l_va] != Approx( l_refs[l_va] ).epsilon( std::numeric_limits< tsunami_lab::t_real >::epsilon() ) ) l_mismatches++;
+  }
+  REQUIRE( l_mismatches == 0 );
+}
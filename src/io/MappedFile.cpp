@@ -0,0 +1,66 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Read-only view of a file which is mapped into memory.
+ **/
+#include "MappedFile.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TSUNAMI_LAB_IO_MMAP
+#else
+#include <fstream>
+#endif
+
+tsunami_lab::io::MappedFile::MappedFile( std::string const & i_path ) {
+#ifdef TSUNAMI_LAB_IO_MMAP
+  int l_fd = open( i_path.c_str(), O_RDONLY );
+  if( l_fd < 0 ) return;
+
+  struct stat l_stat;
+  if( fstat( l_fd, &l_stat ) == 0 ) {
+    m_size = l_stat.st_size;
+    m_open = true;
+
+    // empty files can't be mapped
+    if( m_size > 0 ) {
+      void * l_map = mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, l_fd, 0 );
+      if( l_map != MAP_FAILED ) {
+        m_data = static_cast< char const * >( l_map );
+        m_mapped = true;
+
+        // the file is read front to back
+        madvise( l_map, m_size, MADV_SEQUENTIAL );
+      }
+      else {
+        m_open = false;
+        m_size = 0;
+      }
+    }
+  }
+  close( l_fd );
+#else
+  std::ifstream l_file( i_path, std::ios::binary | std::ios::ate );
+  if( !l_file ) return;
+
+  m_size = l_file.tellg();
+  m_buffer.resize( m_size );
+  l_file.seekg( 0 );
+  l_file.read( m_buffer.data(), m_size );
+  m_data = m_buffer.data();
+  m_open = true;
+#endif
+}
+
+tsunami_lab::io::MappedFile::~MappedFile() {
+#ifdef TSUNAMI_LAB_IO_MMAP
+  if( m_mapped ) {
+    munmap( const_cast< char * >( m_data ), m_size );
+  }
+#endif
+}
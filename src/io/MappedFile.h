@@ -0,0 +1,87 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Read-only view of a file which is mapped into memory.
+ **/
+#ifndef TSUNAMI_LAB_IO_MAPPED_FILE
+#define TSUNAMI_LAB_IO_MAPPED_FILE
+
+#include "../constants.h"
+#include <string>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class MappedFile;
+  }
+}
+
+/**
+ * Maps a file read-only into memory (mmap on POSIX systems).
+ * On other systems the file is read into a buffer, which gives the same interface.
+ **/
+class tsunami_lab::io::MappedFile {
+  private:
+    //! true if the file was opened
+    bool m_open = false;
+
+    //! first byte of the file
+    char const * m_data = nullptr;
+
+    //! size of the file in bytes
+    t_idx m_size = 0;
+
+    //! true if m_data is mapped, false if it points to m_buffer
+    bool m_mapped = false;
+
+    //! buffer of the file if it is not mapped
+    std::vector< char > m_buffer;
+
+  public:
+    /**
+     * Maps the given file.
+     *
+     * @param i_path path of the file.
+     **/
+    MappedFile( std::string const & i_path );
+
+    /**
+     * Unmaps the file.
+     **/
+    ~MappedFile();
+
+    MappedFile( MappedFile const & ) = delete;
+    MappedFile & operator=( MappedFile const & ) = delete;
+
+    /**
+     * Checks whether the file was opened.
+     *
+     * @return true if the file is available.
+     **/
+    bool isOpen() const {
+      return m_open;
+    }
+
+    /**
+     * Gets the contents of the file.
+     *
+     * @return first byte of the file.
+     **/
+    char const * getData() const {
+      return m_data;
+    }
+
+    /**
+     * Gets the size of the file.
+     *
+     * @return size in bytes.
+     **/
+    t_idx getSize() const {
+      return m_size;
+    }
+};
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the memory-mapped snapshot file.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "Csv.h"
+#include "MappedSnapshots.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace {
+  void benchWrite( std::ostream & io_stream ) {
+    tsunami_lab::t_idx const nx = 1000;
+    tsunami_lab::t_idx const ny = 1000;
+    tsunami_lab::t_idx const stride = 1024;
+    tsunami_lab::t_idx const snapshotCount = 8;
+
+    // padded fields of a patch
+    std::vector< tsunami_lab::t_real > fields[4];
+    for( unsigned short field = 0; field < 4; field++ ) {
+      fields[field].resize( stride * ny );
+      for( tsunami_lab::t_idx cell = 0; cell < stride * ny; cell++ ) {
+        fields[field][cell] = tsunami_lab::t_real( field + 1 ) + tsunami_lab::t_real( cell % 977 ) * 1E-3f;
+      }
+    }
+    double bytes = 4.0 * nx * ny * sizeof(tsunami_lab::t_real) * snapshotCount;
+
+    // formatted: one CSV file per snapshot
+    double start = tsunami_lab::instrumentation::Profiler::now();
+    for( tsunami_lab::t_idx snapshot = 0; snapshot < snapshotCount; snapshot++ ) {
+      std::ofstream file( "mapped_bench.csv" );
+      tsunami_lab::io::Csv::write( 1, nx, ny, stride,
+                                   fields[0].data(), fields[3].data(), fields[1].data(), fields[2].data(),
+                                   file );
+    }
+    double timeCsv = tsunami_lab::instrumentation::Profiler::now() - start;
+    std::remove( "mapped_bench.csv" );
+
+    // unformatted: rows written through a stream
+    start = tsunami_lab::instrumentation::Profiler::now();
+    {
+      std::ofstream file( "mapped_bench.bin", std::ios::binary );
+      for( tsunami_lab::t_idx snapshot = 0; snapshot < snapshotCount; snapshot++ ) {
+        for( unsigned short field = 0; field < 4; field++ ) {
+          for( tsunami_lab::t_idx y = 0; y < ny; y++ ) {
+            file.write( reinterpret_cast< char const * >( fields[field].data() + y * stride ), nx * sizeof(tsunami_lab::t_real) );
+          }
+        }
+      }
+    }
+    double timeStream = tsunami_lab::instrumentation::Profiler::now() - start;
+    std::remove( "mapped_bench.bin" );
+
+    // mapped: rows copied into the pages of the file
+    start = tsunami_lab::instrumentation::Profiler::now();
+    {
+      tsunami_lab::io::MappedSnapshots snapshots( "mapped_bench.bin", nx, ny, 1 );
+      for( tsunami_lab::t_idx snapshot = 0; snapshot < snapshotCount; snapshot++ ) {
+        snapshots.write( snapshot, stride, fields[0].data(), fields[1].data(), fields[2].data(), fields[3].data() );
+      }
+    }
+    double timeMapped = tsunami_lab::instrumentation::Profiler::now() - start;
+    std::remove( "mapped_bench.bin" );
+
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "MappedSnapshots/write_csv", "time_per_snapshot", timeCsv / snapshotCount * 1E3, "ms" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "MappedSnapshots/write_stream", "time_per_snapshot", timeStream / snapshotCount * 1E3, "ms" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "MappedSnapshots/write_stream", "bandwidth", bytes / timeStream * 1E-6, "MB/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "MappedSnapshots/write_mapped", "time_per_snapshot", timeMapped / snapshotCount * 1E3, "ms" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "MappedSnapshots/write_mapped", "bandwidth", bytes / timeMapped * 1E-6, "MB/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "MappedSnapshots/write_mapped", "speedup_csv", timeCsv / timeMapped, "" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, "MappedSnapshots/write_mapped", "speedup_stream", timeStream / timeMapped, "" );
+  }
+
+  tsunami_lab::benchmarks::Benchmark write( "MappedSnapshots/write", benchWrite );
+}
@@ -0,0 +1,141 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Binary snapshot file which is filled through memory mappings.
+ **/
+#include "MappedSnapshots.h"
+#include <cstring>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define TSUNAMI_LAB_IO_MMAP
+#endif
+
+static_assert( sizeof(tsunami_lab::io::MappedSnapshots::Header) == 128, "the fields start 128 bytes after the beginning of a slot" );
+
+tsunami_lab::io::MappedSnapshots::MappedSnapshots( std::string const & i_path,
+                                                   t_idx               i_nx,
+                                                   t_idx               i_ny,
+                                                   t_real              i_dxy,
+                                                   t_idx               i_offsetX,
+                                                   t_idx               i_offsetY,
+                                                   t_idx               i_firstSnapshot ) {
+  std::memset( &m_header, 0, sizeof(m_header) );
+  std::memcpy( m_header.magic, "TSLSNAP", 8 );
+  m_header.version = 1;
+  m_header.realSize = sizeof(t_real);
+  m_header.nx = i_nx;
+  m_header.ny = i_ny;
+  m_header.offsetX = i_offsetX;
+  m_header.offsetY = i_offsetY;
+  m_header.dxy = i_dxy;
+
+  // slots start at page boundaries, which is required for the mappings
+  t_idx l_pageSize = 4096;
+#ifdef TSUNAMI_LAB_IO_MMAP
+  l_pageSize = sysconf( _SC_PAGESIZE );
+#endif
+  t_idx l_size = sizeof(Header) + 4 * i_nx * i_ny * sizeof(t_real);
+  m_header.slotSize = (l_size + l_pageSize - 1) / l_pageSize * l_pageSize;
+
+  m_count = i_firstSnapshot;
+
+#ifdef TSUNAMI_LAB_IO_MMAP
+  m_fd = open( i_path.c_str(), O_RDWR | O_CREAT | ( i_firstSnapshot == 0 ? O_TRUNC : 0 ), 0644 );
+  if( m_fd < 0 ) return;
+
+  // drop the snapshots behind the first one
+  if( ftruncate( m_fd, m_count * m_header.slotSize ) != 0 ) {
+    close( m_fd );
+    m_fd = -1;
+    return;
+  }
+#else
+  std::ios::openmode l_mode = std::ios::in | std::ios::out | std::ios::binary;
+  if( i_firstSnapshot == 0 ) l_mode |= std::ios::trunc;
+  m_stream.open( i_path, l_mode );
+  if( !m_stream ) return;
+#endif
+  m_open = true;
+}
+
+tsunami_lab::io::MappedSnapshots::~MappedSnapshots() {
+#ifdef TSUNAMI_LAB_IO_MMAP
+  if( m_fd >= 0 ) close( m_fd );
+#endif
+}
+
+bool tsunami_lab::io::MappedSnapshots::write( t_real         i_time,
+                                              t_idx          i_stride,
+                                              t_real const * i_h,
+                                              t_real const * i_hu,
+                                              t_real const * i_hv,
+                                              t_real const * i_b ) {
+  if( !m_open ) return false;
+
+  m_header.id = m_count;
+  m_header.time = i_time;
+
+  t_idx l_nx = m_header.nx;
+  t_idx l_ny = m_header.ny;
+  t_idx l_offset = m_count * m_header.slotSize;
+  t_real const * l_fields[4] = { i_h, i_hu, i_hv, i_b };
+
+#ifdef TSUNAMI_LAB_IO_MMAP
+  // extend the file by the slot and map it; reserving the blocks up front avoids allocations while the pages are faulted in
+#ifdef __linux__
+  if( posix_fallocate( m_fd, l_offset, m_header.slotSize ) != 0 ) return false;
+#else
+  if( ftruncate( m_fd, l_offset + m_header.slotSize ) != 0 ) return false;
+#endif
+  void * l_map = mmap( nullptr, m_header.slotSize, PROT_WRITE, MAP_SHARED, m_fd, l_offset );
+  if( l_map == MAP_FAILED ) return false;
+
+  char * l_slot = static_cast< char * >( l_map );
+  std::memcpy( l_slot, &m_header, sizeof(Header) );
+
+  // one copy per row
+  t_real * l_data = reinterpret_cast< t_real * >( l_slot + sizeof(Header) );
+  for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) {
+    for( t_idx l_iy = 0; l_iy < l_ny; l_iy++ ) {
+      // missing fields are zero
+      if( l_fields[l_fi] == nullptr ) {
+        std::memset( l_data + (l_fi * l_ny + l_iy) * l_nx, 0, l_nx * sizeof(t_real) );
+        continue;
+      }
+      std::memcpy( l_data + (l_fi * l_ny + l_iy) * l_nx,
+                   l_fields[l_fi] + l_iy * i_stride,
+                   l_nx * sizeof(t_real) );
+    }
+  }
+
+  // the pages are written back by the kernel
+  munmap( l_map, m_header.slotSize );
+#else
+  m_stream.seekp( l_offset );
+  m_stream.write( reinterpret_cast< char const * >( &m_header ), sizeof(Header) );
+  std::vector< t_real > l_zeros( l_nx, 0 );
+  for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) {
+    for( t_idx l_iy = 0; l_iy < l_ny; l_iy++ ) {
+      // missing fields are zero
+      t_real const * l_row = l_fields[l_fi] != nullptr ? l_fields[l_fi] + l_iy * i_stride : l_zeros.data();
+      m_stream.write( reinterpret_cast< char const * >( l_row ),
+                      l_nx * sizeof(t_real) );
+    }
+  }
+
+  // padding of the slot
+  m_stream.seekp( l_offset + m_header.slotSize - 1 );
+  m_stream.put( 0 );
+  m_stream.flush();
+  if( !m_stream ) return false;
+#endif
+
+  m_count++;
+  return true;
+}
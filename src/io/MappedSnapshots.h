@@ -0,0 +1,147 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Binary snapshot file which is filled through memory mappings.
+ **/
+#ifndef TSUNAMI_LAB_IO_MAPPED_SNAPSHOTS
+#define TSUNAMI_LAB_IO_MAPPED_SNAPSHOTS
+
+#include "../constants.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace tsunami_lab {
+  namespace io {
+    class MappedSnapshots;
+  }
+}
+
+/**
+ * Writer of snapshots into a binary file, which is a sequence of equally sized slots, one per snapshot.
+ * A slot is laid out as [header | height | momentum x | momentum y | bathymetry]:
+ * the header (struct Header, 128 bytes) is followed by the four fields with nx * ny values of t_real each, row-major without padding.
+ * Slots are padded to a multiple of the page size, such that every slot starts page-aligned.
+ *
+ * On POSIX systems the file is extended by one slot per snapshot, the slot is mapped and the rows are copied from the patch;
+ * the kernel writes the pages back asynchronously. Post-processing tools map the file and cast a slot's first bytes to Header.
+ * On other systems the slots are written through a stream.
+ **/
+class tsunami_lab::io::MappedSnapshots {
+  public:
+    //! header of a slot; native byte order
+    struct Header {
+      //! "TSLSNAP" including the terminating zero
+      char magic[8];
+
+      //! version of the layout and size of t_real in bytes
+      std::uint32_t version;
+      std::uint32_t realSize;
+
+      //! number of cells in x- and y-direction
+      std::uint64_t nx;
+      std::uint64_t ny;
+
+      //! id of the first cell in the domain, e.g., of a block of a distributed run
+      std::uint64_t offsetX;
+      std::uint64_t offsetY;
+
+      //! id of the snapshot, i.e., of the slot
+      std::uint64_t id;
+
+      //! size of a slot in bytes
+      std::uint64_t slotSize;
+
+      //! simulation time and cell width
+      double time;
+      double dxy;
+
+      //! zeros; the fields start 128 bytes after the beginning of the slot
+      char reserved[48];
+    };
+
+  private:
+    //! true if the file was opened
+    bool m_open = false;
+
+    //! descriptor of the file on POSIX systems
+    int m_fd = -1;
+
+    //! stream on other systems
+    std::fstream m_stream;
+
+    //! header of the next snapshot
+    Header m_header;
+
+    //! number of snapshots in the file
+    t_idx m_count = 0;
+
+  public:
+    /**
+     * Creates the file or continues an existing one.
+     *
+     * @param i_path path of the file.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_offsetX id of the first cell in x-direction in the domain.
+     * @param i_offsetY id of the first cell in y-direction in the domain.
+     * @param i_firstSnapshot id of the first snapshot; the file is truncated to the earlier snapshots (0: new file).
+     **/
+    MappedSnapshots( std::string const & i_path,
+                     t_idx               i_nx,
+                     t_idx               i_ny,
+                     t_real              i_dxy,
+                     t_idx               i_offsetX = 0,
+                     t_idx               i_offsetY = 0,
+                     t_idx               i_firstSnapshot = 0 );
+
+    /**
+     * Closes the file.
+     **/
+    ~MappedSnapshots();
+
+    MappedSnapshots( MappedSnapshots const & ) = delete;
+    MappedSnapshots & operator=( MappedSnapshots const & ) = delete;
+
+    /**
+     * Checks whether the file was opened.
+     *
+     * @return true if snapshots can be written.
+     **/
+    bool isOpen() const {
+      return m_open;
+    }
+
+    /**
+     * Gets the size of a slot.
+     *
+     * @return size in bytes.
+     **/
+    t_idx getSlotSize() const {
+      return m_header.slotSize;
+    }
+
+    /**
+     * Appends a snapshot.
+     *
+     * @param i_time simulation time.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_h water height of the cells.
+     * @param i_hu momentum in x-direction of the cells.
+     * @param i_hv momentum in y-direction of the cells; nullptr writes zeros, e.g., for 1d patches.
+     * @param i_b bathymetry of the cells.
+     * @return true if the snapshot was written.
+     **/
+    bool write( t_real         i_time,
+                t_idx          i_stride,
+                t_real const * i_h,
+                t_real const * i_hu,
+                t_real const * i_hv,
+                t_real const * i_b );
+};
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the memory-mapped snapshot file.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cstdio>
+#include "MappedFile.h"
+#include "MappedSnapshots.h"
+
+TEST_CASE( "Test the memory-mapped snapshot file.", "[MappedSnapshots]" ) {
+  typedef tsunami_lab::io::MappedSnapshots::Header Header;
+  std::string l_path = "mapped_snapshots_test.bin";
+
+  // 3x2 cells with a padded stride of 4
+  tsunami_lab::t_real l_h[8]  = { 1, 2, 3, -1,  4, 5, 6, -1 };
+  tsunami_lab::t_real l_hu[8] = { 7, 8, 9, -1, 10, 11, 12, -1 };
+  tsunami_lab::t_real l_hv[8] = { 0.1f, 0.2f, 0.3f, -1,  0.4f, 0.5f, 0.6f, -1 };
+  tsunami_lab::t_real l_b[8]  = { -5, -4, -3, -1,  -2, -1, 1, -1 };
+
+  tsunami_lab::t_idx l_slotSize = 0;
+  {
+    tsunami_lab::io::MappedSnapshots l_snapshots( l_path, 3, 2, 0.5, 30, 40 );
+    REQUIRE( l_snapshots.isOpen() );
+    l_slotSize = l_snapshots.getSlotSize();
+
+    for( unsigned short l_sn = 0; l_sn < 3; l_sn++ ) {
+      REQUIRE( l_snapshots.write( l_sn * 0.25f, 4, l_h, l_hu, l_hv, l_b ) );
+      l_h[0] += 100;
+    }
+  }
+
+  // the slots are page-aligned
+  REQUIRE( l_slotSize >= sizeof(Header) + 4 * 6 * sizeof(tsunami_lab::t_real) );
+  REQUIRE( l_slotSize % 4096 == 0 );
+
+  {
+    tsunami_lab::io::MappedFile l_file( l_path );
+    REQUIRE( l_file.isOpen() );
+    REQUIRE( l_file.getSize() == 3 * l_slotSize );
+
+    for( unsigned short l_sn = 0; l_sn < 3; l_sn++ ) {
+      char const * l_slot = l_file.getData() + l_sn * l_slotSize;
+      Header const * l_header = reinterpret_cast< Header const * >( l_slot );
+      REQUIRE( std::string( l_header->magic ) == "TSLSNAP" );
+      REQUIRE( l_header->realSize == sizeof(tsunami_lab::t_real) );
+      REQUIRE( l_header->nx == 3 );
+      REQUIRE( l_header->ny == 2 );
+      REQUIRE( l_header->offsetX == 30 );
+      REQUIRE( l_header->offsetY == 40 );
+      REQUIRE( l_header->id == l_sn );
+      REQUIRE( l_header->slotSize == l_slotSize );
+      REQUIRE( l_header->time == l_sn * 0.25f );
+      REQUIRE( l_header->dxy == 0.5f );
+
+      // fields without padding, in the order height, momenta, bathymetry
+      tsunami_lab::t_real const * l_fields = reinterpret_cast< tsunami_lab::t_real const * >( l_slot + sizeof(Header) );
+      REQUIRE( l_fields[0] == 1 + 100 * l_sn );
+      REQUIRE( l_fields[3] == 4 );
+      REQUIRE( l_fields[6 + 4] == 11 );
+      REQUIRE( l_fields[12 + 2] == 0.3f );
+      REQUIRE( l_fields[18 + 5] == 1 );
+    }
+  }
+
+  // continuation: the third snapshot is replaced
+  {
+    tsunami_lab::io::MappedSnapshots l_snapshots( l_path, 3, 2, 0.5, 30, 40, 2 );
+    REQUIRE( l_snapshots.write( 7, 4, l_hu, l_hu, nullptr, l_hu ) );
+  }
+  {
+    tsunami_lab::io::MappedFile l_file( l_path );
+    REQUIRE( l_file.getSize() == 3 * l_slotSize );
+
+    Header const * l_header = reinterpret_cast< Header const * >( l_file.getData() + 2 * l_slotSize );
+    REQUIRE( l_header->id == 2 );
+    REQUIRE( l_header->time == 7 );
+    tsunami_lab::t_real const * l_fields = reinterpret_cast< tsunami_lab::t_real const * >( l_file.getData() + 2 * l_slotSize + sizeof(Header) );
+    REQUIRE( l_fields[0] == 7 );
+
+    // missing fields are zero
+    REQUIRE( l_fields[12] == 0 );
+    REQUIRE( l_fields[17] == 0 );
+    REQUIRE( l_fields[18] == 7 );
+  }
+
+  std::remove( l_path.c_str() );
+}
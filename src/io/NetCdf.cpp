@@ -0,0 +1,280 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for writing snapshots to a single NetCDF file.
+ **/
+#include "NetCdf.h"
+#include <cstring>
+
+namespace {
+  //! tags of the header lists
+  std::uint32_t const NC_DIMENSION = 0x0A;
+  std::uint32_t const NC_VARIABLE  = 0x0B;
+  std::uint32_t const NC_ATTRIBUTE = 0x0C;
+
+  //! external data types
+  std::uint32_t const NC_CHAR   = 2;
+  std::uint32_t const NC_FLOAT  = 5;
+  std::uint32_t const NC_DOUBLE = 6;
+}
+
+tsunami_lab::io::NetCdf::NetCdf( std::ostream & io_stream ): m_stream( io_stream ) {
+}
+
+void tsunami_lab::io::NetCdf::putInt( std::uint32_t         i_value,
+                                      std::vector< char > & io_bytes ) {
+  for( int l_by = 3; l_by >= 0; l_by-- ) {
+    io_bytes.push_back( char( (i_value >> (8*l_by)) & 0xFF ) );
+  }
+}
+
+void tsunami_lab::io::NetCdf::putOffset( std::uint64_t         i_value,
+                                         std::vector< char > & io_bytes ) {
+  for( int l_by = 7; l_by >= 0; l_by-- ) {
+    io_bytes.push_back( char( (i_value >> (8*l_by)) & 0xFF ) );
+  }
+}
+
+void tsunami_lab::io::NetCdf::putName( std::string   const & i_name,
+                                       std::vector< char > & io_bytes ) {
+  putInt( i_name.size(), io_bytes );
+  io_bytes.insert( io_bytes.end(), i_name.begin(), i_name.end() );
+
+  // pad with zeros to a multiple of four bytes
+  while( io_bytes.size() % 4 != 0 ) io_bytes.push_back( 0 );
+}
+
+void tsunami_lab::io::NetCdf::putAttributes( std::vector< std::string > const & i_attributes,
+                                             std::vector< char >              & io_bytes ) {
+  if( i_attributes.size() == 0 ) {
+    // ABSENT
+    putInt( 0, io_bytes );
+    putInt( 0, io_bytes );
+    return;
+  }
+
+  putInt( NC_ATTRIBUTE, io_bytes );
+  putInt( i_attributes.size() / 2, io_bytes );
+  for( std::size_t l_at = 0; l_at < i_attributes.size(); l_at += 2 ) {
+    putName( i_attributes[l_at], io_bytes );
+    putInt( NC_CHAR, io_bytes );
+    putName( i_attributes[l_at+1], io_bytes );
+  }
+}
+
+void tsunami_lab::io::NetCdf::putReals( t_idx                 i_count,
+                                        t_real        const * i_values,
+                                        std::vector< char > & io_bytes ) {
+  std::size_t l_offset = io_bytes.size();
+  io_bytes.resize( l_offset + i_count * sizeof(t_real) );
+  char * l_bytes = io_bytes.data() + l_offset;
+
+  // NetCDF stores big-endian values
+  for( t_idx l_va = 0; l_va < i_count; l_va++ ) {
+    char l_value[ sizeof(t_real) ];
+    std::memcpy( l_value, i_values + l_va, sizeof(t_real) );
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for( std::size_t l_by = 0; l_by < sizeof(t_real); l_by++ ) {
+      l_bytes[ l_va * sizeof(t_real) + l_by ] = l_value[ sizeof(t_real) - 1 - l_by ];
+    }
+#else
+    std::memcpy( l_bytes + l_va * sizeof(t_real), l_value, sizeof(t_real) );
+#endif
+  }
+}
+
+tsunami_lab::t_idx tsunami_lab::io::NetCdf::header( bool                  i_hasB,
+                                                    t_idx                 i_headerSize,
+                                                    std::vector< char > & o_header ) const {
+  std::uint32_t l_type = sizeof(t_real) == 4 ? NC_FLOAT : NC_DOUBLE;
+  t_idx l_sizeCell = sizeof(t_real);
+  t_idx l_sizeField = m_nx * m_ny * l_sizeCell;
+
+  o_header.clear();
+
+  // magic: classic format with 64-bit offsets
+  o_header.push_back( 'C' );
+  o_header.push_back( 'D' );
+  o_header.push_back( 'F' );
+  o_header.push_back( 2 );
+
+  // number of records
+  putInt( m_recordCount, o_header );
+
+  // dimensions: 0: time (unlimited), 1: y, 2: x
+  putInt( NC_DIMENSION, o_header );
+  putInt( 3, o_header );
+  putName( "time", o_header );
+  putInt( 0, o_header );
+  putName( "y", o_header );
+  putInt( m_ny, o_header );
+  putName( "x", o_header );
+  putInt( m_nx, o_header );
+
+  // global attributes
+  putAttributes( { "Conventions", "CF-1.8",
+                   "title",       "Tsunami Lab simulation" },
+                 o_header );
+
+  // variables, the non-record variables are stored first, followed by the records
+  std::vector< std::string > l_names;
+  std::vector< std::vector< std::uint32_t > > l_dims;
+  std::vector< std::vector< std::string > > l_attributes;
+  std::vector< t_idx > l_sizes;
+
+  l_names.push_back( "x" );
+  l_dims.push_back( { 2 } );
+  l_attributes.push_back( { "standard_name", "projection_x_coordinate",
+                            "long_name",     "x-coordinate of the cell center",
+                            "units",         "m",
+                            "axis",          "X" } );
+  l_sizes.push_back( m_nx * l_sizeCell );
+
+  l_names.push_back( "y" );
+  l_dims.push_back( { 1 } );
+  l_attributes.push_back( { "standard_name", "projection_y_coordinate",
+                            "long_name",     "y-coordinate of the cell center",
+                            "units",         "m",
+                            "axis",          "Y" } );
+  l_sizes.push_back( m_ny * l_sizeCell );
+
+  if( i_hasB ) {
+    l_names.push_back( "bathymetry" );
+    l_dims.push_back( { 1, 2 } );
+    l_attributes.push_back( { "long_name", "bathymetry",
+                              "units",     "m" } );
+    l_sizes.push_back( l_sizeField );
+  }
+
+  std::size_t l_firstRecordVar = l_names.size();
+
+  l_names.push_back( "time" );
+  l_dims.push_back( { 0 } );
+  l_attributes.push_back( { "standard_name", "time",
+                            "long_name",     "simulation time",
+                            "units",         "s",
+                            "axis",          "T" } );
+  l_sizes.push_back( l_sizeCell );
+
+  if( m_hasH ) {
+    l_names.push_back( "height" );
+    l_dims.push_back( { 0, 1, 2 } );
+    l_attributes.push_back( { "long_name", "water height",
+                              "units",     "m" } );
+    l_sizes.push_back( l_sizeField );
+  }
+  if( m_hasHu ) {
+    l_names.push_back( "momentum_x" );
+    l_dims.push_back( { 0, 1, 2 } );
+    l_attributes.push_back( { "long_name", "momentum in x-direction",
+                              "units",     "m2 s-1" } );
+    l_sizes.push_back( l_sizeField );
+  }
+  if( m_hasHv ) {
+    l_names.push_back( "momentum_y" );
+    l_dims.push_back( { 0, 1, 2 } );
+    l_attributes.push_back( { "long_name", "momentum in y-direction",
+                              "units",     "m2 s-1" } );
+    l_sizes.push_back( l_sizeField );
+  }
+
+  putInt( NC_VARIABLE, o_header );
+  putInt( l_names.size(), o_header );
+
+  t_idx l_begin = i_headerSize;
+  t_idx l_recordBegin = 0;
+  for( std::size_t l_va = 0; l_va < l_names.size(); l_va++ ) {
+    if( l_va == l_firstRecordVar ) l_recordBegin = l_begin;
+
+    putName( l_names[l_va], o_header );
+    putInt( l_dims[l_va].size(), o_header );
+    for( std::size_t l_di = 0; l_di < l_dims[l_va].size(); l_di++ ) {
+      putInt( l_dims[l_va][l_di], o_header );
+    }
+    putAttributes( l_attributes[l_va], o_header );
+    putInt( l_type, o_header );
+
+    // the size of record variables is the size of a single record; sizes beyond 32 bit are capped as by the format
+    putInt( l_sizes[l_va] < 0xFFFFFFFF ? l_sizes[l_va] : 0xFFFFFFFF, o_header );
+    putOffset( l_begin, o_header );
+
+    l_begin += l_sizes[l_va];
+  }
+
+  return l_recordBegin;
+}
+
+void tsunami_lab::io::NetCdf::write( t_real         i_time,
+                                     t_real         i_dxy,
+                                     t_idx          i_nx,
+                                     t_idx          i_ny,
+                                     t_idx          i_stride,
+                                     t_real const * i_h,
+                                     t_real const * i_b,
+                                     t_real const * i_hu,
+                                     t_real const * i_hv ) {
+  // define the file and write the time-invariant data with the first snapshot
+  if( m_recordCount == 0 ) {
+    m_nx = i_nx;
+    m_ny = i_ny;
+    m_hasH  = i_h  != nullptr;
+    m_hasHu = i_hu != nullptr;
+    m_hasHv = i_hv != nullptr;
+
+    // the size of the header does not depend on the offsets
+    std::vector< char > l_header;
+    header( i_b != nullptr, 0, l_header );
+    m_recordBegin = header( i_b != nullptr, l_header.size(), l_header );
+    m_recordSize = ( 1 + m_nx * m_ny * ( m_hasH + m_hasHu + m_hasHv ) ) * sizeof(t_real);
+
+    m_buffer = l_header;
+
+    // cell centers
+    for( t_idx l_ix = 0; l_ix < m_nx; l_ix++ ) {
+      t_real l_posX = (l_ix + 0.5) * i_dxy;
+      putReals( 1, &l_posX, m_buffer );
+    }
+    for( t_idx l_iy = 0; l_iy < m_ny; l_iy++ ) {
+      t_real l_posY = (l_iy + 0.5) * i_dxy;
+      putReals( 1, &l_posY, m_buffer );
+    }
+
+    if( i_b != nullptr ) {
+      for( t_idx l_iy = 0; l_iy < m_ny; l_iy++ ) {
+        putReals( m_nx, i_b + l_iy * i_stride, m_buffer );
+      }
+    }
+
+    m_stream.seekp( 0 );
+    m_stream.write( m_buffer.data(), m_buffer.size() );
+  }
+
+  // assemble the record
+  m_buffer.clear();
+  putReals( 1, &i_time, m_buffer );
+
+  t_real const * l_fields[3] = { i_h, i_hu, i_hv };
+  bool l_has[3] = { m_hasH, m_hasHu, m_hasHv };
+  for( unsigned short l_fi = 0; l_fi < 3; l_fi++ ) {
+    if( !l_has[l_fi] ) continue;
+
+    for( t_idx l_iy = 0; l_iy < m_ny; l_iy++ ) {
+      putReals( m_nx, l_fields[l_fi] + l_iy * i_stride, m_buffer );
+    }
+  }
+
+  m_stream.seekp( m_recordBegin + m_recordCount * m_recordSize );
+  m_stream.write( m_buffer.data(), m_buffer.size() );
+  m_recordCount++;
+
+  // update the number of records in the header
+  m_buffer.clear();
+  putInt( m_recordCount, m_buffer );
+  m_stream.seekp( 4 );
+  m_stream.write( m_buffer.data(), m_buffer.size() );
+
+  m_stream << std::flush;
+}
@@ -0,0 +1,161 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * IO-routines for writing snapshots to a single NetCDF file.
+ **/
+#ifndef TSUNAMI_LAB_IO_NETCDF
+#define TSUNAMI_LAB_IO_NETCDF
+
+#include "../constants.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class NetCdf;
+  }
+}
+
+/**
+ * Writer for the NetCDF classic format with 64-bit offsets (CDF-2), following the CF conventions.
+ *
+ * The file has the dimensions time (unlimited), y and x.
+ * Every call of write appends a record (time slice) of the water height and the momenta;
+ * the cell centers and the bathymetry are time-invariant and only stored once.
+ * The format is written directly, i.e., no NetCDF library is required to write the files.
+ **/
+class tsunami_lab::io::NetCdf {
+  private:
+    //! stream to which the file is written, has to support seekp
+    std::ostream & m_stream;
+
+    //! number of cells in x- and y-direction, defined by the first snapshot
+    t_idx m_nx = 0;
+    t_idx m_ny = 0;
+
+    //! true if the respective record variable is part of the file
+    bool m_hasH = false;
+    bool m_hasHu = false;
+    bool m_hasHv = false;
+
+    //! number of records written so far
+    t_idx m_recordCount = 0;
+
+    //! offset of the first record in bytes
+    t_idx m_recordBegin = 0;
+
+    //! size of a record in bytes
+    t_idx m_recordSize = 0;
+
+    //! buffer for the big-endian encoding of the data
+    std::vector< char > m_buffer;
+
+    /**
+     * Appends a 32-bit integer in big-endian byte order.
+     *
+     * @param i_value value which is appended.
+     * @param io_bytes bytes to which the value is appended.
+     **/
+    static void putInt( std::uint32_t       i_value,
+                        std::vector< char > & io_bytes );
+
+    /**
+     * Appends a 64-bit offset in big-endian byte order.
+     *
+     * @param i_value value which is appended.
+     * @param io_bytes bytes to which the value is appended.
+     **/
+    static void putOffset( std::uint64_t       i_value,
+                           std::vector< char > & io_bytes );
+
+    /**
+     * Appends a name (or character data) and pads it to a multiple of four bytes.
+     *
+     * @param i_name name which is appended.
+     * @param io_bytes bytes to which the name is appended.
+     **/
+    static void putName( std::string   const & i_name,
+                         std::vector< char > & io_bytes );
+
+    /**
+     * Appends a list of text attributes.
+     *
+     * @param i_attributes pairs of attribute name and value.
+     * @param io_bytes bytes to which the attributes are appended.
+     **/
+    static void putAttributes( std::vector< std::string > const & i_attributes,
+                               std::vector< char >              & io_bytes );
+
+    /**
+     * Appends values of type t_real in big-endian byte order.
+     *
+     * @param i_count number of values.
+     * @param i_values values which are appended.
+     * @param io_bytes bytes to which the values are appended.
+     **/
+    static void putReals( t_idx                 i_count,
+                          t_real        const * i_values,
+                          std::vector< char > & io_bytes );
+
+    /**
+     * Builds the header of the file.
+     *
+     * @param i_hasB true if the bathymetry is part of the file.
+     * @param i_headerSize size of the header which is used to derive the offsets of the variables.
+     * @param o_header will be set to the header.
+     * @return offset of the first record.
+     **/
+    t_idx header( bool                  i_hasB,
+                  t_idx                 i_headerSize,
+                  std::vector< char > & o_header ) const;
+
+  public:
+    /**
+     * Constructs the writer; the file is defined by the first call of write.
+     *
+     * @param io_stream binary stream to which the file is written; has to support seekp.
+     **/
+    NetCdf( std::ostream & io_stream );
+
+    /**
+     * Appends a snapshot to the file.
+     *
+     * The first call defines the file: the number of cells and the set of given (non-null) quantities have to stay the same for all snapshots.
+     * The bathymetry is only written by the first call.
+     *
+     * @param i_time simulation time of the snapshot.
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_h water height of the cells; optional: use nullptr if not required.
+     * @param i_b bathymetry of the cells; optional: use nullptr if not required.
+     * @param i_hu momentum in x-direction of the cells; optional: use nullptr if not required.
+     * @param i_hv momentum in y-direction of the cells; optional: use nullptr if not required.
+     **/
+    void write( t_real         i_time,
+                t_real         i_dxy,
+                t_idx          i_nx,
+                t_idx          i_ny,
+                t_idx          i_stride,
+                t_real const * i_h,
+                t_real const * i_b,
+                t_real const * i_hu,
+                t_real const * i_hv );
+
+    /**
+     * Gets the number of snapshots written so far.
+     *
+     * @return number of records.
+     **/
+    t_idx getRecordCount() const {
+      return m_recordCount;
+    }
+};
+
+#endif
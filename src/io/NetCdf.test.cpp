@@ -0,0 +1,110 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the NetCDF-interface.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+#define private public
+#include "NetCdf.h"
+#undef public
+
+/**
+ * Reads a big-endian value of type t_real.
+ *
+ * @param i_bytes first byte of the value.
+ * @return value.
+ **/
+static tsunami_lab::t_real readReal( char const * i_bytes ) {
+  typedef std::conditional< sizeof(tsunami_lab::t_real) == 4, std::uint32_t, std::uint64_t >::type t_bits;
+
+  t_bits l_bits = 0;
+  for( unsigned short l_by = 0; l_by < sizeof(t_bits); l_by++ ) {
+    l_bits = (l_bits << 8) | (unsigned char) i_bytes[l_by];
+  }
+  tsunami_lab::t_real l_value;
+  std::memcpy( &l_value, &l_bits, sizeof(t_bits) );
+  return l_value;
+}
+
+TEST_CASE( "Test the NetCDF-writer for 2D settings.", "[NetCdfWrite2d]" ) {
+  // 2x2 cells with ghost cells, i.e., a stride of 4
+  tsunami_lab::t_real l_h[16]  = {  0,  1,  2,  3,
+                                    4,  5,  6,  7,
+                                    8,  9, 10, 11,
+                                   12, 13, 14, 15 };
+  tsunami_lab::t_real l_hu[16] = { 15, 14, 13, 12,
+                                   11, 10,  9,  8,
+                                    7,  6,  5,  4,
+                                    3,  2,  1,  0 };
+  tsunami_lab::t_real l_b[16]  = {  0, -1, -2, -3,
+                                   -4, -5, -6, -7,
+                                   -8, -9,-10,-11,
+                                  -12,-13,-14,-15 };
+
+  std::stringstream l_stream;
+  tsunami_lab::io::NetCdf l_netCdf( l_stream );
+
+  l_netCdf.write( 0, 10, 2, 2, 4, l_h+4+1, l_b+4+1, l_hu+4+1, nullptr );
+
+  // second snapshot with changed heights
+  l_h[5] = 20;
+  l_netCdf.write( 0.5, 10, 2, 2, 4, l_h+4+1, l_b+4+1, l_hu+4+1, nullptr );
+
+  REQUIRE( l_netCdf.getRecordCount() == 2 );
+
+  std::string l_file = l_stream.str();
+  std::size_t const l_size = sizeof(tsunami_lab::t_real);
+
+  // magic and number of records
+  REQUIRE( l_file.substr( 0, 4 ) == std::string( "CDF\x02", 4 ) );
+  REQUIRE( l_file.substr( 4, 4 ) == std::string( "\x00\x00\x00\x02", 4 ) );
+
+  // CF conventions and variables are part of the header
+  REQUIRE( l_file.find( "CF-1.8" ) < l_netCdf.m_recordBegin );
+  REQUIRE( l_file.find( "bathymetry" ) < l_netCdf.m_recordBegin );
+  REQUIRE( l_file.find( "height" ) < l_netCdf.m_recordBegin );
+  REQUIRE( l_file.find( "momentum_x" ) < l_netCdf.m_recordBegin );
+  REQUIRE( l_file.find( "momentum_y" ) == std::string::npos );
+
+  // record: time, height, momentum_x
+  REQUIRE( l_netCdf.m_recordSize == 9 * l_size );
+  REQUIRE( l_file.size() == l_netCdf.m_recordBegin + 2 * l_netCdf.m_recordSize );
+
+  // x, y and bathymetry precede the records
+  char const * l_data = l_file.data() + l_netCdf.m_recordBegin - 8 * l_size;
+  REQUIRE( readReal( l_data + 0*l_size ) == 5 );
+  REQUIRE( readReal( l_data + 1*l_size ) == 15 );
+  REQUIRE( readReal( l_data + 2*l_size ) == 5 );
+  REQUIRE( readReal( l_data + 3*l_size ) == 15 );
+  REQUIRE( readReal( l_data + 4*l_size ) == -5 );
+  REQUIRE( readReal( l_data + 5*l_size ) == -6 );
+  REQUIRE( readReal( l_data + 6*l_size ) == -9 );
+  REQUIRE( readReal( l_data + 7*l_size ) == -10 );
+
+  // first record
+  l_data = l_file.data() + l_netCdf.m_recordBegin;
+  REQUIRE( readReal( l_data + 0*l_size ) == 0 );
+  REQUIRE( readReal( l_data + 1*l_size ) == 5 );
+  REQUIRE( readReal( l_data + 2*l_size ) == 6 );
+  REQUIRE( readReal( l_data + 3*l_size ) == 9 );
+  REQUIRE( readReal( l_data + 4*l_size ) == 10 );
+  REQUIRE( readReal( l_data + 5*l_size ) == 10 );
+  REQUIRE( readReal( l_data + 6*l_size ) == 9 );
+  REQUIRE( readReal( l_data + 7*l_size ) == 6 );
+  REQUIRE( readReal( l_data + 8*l_size ) == 5 );
+
+  // second record
+  l_data += l_netCdf.m_recordSize;
+  REQUIRE( readReal( l_data + 0*l_size ) == 0.5 );
+  REQUIRE( readReal( l_data + 1*l_size ) == 20 );
+  REQUIRE( readReal( l_data + 2*l_size ) == 6 );
+  REQUIRE( readReal( l_data + 5*l_size ) == 10 );
+}
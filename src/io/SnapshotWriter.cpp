@@ -0,0 +1,136 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Asynchronous writer which hands snapshots to a dedicated I/O thread.
+ **/
+#include "SnapshotWriter.h"
+#include "../instrumentation/Profiler.h"
+#include <algorithm>
+
+tsunami_lab::io::SnapshotWriter::SnapshotWriter( t_sink i_sink,
+                                                 t_idx  i_queueDepth ): m_sink( i_sink ),
+                                                                        m_buffers( std::max( i_queueDepth, t_idx(1) ) ) {
+  for( std::size_t l_bu = 0; l_bu < m_buffers.size(); l_bu++ ) {
+    m_free.push_back( &m_buffers[l_bu] );
+  }
+
+  m_thread = std::thread( &SnapshotWriter::drain, this );
+}
+
+tsunami_lab::io::SnapshotWriter::~SnapshotWriter() {
+  finish();
+}
+
+void tsunami_lab::io::SnapshotWriter::copy( t_idx                   i_nx,
+                                            t_idx                   i_ny,
+                                            t_idx                   i_stride,
+                                            t_real          const * i_field,
+                                            std::vector< t_real > & o_field ) {
+  if( i_field == nullptr ) {
+    o_field.clear();
+    return;
+  }
+
+  // the buffers are recycled, thus the allocation only happens for the first snapshots
+  o_field.resize( i_nx * i_ny );
+  for( t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
+    std::copy( i_field + l_iy * i_stride,
+               i_field + l_iy * i_stride + i_nx,
+               o_field.begin() + l_iy * i_nx );
+  }
+}
+
+void tsunami_lab::io::SnapshotWriter::write( t_real         i_time,
+                                             t_real         i_dxy,
+                                             t_idx          i_nx,
+                                             t_idx          i_ny,
+                                             t_idx          i_stride,
+                                             t_real const * i_h,
+                                             t_real const * i_b,
+                                             t_real const * i_hu,
+                                             t_real const * i_hv ) {
+  // get a free staging buffer; blocks if all buffers are in flight
+  double l_start = instrumentation::Profiler::now();
+  Snapshot * l_snapshot = nullptr;
+  {
+    std::unique_lock< std::mutex > l_lock( m_mutex );
+    m_released.wait( l_lock, [this]{ return !m_free.empty(); } );
+    l_snapshot = m_free.back();
+    m_free.pop_back();
+  }
+  double l_end = instrumentation::Profiler::now();
+  m_timeWait += l_end - l_start;
+
+  // copy the fields while the I/O thread continues to write earlier snapshots
+  l_snapshot->id = m_count++;
+  l_snapshot->time = i_time;
+  l_snapshot->dxy = i_dxy;
+  l_snapshot->nx = i_nx;
+  l_snapshot->ny = i_ny;
+  copy( i_nx, i_ny, i_stride, i_h,  l_snapshot->h );
+  copy( i_nx, i_ny, i_stride, i_b,  l_snapshot->b );
+  copy( i_nx, i_ny, i_stride, i_hu, l_snapshot->hu );
+  copy( i_nx, i_ny, i_stride, i_hv, l_snapshot->hv );
+  m_timeCopy += instrumentation::Profiler::now() - l_end;
+
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    m_queue.push_back( l_snapshot );
+  }
+  m_queued.notify_one();
+}
+
+void tsunami_lab::io::SnapshotWriter::drain() {
+  while( true ) {
+    Snapshot * l_snapshot = nullptr;
+    {
+      std::unique_lock< std::mutex > l_lock( m_mutex );
+      m_queued.wait( l_lock, [this]{ return !m_queue.empty() || m_finish; } );
+      if( m_queue.empty() ) return;
+      l_snapshot = m_queue.front();
+      m_queue.pop_front();
+    }
+
+    double l_start = instrumentation::Profiler::now();
+    m_sink( *l_snapshot );
+    double l_time = instrumentation::Profiler::now() - l_start;
+
+    {
+      std::lock_guard< std::mutex > l_lock( m_mutex );
+      m_timeWrite += l_time;
+      m_free.push_back( l_snapshot );
+    }
+    m_released.notify_one();
+  }
+}
+
+void tsunami_lab::io::SnapshotWriter::finish() {
+  if( !m_thread.joinable() ) return;
+
+  double l_start = instrumentation::Profiler::now();
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    m_finish = true;
+  }
+  m_queued.notify_one();
+  m_thread.join();
+  m_timeDrain = instrumentation::Profiler::now() - l_start;
+}
+
+void tsunami_lab::io::SnapshotWriter::report( std::ostream & io_stream ) const {
+  // time of the I/O thread which was not hidden behind the computations
+  double l_blocked = m_timeWait + m_timeDrain;
+  double l_overlap = m_timeWrite > 0 ? std::max( 0.0, 1 - l_blocked / m_timeWrite ) : 1;
+
+  io_stream << "asynchronous output" << std::endl;
+  io_stream << "  number of snapshots:            " << m_count << std::endl;
+  io_stream << "  queue depth:                    " << m_buffers.size() << std::endl;
+  io_stream << "  time writing (I/O thread):      " << m_timeWrite << " s" << std::endl;
+  io_stream << "  time staging copies:            " << m_timeCopy << " s" << std::endl;
+  io_stream << "  time blocked by full queue:     " << m_timeWait << " s" << std::endl;
+  io_stream << "  time draining the queue:        " << m_timeDrain << " s" << std::endl;
+  io_stream << "  overlap of output and compute:  " << l_overlap * 100 << " %" << std::endl;
+}
@@ -0,0 +1,196 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Asynchronous writer which hands snapshots to a dedicated I/O thread.
+ **/
+#ifndef TSUNAMI_LAB_IO_SNAPSHOT_WRITER
+#define TSUNAMI_LAB_IO_SNAPSHOT_WRITER
+
+#include "../constants.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tsunami_lab {
+  namespace io {
+    class SnapshotWriter;
+  }
+}
+
+/**
+ * Writer which copies snapshots into staging buffers and writes them in a background thread.
+ *
+ * The writer owns a fixed number of staging buffers (the queue depth).
+ * write copies the fields into a free buffer and returns immediately, while the I/O thread drains the queue through the sink.
+ * If all buffers are in flight, write blocks until the I/O thread releases one (backpressure), which bounds the memory of the queue.
+ **/
+class tsunami_lab::io::SnapshotWriter {
+  public:
+    //! copy of the fields of a time step; rows are stored without padding, i.e., the stride is nx
+    struct Snapshot {
+      //! id of the snapshot, counted from 0
+      t_idx id = 0;
+
+      //! simulation time
+      t_real time = 0;
+
+      //! cell width in x- and y-direction
+      t_real dxy = 0;
+
+      //! number of cells in x- and y-direction
+      t_idx nx = 0;
+      t_idx ny = 0;
+
+      //! water height, bathymetry, momentum in x- and y-direction; empty if not given
+      std::vector< t_real > h;
+      std::vector< t_real > b;
+      std::vector< t_real > hu;
+      std::vector< t_real > hv;
+
+      /**
+       * Gets the data of a field.
+       *
+       * @param i_field field of the snapshot.
+       * @return data of the field; nullptr if the field was not given.
+       **/
+      static t_real const * data( std::vector< t_real > const & i_field ) {
+        return i_field.empty() ? nullptr : i_field.data();
+      }
+    };
+
+    //! function which writes a snapshot, called by the I/O thread
+    typedef std::function< void( Snapshot const & ) > t_sink;
+
+  private:
+    //! function which writes the snapshots
+    t_sink m_sink;
+
+    //! staging buffers
+    std::vector< Snapshot > m_buffers;
+
+    //! buffers which are not in flight
+    std::vector< Snapshot * > m_free;
+
+    //! snapshots which wait for the I/O thread
+    std::deque< Snapshot * > m_queue;
+
+    //! number of snapshots handed to the writer
+    t_idx m_count = 0;
+
+    //! true if the I/O thread has to terminate after draining the queue
+    bool m_finish = false;
+
+    //! synchronization of the solver and the I/O thread
+    std::mutex m_mutex;
+    std::condition_variable m_queued;
+    std::condition_variable m_released;
+
+    //! I/O thread
+    std::thread m_thread;
+
+    //! time in seconds the solver spent copying into the staging buffers
+    double m_timeCopy = 0;
+
+    //! time in seconds the solver was blocked by a full queue
+    double m_timeWait = 0;
+
+    //! time in seconds the solver waited for the I/O thread to drain the queue in finish
+    double m_timeDrain = 0;
+
+    //! time in seconds the I/O thread spent in the sink
+    double m_timeWrite = 0;
+
+    /**
+     * Main loop of the I/O thread.
+     **/
+    void drain();
+
+    /**
+     * Copies the rows of a strided field.
+     *
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the field in y-direction.
+     * @param i_field field which is copied; nullptr if not given.
+     * @param o_field will be set to the field without padding; empty if not given.
+     **/
+    static void copy( t_idx                   i_nx,
+                      t_idx                   i_ny,
+                      t_idx                   i_stride,
+                      t_real          const * i_field,
+                      std::vector< t_real > & o_field );
+
+  public:
+    /**
+     * Constructs the writer and starts the I/O thread.
+     *
+     * @param i_sink function which writes a snapshot; only called by the I/O thread, in the order of the snapshots.
+     * @param i_queueDepth maximum number of snapshots in flight; 2 double-buffers the output.
+     **/
+    SnapshotWriter( t_sink i_sink,
+                    t_idx  i_queueDepth = 2 );
+
+    /**
+     * Drains the queue and joins the I/O thread.
+     **/
+    ~SnapshotWriter();
+
+    SnapshotWriter( SnapshotWriter const & ) = delete;
+    SnapshotWriter & operator=( SnapshotWriter const & ) = delete;
+
+    /**
+     * Stages a snapshot for the I/O thread; blocks only if the queue is full.
+     *
+     * The fields are copied, i.e., the caller may modify them as soon as the call returns.
+     *
+     * @param i_time simulation time of the snapshot.
+     * @param i_dxy cell width in x- and y-direction.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the data arrays in y-direction (x is assumed to be stride-1).
+     * @param i_h water height of the cells; optional: use nullptr if not required.
+     * @param i_b bathymetry of the cells; optional: use nullptr if not required.
+     * @param i_hu momentum in x-direction of the cells; optional: use nullptr if not required.
+     * @param i_hv momentum in y-direction of the cells; optional: use nullptr if not required.
+     **/
+    void write( t_real         i_time,
+                t_real         i_dxy,
+                t_idx          i_nx,
+                t_idx          i_ny,
+                t_idx          i_stride,
+                t_real const * i_h,
+                t_real const * i_b,
+                t_real const * i_hu,
+                t_real const * i_hv );
+
+    /**
+     * Waits until all staged snapshots are written and joins the I/O thread.
+     * Further calls of write are not allowed.
+     **/
+    void finish();
+
+    /**
+     * Gets the number of snapshots handed to the writer.
+     *
+     * @return number of snapshots.
+     **/
+    t_idx getCount() const {
+      return m_count;
+    }
+
+    /**
+     * Writes a report of the time spent in I/O and the achieved overlap with the computations; call after finish.
+     *
+     * @param io_stream stream to which the report is written.
+     **/
+    void report( std::ostream & io_stream ) const;
+};
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the asynchronous snapshot writer.
+ **/
+#include <catch2/catch.hpp>
+#include "../constants.h"
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include "Csv.h"
+#include "SnapshotWriter.h"
+
+TEST_CASE( "Test the asynchronous snapshot writer.", "[SnapshotWriter]" ) {
+  // 2x2 cells with ghost cells, i.e., a stride of 4
+  tsunami_lab::t_real l_h[16]  = {  0,  1,  2,  3,
+                                    4,  5,  6,  7,
+                                    8,  9, 10, 11,
+                                   12, 13, 14, 15 };
+  tsunami_lab::t_real l_hu[16] = { 15, 14, 13, 12,
+                                   11, 10,  9,  8,
+                                    7,  6,  5,  4,
+                                    3,  2,  1,  0 };
+
+  std::vector< std::string > l_csvs;
+  std::vector< tsunami_lab::t_real > l_times;
+  std::vector< tsunami_lab::t_idx > l_ids;
+
+  {
+    // slow sink with a single buffer, which forces the writer to block; checks happen in the main thread
+    tsunami_lab::io::SnapshotWriter l_writer( [&]( tsunami_lab::io::SnapshotWriter::Snapshot const & i_snapshot ) {
+                                                std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+
+                                                std::stringstream l_stream;
+                                                tsunami_lab::io::Csv::write( i_snapshot.dxy,
+                                                                             i_snapshot.nx,
+                                                                             i_snapshot.ny,
+                                                                             i_snapshot.nx,
+                                                                             tsunami_lab::io::SnapshotWriter::Snapshot::data( i_snapshot.h ),
+                                                                             tsunami_lab::io::SnapshotWriter::Snapshot::data( i_snapshot.b ),
+                                                                             tsunami_lab::io::SnapshotWriter::Snapshot::data( i_snapshot.hu ),
+                                                                             tsunami_lab::io::SnapshotWriter::Snapshot::data( i_snapshot.hv ),
+                                                                             l_stream );
+                                                l_csvs.push_back( l_stream.str() );
+                                                l_times.push_back( i_snapshot.time );
+                                                l_ids.push_back( i_snapshot.id );
+                                              },
+                                              1 );
+
+    for( unsigned short l_sn = 0; l_sn < 4; l_sn++ ) {
+      l_writer.write( l_sn, 10, 2, 2, 4, l_h+4+1, nullptr, l_hu+4+1, nullptr );
+
+      // the writer works on a copy
+      l_h[5] += 100;
+    }
+
+    l_writer.finish();
+  }
+
+  REQUIRE( l_csvs.size() == 4 );
+  for( unsigned short l_sn = 0; l_sn < 4; l_sn++ ) {
+    REQUIRE( l_ids[l_sn] == l_sn );
+    REQUIRE( l_times[l_sn] == l_sn );
+
+    std::stringstream l_ref;
+    l_ref << "x,y,height,momentum_x\n"
+          << "5,5," << 5 + 100 * l_sn << ",10\n"
+          << "15,5,6,9\n"
+          << "5,15,9,6\n"
+          << "15,15,10,5\n";
+    REQUIRE( l_csvs[l_sn] == l_ref.str() );
+  }
+}
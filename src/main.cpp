@@ -4,7 +4,12 @@
  * @section DESCRIPTION
  * Entry-point for simulations.
  **/
+#include "instrumentation/Profiler.h"
+#include "io/Checkpoint.h"
 #include "io/Csv.h"
+#include "io/MappedSnapshots.h"
+#include "io/NetCdf.h"
+#include "io/SnapshotWriter.h"
 #include "patches/WavePropagation1d/WavePropagation1d.h"
 #include "patches/WavePropagation2d/WavePropagation2d.h"
 #include "setups/DamBreak1d/DamBreak1d.h"
@@ -14,49 +19,256 @@
 #include "setups/Bathymetry1d/Bathymetry1d.h"
 #include "setups/Bathymetry2d/Bathymetry2d.h"
 #include "setups/ShockShockReflective1d/ShockShockReflective1d.h"
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
-#include <limits>
+#include <map>
 #include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef TSUNAMI_LAB_USE_MPI
+#include "patches/WavePropagation2dMpi/WavePropagation2dMpi.h"
+#endif
 
 int main(int in_argc, char *in_argv[]) {
   // number of cells in x- and y-direction
   tsunami_lab::idx xCount = 0;
   tsunami_lab::idx yCount = 1;
 
+  // true if the setup is two-dimensional; 1d setups run on a single row of cells
+  bool setup2d = false;
+
   // set cell size
   tsunami_lab::real cellSize = 1;
 
   // solver type
   tsunami_lab::Solver solverType;
 
+  // id of this process and number of processes of a distributed run
+  int process = 0;
+  int processCount = 1;
+#ifdef TSUNAMI_LAB_USE_MPI
+  // the split schemes exchange halos within OpenMP single regions
+  int threadSupport = 0;
+  MPI_Init_thread(&in_argc, &in_argv, MPI_THREAD_SERIALIZED, &threadSupport);
+  std::atexit([]() { MPI_Finalize(); });
+  if (threadSupport < MPI_THREAD_SERIALIZED) {
+    std::cerr << "the MPI library does not support MPI_THREAD_SERIALIZED" << std::endl;
+    return EXIT_FAILURE;
+  }
+  MPI_Comm_rank(MPI_COMM_WORLD, &process);
+  MPI_Comm_size(MPI_COMM_WORLD, &processCount);
+
+  // only the first process reports
+  if (process != 0) {
+    std::cout.rdbuf(nullptr);
+  }
+#endif
+
   std::cout << "####################################" << std::endl;
   std::cout << "### Tsunami Lab                  ###" << std::endl;
   std::cout << "###                              ###" << std::endl;
   std::cout << "### https://scalable.uni-jena.de ###" << std::endl;
   std::cout << "####################################" << std::endl;
 
-  if (in_argc < 6) {
+  // split the arguments into options (--name=value) and positional arguments
+  std::vector<std::string> args;
+  std::map<std::string, std::string> options;
+  for (int arg = 1; arg < in_argc; arg++) {
+    std::string argString = in_argv[arg];
+    if (argString.compare(0, 2, "--") == 0) {
+      std::size_t separator = argString.find('=');
+      std::string name = argString.substr(2, separator - 2);
+      options[name] = separator == std::string::npos ? "" : argString.substr(separator + 1);
+    } else {
+      args.push_back(argString);
+    }
+  }
+
+  // tile size of the 2d patch
+  tsunami_lab::idx tileSizeX = 256;
+  tsunami_lab::idx tileSizeY = 32;
+
+  // output format of the snapshots
+  std::string outputFormat = "csv";
+
+  // maximum number of snapshots in flight to the I/O thread
+  tsunami_lab::idx ioQueueDepth = 2;
+
+  // CFL number of the adaptive time step
+  tsunami_lab::real cfl = 0.5;
+
+  // dimensional splitting of the 2d patch
+  tsunami_lab::Splitting splitting = tsunami_lab::UNSPLIT;
+
+  // number of cells in y-direction; 0: same as in x-direction
+  tsunami_lab::idx cellsY = 0;
+
+  // extent of the domain; 0 in y-direction: derived from square cells
+  tsunami_lab::real domainX = 10;
+  tsunami_lab::real domainY = 0;
+
+  // number of time steps between two checkpoints; 0: no checkpoints
+  tsunami_lab::idx checkpointInterval = 0;
+
+  // true if the run continues from the checkpoint
+  bool restart = false;
+
+  // report of the timers of the time loop: none, text or json
+  std::string timing = "none";
+
+  // true if the quantities shared by the edges of a cell are computed once per cell and sweep
+  bool cellCache = false;
+
+  // true if the edges are solved by their classes derived from the bathymetry
+  bool edgeClasses = true;
+
+  // true if the tiles at rest are skipped; largest change of a cell at rest
+  bool activity = false;
+  tsunami_lab::real activityThreshold = 0;
+
+  for (std::map<std::string, std::string>::const_iterator option = options.begin(); option != options.end(); option++) {
+    if (option->first == "tile-x") {
+      tileSizeX = atoi(option->second.c_str());
+    } else if (option->first == "tile-y") {
+      tileSizeY = atoi(option->second.c_str());
+    } else if (option->first == "output") {
+      outputFormat = option->second;
+      if (outputFormat != "csv" && outputFormat != "netcdf" && outputFormat != "mapped") {
+        std::cerr << "invalid output format, use csv, netcdf or mapped" << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (option->first == "io-queue") {
+      int depth = atoi(option->second.c_str());
+      if (depth < 1) {
+        std::cerr << "invalid depth of the output queue" << std::endl;
+        return EXIT_FAILURE;
+      }
+      ioQueueDepth = depth;
+    } else if (option->first == "cfl") {
+      cfl = atof(option->second.c_str());
+      if (cfl <= 0 || cfl > 1) {
+        std::cerr << "invalid CFL number, has to be in (0, 1]" << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (option->first == "splitting") {
+      if (option->second == "none") {
+        splitting = tsunami_lab::UNSPLIT;
+      } else if (option->second == "godunov") {
+        splitting = tsunami_lab::GODUNOV;
+      } else if (option->second == "strang") {
+        splitting = tsunami_lab::STRANG;
+      } else {
+        std::cerr << "invalid splitting, use none, godunov or strang" << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (option->first == "cells-y") {
+      int count = atoi(option->second.c_str());
+      if (count < 1) {
+        std::cerr << "invalid number of cells in y-direction" << std::endl;
+        return EXIT_FAILURE;
+      }
+      cellsY = count;
+    } else if (option->first == "domain-x" || option->first == "domain-y") {
+      tsunami_lab::real extent = atof(option->second.c_str());
+      if (extent <= 0) {
+        std::cerr << "invalid extent of the domain" << std::endl;
+        return EXIT_FAILURE;
+      }
+      (option->first == "domain-x" ? domainX : domainY) = extent;
+    } else if (option->first == "checkpoint") {
+      int interval = atoi(option->second.c_str());
+      if (interval < 1) {
+        std::cerr << "invalid number of time steps between checkpoints" << std::endl;
+        return EXIT_FAILURE;
+      }
+      checkpointInterval = interval;
+    } else if (option->first == "restart") {
+      restart = true;
+    } else if (option->first == "timing") {
+      timing = option->second.empty() ? "text" : option->second;
+      if (timing != "text" && timing != "json") {
+        std::cerr << "invalid timing report, use text or json" << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (option->first == "cell-cache") {
+      cellCache = true;
+    } else if (option->first == "no-edge-classes") {
+      edgeClasses = false;
+    } else if (option->first == "activity") {
+      activity = true;
+      activityThreshold = option->second.empty() ? 0 : atof(option->second.c_str());
+      if (activityThreshold < 0) {
+        std::cerr << "invalid activity threshold" << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (option->first == "threads") {
+      int threadCount = atoi(option->second.c_str());
+      if (threadCount < 1) {
+        std::cerr << "invalid number of threads" << std::endl;
+        return EXIT_FAILURE;
+      }
+#ifdef _OPENMP
+      omp_set_num_threads(threadCount);
+#endif
+    } else {
+      std::cerr << "unknown option --" << option->first << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (args.size() < 5) {
     std::cerr << "invalid number of arguments, usage:" << std::endl;
-    std::cerr << "  ./build/tsunami_lab CELLS SOLVER SETUP BOUNDARYLEFT BOUNDARYRIGHT height velocity" << std::endl;
+    std::cerr << "  ./build/tsunami_lab [OPTIONS] CELLS SOLVER SETUP BOUNDARYLEFT BOUNDARYRIGHT height velocity" << std::endl;
     std::cerr << "where CELLS is the number of cells in x-direction, "
                  "SOLVER the solver type [FWAVE, ROE], "
 					  "SETUP the setup to use [DAMBREAK, DAMBREAK2D, RARE, SHOCK, BATHYMETRY, SHOCKREFLECT] and "
 					  "BOUNDARY[LEFT/RIGT] the boundary condition to use [OUTFLOW, REFLECTING]."
               << std::endl;
+    std::cerr << "OPTIONS:" << std::endl;
+    std::cerr << "  --cells-y=N             number of cells in y-direction of 2d setups (default: CELLS)" << std::endl;
+    std::cerr << "  --domain-x=L            extent of the domain in x-direction in meters (default: 10)" << std::endl;
+    std::cerr << "  --domain-y=L            extent of the domain in y-direction in meters; cells have to be square (default: derived)" << std::endl;
+    std::cerr << "  --tile-x=N, --tile-y=N  number of cells of a tile of the 2d patch (default: 256 x 32)" << std::endl;
+    std::cerr << "  --output=FORMAT         output format of the snapshots [csv, netcdf, mapped] (default: csv)" << std::endl;
+    std::cerr << "  --io-queue=N            maximum number of snapshots in flight to the I/O thread (default: 2)" << std::endl;
+    std::cerr << "  --cfl=C                 CFL number of the adaptive time step in (0, 1], up to 0.5 for 2d setups without splitting (default: 0.5)" << std::endl;
+    std::cerr << "  --splitting=MODE        dimensional splitting of the 2d patch [none, godunov, strang] (default: none)" << std::endl;
+    std::cerr << "  --cell-cache            compute sqrt(h), u and the flux once per cell and sweep instead of once per edge side" << std::endl;
+    std::cerr << "  --no-edge-classes       gather all edges instead of skipping the ones between dry cells and solving walls in closed form" << std::endl;
+    std::cerr << "  --activity[=T]          skip the tiles of the 2d patch whose cells and neighbours changed by at most T in the last time step (default: off, T: 0)" << std::endl;
+    std::cerr << "  --threads=N             number of OpenMP threads (default: OMP_NUM_THREADS or all cores)" << std::endl;
+    std::cerr << "  --checkpoint=N          write checkpoint.bin every N time steps (default: no checkpoints)" << std::endl;
+    std::cerr << "  --restart               continue the run from checkpoint.bin" << std::endl;
+    std::cerr << "  --timing[=FORMAT]       time the phases of the time loop and report them [text, json] (default: no timing)" << std::endl;
     return EXIT_FAILURE;
   } else {
-    xCount = atoi(in_argv[1]);
-    yCount = atoi(in_argv[1]);
+    xCount = atoi(args[0].c_str());
+    setup2d = args[2] == "DAMBREAK2D" || args[2] == "BATHYMETRY2D";
+    yCount = setup2d ? (cellsY > 0 ? cellsY : xCount) : 1;
     if (xCount < 1) {
       std::cerr << "invalid number of cells" << std::endl;
       return EXIT_FAILURE;
     }
-    cellSize = 10.0 / xCount;
+    cellSize = domainX / xCount;
+
+    // the patches use a single scaling dt/dx for both directions
+    if (domainY > 0 && std::abs(domainY / yCount - cellSize) > 1E-5 * cellSize) {
+      std::cerr << "invalid extent of the domain in y-direction, the cells have to be square (" << cellSize * yCount << " m)" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (tileSizeX < 1 || tileSizeY < 1) {
+      std::cerr << "invalid tile size" << std::endl;
+      return EXIT_FAILURE;
+    }
 
-    std::string solverArg = in_argv[2];
+    std::string solverArg = args[1];
     if (solverArg == "FWAVE") {
       solverType = tsunami_lab::FWAVE;
     } else if (solverArg == "ROE") {
@@ -71,11 +283,27 @@ int main(int in_argc, char *in_argv[]) {
   std::cout << "  number of cells in x-direction: " << xCount << std::endl;
   std::cout << "  number of cells in y-direction: " << yCount << std::endl;
   std::cout << "  cell size:                      " << cellSize << std::endl;
+  std::cout << "  extent of the domain:           " << cellSize * xCount << " x " << cellSize * yCount << std::endl;
+  std::cout << "  CFL number:                     " << cfl << std::endl;
+  std::cout << "  floating point precision:       " << tsunami_lab::precisionName << std::endl;
+  std::cout << "  dimensional splitting:          " << (splitting == tsunami_lab::UNSPLIT ? "none" : (splitting == tsunami_lab::GODUNOV ? "godunov" : "strang")) << std::endl;
+  std::cout << "  cell cache:                     " << (cellCache ? "on" : "off") << std::endl;
+  std::cout << "  edge classes:                   " << (edgeClasses ? "on" : "off") << std::endl;
+  std::cout << "  activity tracking:              " << (activity ? "on" : "off") << std::endl;
+  if (activity) {
+    std::cout << "  activity threshold:             " << activityThreshold << std::endl;
+  }
+#ifdef _OPENMP
+  std::cout << "  number of threads:              " << omp_get_max_threads() << std::endl;
+#endif
+#ifdef TSUNAMI_LAB_USE_MPI
+  std::cout << "  number of processes:            " << processCount << std::endl;
+#endif
 
 	
   // boundary conditions
-  std::string boundaryLeftArg = in_argv[4];
-  std::string boundaryRightArg = in_argv[5];
+  std::string boundaryLeftArg = args[3];
+  std::string boundaryRightArg = args[4];
   tsunami_lab::Boundary boundary[2];
   if (boundaryLeftArg == "OUTFLOW") {
 	 boundary[0] = tsunami_lab::OUTFLOW;
@@ -96,82 +324,162 @@ int main(int in_argc, char *in_argv[]) {
     return EXIT_FAILURE;
   }
 
-  // construct solver
-  tsunami_lab::patches::WavePropagation *waveProp;
-
   // construct setup
-  std::string setupArg = in_argv[3];
+  std::string setupArg = args[2];
   tsunami_lab::setups::Setup *setup;
   tsunami_lab::real height = 10;
   tsunami_lab::real momentum = 50;
-  if (in_argc > 6) {
-		height = std::stof(in_argv[6]);
-		momentum = std::stof(in_argv[7]) * height;
+  if (args.size() > 6) {
+		height = std::stof(args[5]);
+		momentum = std::stof(args[6]) * height;
 	 }
   if (setupArg == "DAMBREAK") {
     setup = new tsunami_lab::setups::DamBreak1d(10, 5, 5);
-	 waveProp = new tsunami_lab::patches::WavePropagation1d(xCount);
   } else if (setupArg == "RARE") {
     setup = new tsunami_lab::setups::RareRare1d(height, momentum, 5);
-	 waveProp = new tsunami_lab::patches::WavePropagation1d(xCount);
   } else if (setupArg == "SHOCK") {
     setup = new tsunami_lab::setups::ShockShock1d(height, momentum, 5);
-	 waveProp = new tsunami_lab::patches::WavePropagation1d(xCount);
   } else if(setupArg == "BATHYMETRY") {
 	 setup = new tsunami_lab::setups::Bathymetry1d(10, 5, 5);
-	 waveProp = new tsunami_lab::patches::WavePropagation1d(xCount);
   } else if(setupArg == "SHOCKREFLECT") {
 	 setup = new tsunami_lab::setups::ShockShockReflective1d(height, momentum, 5);
-	 waveProp = new tsunami_lab::patches::WavePropagation1d(xCount);
   } else if(setupArg == "DAMBREAK2D") {
-	 setup = new tsunami_lab::setups::DamBreak2d(10, 5, 10, 100, 100, cellSize);
-	 waveProp = new tsunami_lab::patches::WavePropagation2d(xCount, yCount);
+	 setup = new tsunami_lab::setups::DamBreak2d(10, 5, 10, xCount, yCount, cellSize);
   } else if(setupArg == "BATHYMETRY2D") {
-	 setup = new tsunami_lab::setups::Bathymetry2d(10, 5, 10, 100, 100, cellSize);
-	 waveProp = new tsunami_lab::patches::WavePropagation2d(xCount, yCount);
+	 setup = new tsunami_lab::setups::Bathymetry2d(10, 5, 10, xCount, yCount, cellSize);
   } else {
     std::cerr << "invalid setup type. Please use either DAMBREAK, RARE or SHOCK" << std::endl;
     return EXIT_FAILURE;
   }
 
-  // maximum observed height in the setup
-  tsunami_lab::real heightMax =
-      std::numeric_limits<tsunami_lab::real>::lowest();
-
-  // set up solver
-  for (tsunami_lab::idx cellY = 0; cellY < yCount; cellY++) {
-    tsunami_lab::real y = cellY * cellSize;
-
-    for (tsunami_lab::idx cellX = 0; cellX < xCount; cellX++) {
-      tsunami_lab::real x = cellX * cellSize;
+  if (processCount > 1 && !setup2d) {
+    std::cerr << "distributed runs require a 2d setup" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (setup2d && splitting == tsunami_lab::UNSPLIT && cfl > 0.5) {
+    std::cerr << "invalid CFL number, the unsplit 2d scheme is stable up to 0.5, use --splitting=godunov or --splitting=strang for larger ones" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (restart && outputFormat == "netcdf") {
+    std::cerr << "restarted runs can not append to solution.nc, use --output=csv or --output=mapped" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (processCount > 1 && outputFormat == "netcdf") {
+    std::cerr << "distributed runs write one file per process, use --output=csv or --output=mapped" << std::endl;
+    return EXIT_FAILURE;
+  }
 
-      // get initial values of the setup
-      tsunami_lab::real height = setup->getHeight(x, y);
-      heightMax = std::max(height, heightMax);
+  // block of the grid owned by this process; the whole grid if the run is not distributed
+  tsunami_lab::idx offsetX = 0;
+  tsunami_lab::idx offsetY = 0;
+  tsunami_lab::idx blockCountX = xCount;
+  tsunami_lab::idx blockCountY = yCount;
 
-      tsunami_lab::real momentumX = setup->getMomentumX(x, y);
-      tsunami_lab::real momentumY = setup->getMomentumY(x, y);
-      tsunami_lab::real bathymetry = setup->getBathymetry(x, y);
+  // construct solver; the solver type is resolved once here and compiled into the patch
+  tsunami_lab::patches::WavePropagation *waveProp;
+  if (setup2d) {
+#ifdef TSUNAMI_LAB_USE_MPI
+    tsunami_lab::patches::Decomposition2d decomposition(xCount, yCount, processCount, process);
+    if (!decomposition.isValid()) {
+      std::cerr << "invalid number of processes, the grid can not be decomposed into " << processCount << " blocks" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "  process grid:                   " << decomposition.getProcessCountX() << " x " << decomposition.getProcessCountY() << std::endl;
+    offsetX = decomposition.getOffsetX();
+    offsetY = decomposition.getOffsetY();
+    blockCountX = decomposition.getCellCountX();
+    blockCountY = decomposition.getCellCountY();
+
+    if (solverType == tsunami_lab::FWAVE) {
+      waveProp = new tsunami_lab::patches::WavePropagation2dMpi<tsunami_lab::solvers::FWave>(decomposition, MPI_COMM_WORLD, tileSizeX, tileSizeY, splitting);
+    } else {
+      waveProp = new tsunami_lab::patches::WavePropagation2dMpi<tsunami_lab::solvers::Roe>(decomposition, MPI_COMM_WORLD, tileSizeX, tileSizeY, splitting);
+    }
+#else
+    if (solverType == tsunami_lab::FWAVE) {
+      waveProp = new tsunami_lab::patches::WavePropagation2d<tsunami_lab::solvers::FWave>(xCount, yCount, tileSizeX, tileSizeY, splitting);
+    } else {
+      waveProp = new tsunami_lab::patches::WavePropagation2d<tsunami_lab::solvers::Roe>(xCount, yCount, tileSizeX, tileSizeY, splitting);
+    }
+#endif
+  } else {
+    if (solverType == tsunami_lab::FWAVE) {
+      waveProp = new tsunami_lab::patches::WavePropagation1d<tsunami_lab::solvers::FWave>(xCount);
+    } else {
+      waveProp = new tsunami_lab::patches::WavePropagation1d<tsunami_lab::solvers::Roe>(xCount);
+    }
+  }
 
-      // set initial values in wave propagation solver
-      waveProp->setHeight(cellX, cellY, height - bathymetry);
+  waveProp->setCellCache(cellCache);
+  waveProp->setEdgeClasses(edgeClasses);
+  waveProp->setActivity(activity, activityThreshold);
 
-      waveProp->setMomentumX(cellX, cellY, momentumX);
+  // maximum wave speed in the setup
+  tsunami_lab::real speedMax = 0;
 
-      waveProp->setMomentumY(cellX, cellY, momentumY);
+  // checkpoint of this process
+  std::string checkpointName = "checkpoint.bin";
+  if (processCount > 1) {
+    checkpointName = "checkpoint_" + std::to_string(process) + ".bin";
+  }
+  tsunami_lab::io::Checkpoint::Header checkpoint;
+
+  if (restart) {
+    // the checkpoint replaces the setup
+    std::ifstream checkpointFile(checkpointName, std::ios::binary);
+    std::vector<tsunami_lab::real> fields[4];
+    if (!tsunami_lab::io::Checkpoint::read(checkpointFile, checkpoint, fields[0], fields[1], fields[2], fields[3])) {
+      std::cerr << "could not read the checkpoint " << checkpointName << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (checkpoint.nx != blockCountX || checkpoint.ny != blockCountY ||
+        checkpoint.offsetX != offsetX || checkpoint.offsetY != offsetY) {
+      std::cerr << "the checkpoint " << checkpointName << " does not match the grid" << std::endl;
+      return EXIT_FAILURE;
+    }
 
-      waveProp->setBathymetry(cellX, cellY, bathymetry);
+    waveProp->setValues(0, 0, blockCountX, blockCountY, blockCountX,
+                        fields[0].data(), fields[1].data(), fields[2].data(), fields[3].data());
+    speedMax = checkpoint.waveSpeedMax;
+  } else {
+    // set up solver; the setups are evaluated at the coordinates of the domain, one row per call.
+    // the threads set the rows which they touched first when the patch was allocated
+    std::chrono::steady_clock::time_point setupStart = std::chrono::steady_clock::now();
+#pragma omp parallel reduction(max: speedMax)
+    {
+      std::vector<tsunami_lab::real> height(blockCountX), momentumX(blockCountX), momentumY(blockCountX), bathymetry(blockCountX);
+
+#pragma omp for schedule(static)
+      for (tsunami_lab::idx cellY = 0; cellY < blockCountY; cellY++) {
+        // get initial values of the setup
+        setup->getValues(offsetX, offsetY + cellY, cellSize, blockCountX, 1, blockCountX,
+                         height.data(), momentumX.data(), momentumY.data(), bathymetry.data());
+
+        for (tsunami_lab::idx cellX = 0; cellX < blockCountX; cellX++) {
+          // the setups give the surface height; the patch holds the water depth
+          height[cellX] -= bathymetry[cellX];
+
+          // wave speed |u| + sqrt(gh) of wet cells
+          if (height[cellX] > 0) {
+            tsunami_lab::real speed = std::sqrt(9.81 * height[cellX])
+                                    + std::max(std::abs(momentumX[cellX]), std::abs(momentumY[cellX])) / height[cellX];
+            speedMax = std::max(speed, speedMax);
+          }
+        }
+
+        // set initial values in wave propagation solver
+        waveProp->setValues(0, cellY, blockCountX, 1, blockCountX,
+                            height.data(), momentumX.data(), momentumY.data(), bathymetry.data());
+      }
     }
+    std::cout << "  setup time:                     "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count() << " s" << std::endl;
   }
 
-  // derive maximum wave speed in setup; the momentum is ignored
-  tsunami_lab::real speedMax = std::sqrt(9.81 * heightMax);
-
-  // derive constant time step; changes at simulation time are ignored
-  tsunami_lab::real dt = 0.5 * cellSize / speedMax;
-
-  // derive scaling for a time step
-  tsunami_lab::real scaling = dt / cellSize;
+#ifdef TSUNAMI_LAB_USE_MPI
+  // all processes start with the same time step; checkpoints hold the global maximum
+  MPI_Allreduce(MPI_IN_PLACE, &speedMax, 1, sizeof(tsunami_lab::real) == sizeof(float) ? MPI_FLOAT : MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
 
   // set up time and print control
   tsunami_lab::idx timeStep = 0;
@@ -179,47 +487,233 @@ int main(int in_argc, char *in_argv[]) {
   tsunami_lab::real endTime = 1.25;
   tsunami_lab::real simTime = 0;
 
-  if (in_argc > 8) {
-	 endTime = std::stof(in_argv[8]);
+  if (args.size() > 7) {
+	 endTime = std::stof(args[7]);
+  }
+
+  // continue the time loop of the checkpoint, including the numbering of the snapshots
+  if (restart) {
+    timeStep = checkpoint.timeStep;
+    nOut = checkpoint.snapshotCount;
+    simTime = checkpoint.time;
+    std::cout << "restarted from " << checkpointName << " at simulation time / #time steps: "
+              << simTime << " / " << timeStep << std::endl;
+  }
+  tsunami_lab::idx firstOut = nOut;
+
+  // a NetCDF run writes all snapshots to a single file
+  std::ofstream netCdfFile;
+  tsunami_lab::io::NetCdf *netCdf = nullptr;
+  if (outputFormat == "netcdf") {
+    netCdfFile.open("solution.nc", std::ios::binary);
+    netCdf = new tsunami_lab::io::NetCdf(netCdfFile);
   }
 
+  // a mapped run copies the snapshots from the patch directly into the pages of solution.bin
+  tsunami_lab::io::MappedSnapshots *mapped = nullptr;
+  std::string mappedName = "solution.bin";
+  if (processCount > 1) {
+    mappedName = "solution_" + std::to_string(process) + ".bin";
+  }
+  if (outputFormat == "mapped") {
+    mapped = new tsunami_lab::io::MappedSnapshots(mappedName, blockCountX, blockCountY, cellSize, offsetX, offsetY, nOut);
+    if (!mapped->isOpen()) {
+      std::cerr << "could not open " << mappedName << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // snapshots are written by a background thread, in order of the time steps
+  tsunami_lab::io::SnapshotWriter writer(
+      [netCdf, process, processCount, offsetX, offsetY, firstOut](tsunami_lab::io::SnapshotWriter::Snapshot const &snapshot) {
+        typedef tsunami_lab::io::SnapshotWriter::Snapshot Snapshot;
+        tsunami_lab::instrumentation::ScopedTimer timer(tsunami_lab::instrumentation::Profiler::OUTPUT);
+
+        if (netCdf != nullptr) {
+          netCdf->write(snapshot.time, snapshot.dxy,
+                        snapshot.nx, snapshot.ny, snapshot.nx,
+                        Snapshot::data(snapshot.h),
+                        Snapshot::data(snapshot.b),
+                        Snapshot::data(snapshot.hu),
+                        Snapshot::data(snapshot.hv));
+        } else {
+          // every process of a distributed run writes its block
+          std::string id = std::to_string(firstOut + snapshot.id);
+          std::string name = "solution_" + id + ".csv";
+          if (processCount > 1) {
+            name = "solution_" + std::to_string(process) + "_" + id + ".csv";
+          }
+
+          std::ofstream file;
+          file.open(name);
+
+          tsunami_lab::io::Csv::write(snapshot.dxy,
+                                      snapshot.nx, snapshot.ny, snapshot.nx,
+                                      Snapshot::data(snapshot.h),
+                                      Snapshot::data(snapshot.b),
+                                      Snapshot::data(snapshot.hu),
+                                      Snapshot::data(snapshot.hv),
+                                      file,
+                                      offsetX, offsetY);
+          file.close();
+        }
+      },
+      ioQueueDepth);
+
+  // time spent in the time loop and writing checkpoints
+  double timeLoop = 0;
+  double timeCheckpoint = 0;
+  tsunami_lab::idx checkpointCount = 0;
+
+  // sum of the active fractions of the patch over the time steps of the loop
+  double activeFractionSum = 0;
+  tsunami_lab::idx loopStepCount = 0;
+
+  // the timers are enabled for the time loop only
+  tsunami_lab::instrumentation::Profiler::setEnabled(timing != "none");
+
   std::cout << "entering time loop" << std::endl;
+  std::chrono::steady_clock::time_point loopStart = std::chrono::steady_clock::now();
 
   // iterate over time
   while (simTime < endTime) {
     if (timeStep % 25 == 0) {
       std::cout << "  simulation time / #time steps: " << simTime << " / "
                 << timeStep << std::endl;
-
-      std::string path = "solution_" + std::to_string(nOut) + ".csv";
-      std::cout << "  writing wave field to " << path << std::endl;
-
-      std::ofstream file;
-      file.open(path);
-
-      tsunami_lab::io::Csv::write(cellSize, 
-											 xCount, yCount, xCount, 
-											 waveProp->getHeight(),
-                                  waveProp->getBathymetry(), 
-											 waveProp->getMomentumX(), 
-											 waveProp->getMomentumY(), 
-											 file);
-      file.close();
+      if (activity && loopStepCount > 0) {
+        std::cout << "  active fraction of the last time step: " << waveProp->getActiveFraction() << std::endl;
+      }
+
+      if (netCdf != nullptr) {
+        std::cout << "  appending wave field to solution.nc" << std::endl;
+      } else if (mapped != nullptr) {
+        std::cout << "  writing wave field to slot " << nOut << " of " << mappedName << std::endl;
+      } else if (processCount > 1) {
+        std::cout << "  writing wave field to solution_*_" << nOut << ".csv" << std::endl;
+      } else {
+        std::cout << "  writing wave field to solution_" << nOut << ".csv" << std::endl;
+      }
+
+      if (mapped != nullptr) {
+        // no staging copy, the kernel writes the pages back asynchronously
+        tsunami_lab::instrumentation::ScopedTimer timer(tsunami_lab::instrumentation::Profiler::OUTPUT);
+        if (!mapped->write(simTime, waveProp->getStride(),
+                           waveProp->getHeight(),
+                           waveProp->getMomentumX(),
+                           waveProp->getMomentumY(),
+                           waveProp->getBathymetry())) {
+          std::cerr << "could not write to " << mappedName << std::endl;
+          return EXIT_FAILURE;
+        }
+      } else {
+        // stage a copy; the time loop continues while the I/O thread writes
+        writer.write(simTime, cellSize,
+                     blockCountX, blockCountY, waveProp->getStride(),
+                     waveProp->getHeight(),
+                     waveProp->getBathymetry(),
+                     waveProp->getMomentumX(),
+                     waveProp->getMomentumY());
+      }
       nOut++;
     }
-    waveProp->setGhostOutflow(boundary);
-    waveProp->timeStep(scaling, solverType);
+    // derive the largest stable time step from the maximum wave speed
+    tsunami_lab::real dt = cfl * cellSize / speedMax;
+    tsunami_lab::real scaling = dt / cellSize;
+
+    double stepStart = tsunami_lab::instrumentation::Profiler::isEnabled() ? tsunami_lab::instrumentation::Profiler::now() : 0;
+    {
+      tsunami_lab::instrumentation::ScopedTimer timer(tsunami_lab::instrumentation::Profiler::GHOST_CELLS);
+      waveProp->setGhostOutflow(boundary);
+    }
+    waveProp->timeStep(scaling);
+    if (tsunami_lab::instrumentation::Profiler::isEnabled()) {
+      tsunami_lab::instrumentation::Profiler::addStep(tsunami_lab::instrumentation::Profiler::now() - stepStart,
+                                                      blockCountX * blockCountY);
+    }
+    activeFractionSum += waveProp->getActiveFraction();
+    loopStepCount++;
+
+    // the patch reports the wave speeds of the solved Riemann problems
+    if (waveProp->getWaveSpeedMax() > 0) {
+      speedMax = waveProp->getWaveSpeedMax();
+    }
 
     timeStep++;
     simTime += dt;
+
+    if (checkpointInterval > 0 && timeStep % checkpointInterval == 0) {
+      std::chrono::steady_clock::time_point checkpointStart = std::chrono::steady_clock::now();
+
+      checkpoint.nx = blockCountX;
+      checkpoint.ny = blockCountY;
+      checkpoint.offsetX = offsetX;
+      checkpoint.offsetY = offsetY;
+      checkpoint.timeStep = timeStep;
+      checkpoint.snapshotCount = nOut;
+      checkpoint.time = simTime;
+      checkpoint.waveSpeedMax = speedMax;
+
+      // the previous checkpoint is replaced once the new one is complete
+      std::ofstream checkpointFile(checkpointName + ".tmp", std::ios::binary);
+      tsunami_lab::io::Checkpoint::write(checkpoint, waveProp->getStride(),
+                                         waveProp->getHeight(),
+                                         waveProp->getMomentumX(),
+                                         waveProp->getMomentumY(),
+                                         waveProp->getBathymetry(),
+                                         checkpointFile);
+      checkpointFile.close();
+      if (!checkpointFile || std::rename((checkpointName + ".tmp").c_str(), checkpointName.c_str()) != 0) {
+        std::cerr << "could not write the checkpoint " << checkpointName << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      timeCheckpoint += std::chrono::duration<double>(std::chrono::steady_clock::now() - checkpointStart).count();
+      checkpointCount++;
+    }
+  }
+  timeLoop = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+
+  std::cout << "finished time loop after " << timeStep << " time steps" << std::endl;
+  if (checkpointCount > 0) {
+    std::cout << "checkpoints" << std::endl;
+    std::cout << "  number of checkpoints:          " << checkpointCount << std::endl;
+    std::cout << "  time writing checkpoints:       " << timeCheckpoint << " s" << std::endl;
+    std::cout << "  fraction of the time loop:      " << 100 * timeCheckpoint / timeLoop << " %" << std::endl;
+  }
+  if (edgeClasses && loopStepCount > 0) {
+    std::cout << "edge classes" << std::endl;
+    std::cout << "  skipped fraction of the edges:  " << waveProp->getSkippedFraction() << std::endl;
+  }
+  if (activity && loopStepCount > 0) {
+    std::cout << "activity tracking" << std::endl;
+    std::cout << "  mean active fraction:           " << activeFractionSum / loopStepCount << std::endl;
   }
 
-  std::cout << "finished time loop" << std::endl;
+  // wait for the outstanding snapshots
+  writer.finish();
+  // mapped snapshots bypass the writer
+  if (writer.getCount() > 0) {
+    writer.report(std::cout);
+  }
+
+  if (timing != "none") {
+    tsunami_lab::instrumentation::Profiler::setEnabled(false);
+    tsunami_lab::instrumentation::Profiler::report(std::cout);
+
+    if (timing == "json") {
+      std::string timingName = processCount > 1 ? "timing_" + std::to_string(process) + ".json" : "timing.json";
+      std::ofstream timingFile(timingName);
+      tsunami_lab::instrumentation::Profiler::reportJson(timingFile);
+      std::cout << "  written to:                     " << timingName << std::endl;
+    }
+  }
 
   // free memory
   std::cout << "freeing memory" << std::endl;
   delete setup;
   delete waveProp;
+  delete netCdf;
+  delete mapped;
 
   std::cout << "finished, exiting" << std::endl;
   return EXIT_SUCCESS;
@@ -0,0 +1,45 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Decomposition of a two-dimensional grid into rectangular blocks.
+ **/
+#include "Decomposition2d.h"
+
+tsunami_lab::patches::Decomposition2d::Decomposition2d( idx in_cellCountX,
+                                                        idx in_cellCountY,
+                                                        int in_processCount,
+                                                        int in_process ) {
+	if( in_processCount < 1 || in_process < 0 || in_process >= in_processCount ) return;
+	idx processCount = in_processCount;
+
+	// factorization with the shortest cut, i.e., the smallest number of cells in the halos
+	idx cutMin = 0;
+	for( idx countX = 1; countX <= processCount; countX++ ) {
+		if( processCount % countX != 0 ) continue;
+		idx countY = processCount / countX;
+		if( countX > in_cellCountX || countY > in_cellCountY ) continue;
+
+		idx cut = (countX - 1) * in_cellCountY + (countY - 1) * in_cellCountX;
+		if( processCountX == 0 || cut < cutMin ) {
+			cutMin = cut;
+			processCountX = countX;
+			processCountY = countY;
+		}
+	}
+	if( processCountX == 0 ) return;
+
+	processX = in_process % processCountX;
+	processY = in_process / processCountX;
+
+	offsetX = processX * in_cellCountX / processCountX;
+	offsetY = processY * in_cellCountY / processCountY;
+	cellCountX = (processX + 1) * in_cellCountX / processCountX - offsetX;
+	cellCountY = (processY + 1) * in_cellCountY / processCountY - offsetY;
+
+	if( processX > 0 ) neighbours[LEFT] = in_process - 1;
+	if( processX + 1 < processCountX ) neighbours[RIGHT] = in_process + 1;
+	if( processY > 0 ) neighbours[BOTTOM] = in_process - int(processCountX);
+	if( processY + 1 < processCountY ) neighbours[TOP] = in_process + int(processCountX);
+}
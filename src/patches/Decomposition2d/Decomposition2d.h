@@ -0,0 +1,140 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Decomposition of a two-dimensional grid into rectangular blocks.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_DECOMPOSITION_2D
+#define TSUNAMI_LAB_PATCHES_DECOMPOSITION_2D
+
+#include "../../constants.h"
+
+namespace tsunami_lab {
+	namespace patches {
+		class Decomposition2d;
+	}
+}
+
+/**
+ * @brief Partition of a grid into a process grid of rectangular blocks, e.g., for the MPI ranks of a distributed run.
+ *
+ * Process p is located at (p % processCountX, p / processCountX) of the process grid.
+ * The blocks of a row (column) of the process grid differ by at most one cell in x-direction (y-direction).
+ * Among the factorizations of the process count, the one with the shortest cut between the blocks is used,
+ * which minimizes the size of the halos exchanged in every time step.
+ **/
+class tsunami_lab::patches::Decomposition2d {
+	public:
+		//! sides of a block, same order as the boundaries of the patches: -x, x, -y, y
+		enum Side { LEFT = 0, RIGHT = 1, BOTTOM = 2, TOP = 3 };
+
+	private:
+		//! number of processes in x- and y-direction; 0 if the grid can not be decomposed
+		idx processCountX = 0;
+		idx processCountY = 0;
+
+		//! position of the process in the process grid
+		idx processX = 0;
+		idx processY = 0;
+
+		//! first cell of the block in the global grid
+		idx offsetX = 0;
+		idx offsetY = 0;
+
+		//! number of cells of the block
+		idx cellCountX = 0;
+		idx cellCountY = 0;
+
+		//! neighbouring processes on the sides of the block; -1 on the boundary of the domain
+		int neighbours[4] = { -1, -1, -1, -1 };
+
+	public:
+		/**
+		 * @brief Decomposes the grid and derives the block of the given process.
+		 *
+		 * @param in_cellCountX number of cells of the grid in x-direction.
+		 * @param in_cellCountY number of cells of the grid in y-direction.
+		 * @param in_processCount number of processes.
+		 * @param in_process id of the process in [0, in_processCount).
+		 **/
+		Decomposition2d( idx in_cellCountX,
+		                 idx in_cellCountY,
+		                 int in_processCount,
+		                 int in_process );
+
+		/**
+		 * @brief Checks whether every process got at least one cell.
+		 *
+		 * @return true if the grid was decomposed.
+		 **/
+		bool isValid() const {
+			return processCountX > 0;
+		}
+
+		/**
+		 * @brief Gets the number of processes in x-direction.
+		 *
+		 * @return number of processes.
+		 **/
+		idx getProcessCountX() const {
+			return processCountX;
+		}
+
+		/**
+		 * @brief Gets the number of processes in y-direction.
+		 *
+		 * @return number of processes.
+		 **/
+		idx getProcessCountY() const {
+			return processCountY;
+		}
+
+		/**
+		 * @brief Gets the first cell of the block in x-direction.
+		 *
+		 * @return id of the cell in the global grid.
+		 **/
+		idx getOffsetX() const {
+			return offsetX;
+		}
+
+		/**
+		 * @brief Gets the first cell of the block in y-direction.
+		 *
+		 * @return id of the cell in the global grid.
+		 **/
+		idx getOffsetY() const {
+			return offsetY;
+		}
+
+		/**
+		 * @brief Gets the number of cells of the block in x-direction.
+		 *
+		 * @return number of cells.
+		 **/
+		idx getCellCountX() const {
+			return cellCountX;
+		}
+
+		/**
+		 * @brief Gets the number of cells of the block in y-direction.
+		 *
+		 * @return number of cells.
+		 **/
+		idx getCellCountY() const {
+			return cellCountY;
+		}
+
+		/**
+		 * @brief Gets the neighbouring process on a side of the block.
+		 *
+		 * @param in_side side of the block.
+		 * @return id of the neighbour; -1 if the side is a boundary of the domain.
+		 **/
+		int getNeighbour( Side in_side ) const {
+			return neighbours[in_side];
+		}
+};
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the decomposition of two-dimensional grids.
+ **/
+#include <catch2/catch.hpp>
+#include "Decomposition2d.h"
+#include <vector>
+
+TEST_CASE( "Test the decomposition of a grid into blocks.", "[Decomposition2d]" ) {
+  typedef tsunami_lab::patches::Decomposition2d Decomposition2d;
+
+  // square grid: 2 x 2 blocks, elongated grid: stripes along the long side
+  Decomposition2d square( 100, 100, 4, 0 );
+  REQUIRE( square.getProcessCountX() == 2 );
+  REQUIRE( square.getProcessCountY() == 2 );
+
+  Decomposition2d elongated( 1000, 10, 4, 0 );
+  REQUIRE( elongated.getProcessCountX() == 4 );
+  REQUIRE( elongated.getProcessCountY() == 1 );
+
+  // too many processes for the cells
+  REQUIRE( !Decomposition2d( 2, 2, 5, 0 ).isValid() );
+  REQUIRE( Decomposition2d( 7, 1, 1, 0 ).isValid() );
+
+  // the blocks of 6 processes cover a grid of 37 x 23 cells exactly once, neighbours are mutual
+  tsunami_lab::idx const cellCountX = 37;
+  tsunami_lab::idx const cellCountY = 23;
+  std::vector< int > owner( cellCountX * cellCountY, -1 );
+  for( int process = 0; process < 6; process++ ) {
+    Decomposition2d block( cellCountX, cellCountY, 6, process );
+    REQUIRE( block.isValid() );
+    REQUIRE( block.getProcessCountX() * block.getProcessCountY() == 6 );
+
+    for( tsunami_lab::idx y = 0; y < block.getCellCountY(); y++ ) {
+      for( tsunami_lab::idx x = 0; x < block.getCellCountX(); x++ ) {
+        tsunami_lab::idx cell = (block.getOffsetY() + y) * cellCountX + block.getOffsetX() + x;
+        REQUIRE( owner[cell] == -1 );
+        owner[cell] = process;
+      }
+    }
+
+    Decomposition2d::Side opposite[4] = { Decomposition2d::RIGHT, Decomposition2d::LEFT, Decomposition2d::TOP, Decomposition2d::BOTTOM };
+    for( unsigned short side = 0; side < 4; side++ ) {
+      int neighbour = block.getNeighbour( Decomposition2d::Side( side ) );
+      if( neighbour < 0 ) continue;
+
+      Decomposition2d blockNeighbour( cellCountX, cellCountY, 6, neighbour );
+      REQUIRE( blockNeighbour.getNeighbour( opposite[side] ) == process );
+
+      // neighbours share the full side
+      if( side < 2 ) {
+        REQUIRE( blockNeighbour.getOffsetY() == block.getOffsetY() );
+        REQUIRE( blockNeighbour.getCellCountY() == block.getCellCountY() );
+      } else {
+        REQUIRE( blockNeighbour.getOffsetX() == block.getOffsetX() );
+        REQUIRE( blockNeighbour.getCellCountX() == block.getCellCountX() );
+      }
+    }
+  }
+
+  for( tsunami_lab::idx cell = 0; cell < owner.size(); cell++ ) {
+    REQUIRE( owner[cell] != -1 );
+  }
+}
@@ -0,0 +1,469 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Structure of arrays for a row of edges which are gathered, solved and scattered by the patches.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_EDGE_BATCH
+#define TSUNAMI_LAB_PATCHES_EDGE_BATCH
+
+#include "../constants.h"
+#include "../instrumentation/Profiler.h"
+#include "EdgeClasses.h"
+#include <algorithm>
+#include <vector>
+
+namespace tsunami_lab {
+	namespace patches {
+		class EdgeBatch;
+	}
+}
+
+/**
+ * @brief Contiguous edge states and net-updates of a row of edges.
+ *
+ * The patches process the edges of a row in three streaming loops:
+ *   gather: copies the cell quantities of both sides into the buffers; dry cells (bathymetry > 0) are replaced by reflecting walls through masked selects,
+ *   solve: calls the batched Riemann solver on the whole row,
+ *   scatter: applies the net-updates to the cells (done by the patches, which know their update pattern).
+ * The stages perform the same operations as a per-edge solve, such that the results do not change.
+ *
+ * With the optional cell cache, the square roots of the heights, the particle velocities and the fluxes of the momentum
+ * are computed once per cell of a row (computeCells) instead of once per side of an edge.
+ * gatherCached selects them for the edges together with the states and solveCached passes them to the solver.
+ * Rows without dry cells pass the cached rows of cells to the solver without copies.
+ *
+ * With precomputed edge classes (solveClassified), the gather is skipped: runs of wet edges are solved in place on the cells,
+ * edges with a single dry cell by the closed-form wall update of the solver and edges between two dry cells not at all.
+ **/
+class tsunami_lab::patches::EdgeBatch {
+	public:
+		//! heights, momenta normal to the edges and bathymetry of the left (bottom) and right (top) sides
+		std::vector< real > heightLeft, heightRight;
+		std::vector< real > momentumLeft, momentumRight;
+		std::vector< real > bathymetryLeft, bathymetryRight;
+
+		//! net-updates of the height and momentum for the left (bottom) and right (top) sides
+		std::vector< real > netUpdateLeftHeight, netUpdateLeftMomentum;
+		std::vector< real > netUpdateRightHeight, netUpdateRightMomentum;
+
+		//! maximum wave speeds of the edges
+		std::vector< real > waveSpeed;
+
+		//! number of edges solved since construction
+		idx solvedCount = 0;
+
+		//! number of edges with a single dry cell (walls) and between two dry cells (skipped) since construction; walls are counted as solved
+		idx wallCount = 0;
+		idx skippedCount = 0;
+
+		//! quantities of a row of cells which are shared by the edges of the cells, see cellQuantitiesBatch of the solvers
+		struct CellRow {
+			std::vector< realCompute > sqrtHeight, velocity, flux;
+		};
+
+		//! cached rows of cells; two rows allow to reuse the top row of an edge row as bottom row of the next one
+		CellRow cellRows[2];
+
+		//! cached quantities of the left (bottom) and right (top) sides of the edges with dry cells
+		std::vector< realCompute > sqrtHeightLeft, sqrtHeightRight;
+		std::vector< realCompute > velocityLeft, velocityRight;
+		std::vector< realCompute > fluxLeft, fluxRight;
+
+		//! cached quantities of one side of the gathered edges
+		struct CachedSide {
+			realCompute const * sqrtHeight = nullptr;
+			realCompute const * velocity = nullptr;
+			realCompute const * flux = nullptr;
+		};
+
+		//! cached quantities of the left (bottom) and right (top) sides of the edges gathered by gatherCached
+		CachedSide cachedLeft, cachedRight;
+
+		/**
+		 * @brief Allocates the buffers.
+		 *
+		 * @param in_capacity maximum number of edges of a row.
+		 * @param in_cellCache true if the buffers of the cell cache are allocated.
+		 **/
+		explicit EdgeBatch( idx in_capacity = 0,
+		                    bool in_cellCache = false ) {
+			resize( in_capacity, in_cellCache );
+		}
+
+		/**
+		 * @brief Resizes the buffers.
+		 *
+		 * @param in_capacity maximum number of edges of a row.
+		 * @param in_cellCache true if the buffers of the cell cache are allocated, otherwise they are released.
+		 **/
+		void resize( idx in_capacity,
+		             bool in_cellCache = false ) {
+			std::vector< real > * buffers[11] = { &heightLeft, &heightRight,
+			                                      &momentumLeft, &momentumRight,
+			                                      &bathymetryLeft, &bathymetryRight,
+			                                      &netUpdateLeftHeight, &netUpdateLeftMomentum,
+			                                      &netUpdateRightHeight, &netUpdateRightMomentum,
+			                                      &waveSpeed };
+			for( unsigned short buffer = 0; buffer < 11; buffer++ ) {
+				buffers[buffer]->resize( in_capacity );
+			}
+
+			// a row of edges is bounded by one more cell than edges
+			std::vector< realCompute > * buffersCache[12] = { &sqrtHeightLeft, &sqrtHeightRight,
+			                                                  &velocityLeft, &velocityRight,
+			                                                  &fluxLeft, &fluxRight,
+			                                                  &cellRows[0].sqrtHeight, &cellRows[0].velocity, &cellRows[0].flux,
+			                                                  &cellRows[1].sqrtHeight, &cellRows[1].velocity, &cellRows[1].flux };
+			for( unsigned short buffer = 0; buffer < 12; buffer++ ) {
+				buffersCache[buffer]->resize( in_cellCache ? in_capacity + (buffer < 6 ? 0 : 1) : 0 );
+				buffersCache[buffer]->shrink_to_fit();
+			}
+		}
+
+		/**
+		 * @brief Computes the cached quantities of a row of cells.
+		 *
+		 * @param io_cells row of cells; at least in_count entries.
+		 * @param in_count number of cells; at most the capacity plus one.
+		 * @param in_height heights of the cells.
+		 * @param in_momentum momenta of the cells in the direction of the sweep.
+		 *
+		 * @tparam t_solver Riemann solver.
+		 **/
+		template< typename t_solver >
+		void computeCells( CellRow & io_cells,
+		                   idx in_count,
+		                   real const * in_height,
+		                   real const * in_momentum ) {
+			instrumentation::ScopedTimer timer( instrumentation::Profiler::SOLVER );
+			t_solver::cellQuantitiesBatch( in_count,
+			                               in_height,
+			                               in_momentum,
+			                               io_cells.sqrtHeight.data(),
+			                               io_cells.velocity.data(),
+			                               io_cells.flux.data() );
+		}
+
+		/**
+		 * @brief Gathers the states of a row of edges; dry cells act as reflecting walls.
+		 *
+		 * All inputs are unit-stride, i.e., edge i is located between in_heightLeft[i] and in_heightRight[i].
+		 *
+		 * @param in_count number of edges; at most the capacity.
+		 * @param in_heightLeft heights of the left (bottom) cells.
+		 * @param in_heightRight heights of the right (top) cells.
+		 * @param in_momentumLeft momenta normal to the edges of the left (bottom) cells.
+		 * @param in_momentumRight momenta normal to the edges of the right (top) cells.
+		 * @param in_bathymetryLeft bathymetry of the left (bottom) cells.
+		 * @param in_bathymetryRight bathymetry of the right (top) cells.
+		 * @return number of edges with at least one dry cell.
+		 **/
+		idx gather( idx in_count,
+		             real const * in_heightLeft,
+		             real const * in_heightRight,
+		             real const * in_momentumLeft,
+		             real const * in_momentumRight,
+		             real const * in_bathymetryLeft,
+		             real const * in_bathymetryRight ) {
+			real * hL = heightLeft.data();
+			real * hR = heightRight.data();
+			real * huL = momentumLeft.data();
+			real * huR = momentumRight.data();
+			real * bL = bathymetryLeft.data();
+			real * bR = bathymetryRight.data();
+
+			idx dryCount = 0;
+#pragma omp simd reduction(+: dryCount)
+			for( idx edge = 0; edge < in_count; edge++ ) {
+				// unconditional loads and selects which do not depend on each other, such that the loop is vectorized with blends
+				real heightCellL = in_heightLeft[edge];
+				real heightCellR = in_heightRight[edge];
+				real momentumCellL = in_momentumLeft[edge];
+				real momentumCellR = in_momentumRight[edge];
+				real bathymetryCellL = in_bathymetryLeft[edge];
+				real bathymetryCellR = in_bathymetryRight[edge];
+
+				// a dry left cell mirrors the right one, afterwards a dry right cell mirrors the (possibly mirrored) left one;
+				// if both are dry, the right cell mirrors its own mirror, i.e., keeps its state
+				bool dryLeft = bathymetryCellL > 0;
+				bool mirrorRight = bathymetryCellR > 0 && !dryLeft;
+
+				hL[edge] = dryLeft ? heightCellR : heightCellL;
+				huL[edge] = dryLeft ? -momentumCellR : momentumCellL;
+				bL[edge] = dryLeft ? bathymetryCellR : bathymetryCellL;
+				hR[edge] = mirrorRight ? heightCellL : heightCellR;
+				huR[edge] = mirrorRight ? -momentumCellL : momentumCellR;
+				bR[edge] = mirrorRight ? bathymetryCellL : bathymetryCellR;
+
+				dryCount += ( dryLeft || bathymetryCellR > 0 ) ? 1 : 0;
+			}
+
+			return dryCount;
+		}
+
+		/**
+		 * @brief Gathers the states and the cached cell quantities of a row of edges; dry cells act as reflecting walls.
+		 *
+		 * Performs the same selects as gather. A mirrored cell has the negated momentum, thus its particle velocity is negated
+		 * while the square root of its height and its flux (quadratic in the momentum) are copied.
+		 * If no cell of the edges is dry, the cached sides point into the rows of cells, which have to be kept until the edges are solved.
+		 *
+		 * @param in_count number of edges; at most the capacity.
+		 * @param in_heightLeft heights of the left (bottom) cells.
+		 * @param in_heightRight heights of the right (top) cells.
+		 * @param in_momentumLeft momenta normal to the edges of the left (bottom) cells.
+		 * @param in_momentumRight momenta normal to the edges of the right (top) cells.
+		 * @param in_bathymetryLeft bathymetry of the left (bottom) cells.
+		 * @param in_bathymetryRight bathymetry of the right (top) cells.
+		 * @param in_cellsLeft cached row of the left (bottom) cells.
+		 * @param in_offsetLeft position of the left (bottom) cell of the first edge in in_cellsLeft.
+		 * @param in_cellsRight cached row of the right (top) cells.
+		 * @param in_offsetRight position of the right (top) cell of the first edge in in_cellsRight.
+		 **/
+		void gatherCached( idx in_count,
+		                   real const * in_heightLeft,
+		                   real const * in_heightRight,
+		                   real const * in_momentumLeft,
+		                   real const * in_momentumRight,
+		                   real const * in_bathymetryLeft,
+		                   real const * in_bathymetryRight,
+		                   CellRow const & in_cellsLeft,
+		                   idx in_offsetLeft,
+		                   CellRow const & in_cellsRight,
+		                   idx in_offsetRight ) {
+			idx dryCount = gather( in_count,
+			                       in_heightLeft, in_heightRight,
+			                       in_momentumLeft, in_momentumRight,
+			                       in_bathymetryLeft, in_bathymetryRight );
+
+			realCompute const * sqrtHeightCellsL = in_cellsLeft.sqrtHeight.data() + in_offsetLeft;
+			realCompute const * sqrtHeightCellsR = in_cellsRight.sqrtHeight.data() + in_offsetRight;
+			realCompute const * velocityCellsL = in_cellsLeft.velocity.data() + in_offsetLeft;
+			realCompute const * velocityCellsR = in_cellsRight.velocity.data() + in_offsetRight;
+			realCompute const * fluxCellsL = in_cellsLeft.flux.data() + in_offsetLeft;
+			realCompute const * fluxCellsR = in_cellsRight.flux.data() + in_offsetRight;
+
+			// the sides of wet edges are the cells
+			if( dryCount == 0 ) {
+				cachedLeft.sqrtHeight = sqrtHeightCellsL;
+				cachedLeft.velocity = velocityCellsL;
+				cachedLeft.flux = fluxCellsL;
+				cachedRight.sqrtHeight = sqrtHeightCellsR;
+				cachedRight.velocity = velocityCellsR;
+				cachedRight.flux = fluxCellsR;
+				return;
+			}
+
+			realCompute * sL = sqrtHeightLeft.data();
+			realCompute * sR = sqrtHeightRight.data();
+			realCompute * uL = velocityLeft.data();
+			realCompute * uR = velocityRight.data();
+			realCompute * fL = fluxLeft.data();
+			realCompute * fR = fluxRight.data();
+
+#pragma omp simd
+			for( idx edge = 0; edge < in_count; edge++ ) {
+				realCompute sqrtHeightCellL = sqrtHeightCellsL[edge];
+				realCompute sqrtHeightCellR = sqrtHeightCellsR[edge];
+				realCompute velocityCellL = velocityCellsL[edge];
+				realCompute velocityCellR = velocityCellsR[edge];
+				realCompute fluxCellL = fluxCellsL[edge];
+				realCompute fluxCellR = fluxCellsR[edge];
+
+				bool dryLeft = in_bathymetryLeft[edge] > 0;
+				bool mirrorRight = in_bathymetryRight[edge] > 0 && !dryLeft;
+
+				sL[edge] = dryLeft ? sqrtHeightCellR : sqrtHeightCellL;
+				uL[edge] = dryLeft ? -velocityCellR : velocityCellL;
+				fL[edge] = dryLeft ? fluxCellR : fluxCellL;
+				sR[edge] = mirrorRight ? sqrtHeightCellL : sqrtHeightCellR;
+				uR[edge] = mirrorRight ? -velocityCellL : velocityCellR;
+				fR[edge] = mirrorRight ? fluxCellL : fluxCellR;
+			}
+
+			cachedLeft.sqrtHeight = sL;
+			cachedLeft.velocity = uL;
+			cachedLeft.flux = fL;
+			cachedRight.sqrtHeight = sR;
+			cachedRight.velocity = uR;
+			cachedRight.flux = fR;
+		}
+
+		/**
+		 * @brief Solves the gathered edges with the batched Riemann solver.
+		 *
+		 * @param in_count number of edges.
+		 * @param in_waveSpeedMax maximum wave speed of the edges solved before.
+		 * @return maximum of in_waveSpeedMax and the wave speeds of the solved edges.
+		 *
+		 * @tparam t_solver Riemann solver.
+		 **/
+		template< typename t_solver >
+		real solve( idx in_count,
+		            real in_waveSpeedMax ) {
+			instrumentation::ScopedTimer timer( instrumentation::Profiler::SOLVER );
+			t_solver::netUpdatesBatch( in_count,
+			                           heightLeft.data(), heightRight.data(),
+			                           momentumLeft.data(), momentumRight.data(),
+			                           bathymetryLeft.data(), bathymetryRight.data(),
+			                           netUpdateLeftHeight.data(), netUpdateLeftMomentum.data(),
+			                           netUpdateRightHeight.data(), netUpdateRightMomentum.data(),
+			                           waveSpeed.data() );
+			solvedCount += in_count;
+
+			for( idx edge = 0; edge < in_count; edge++ ) {
+				in_waveSpeedMax = std::max( in_waveSpeedMax, waveSpeed[edge] );
+			}
+			return in_waveSpeedMax;
+		}
+
+		/**
+		 * @brief Solves the edges gathered by gatherCached with the batched Riemann solver, which consumes the cached cell quantities.
+		 *
+		 * @param in_count number of edges.
+		 * @param in_waveSpeedMax maximum wave speed of the edges solved before.
+		 * @return maximum of in_waveSpeedMax and the wave speeds of the solved edges.
+		 *
+		 * @tparam t_solver Riemann solver.
+		 **/
+		template< typename t_solver >
+		real solveCached( idx in_count,
+		                  real in_waveSpeedMax ) {
+			instrumentation::ScopedTimer timer( instrumentation::Profiler::SOLVER );
+			t_solver::netUpdatesBatchCached( in_count,
+			                                 heightLeft.data(), heightRight.data(),
+			                                 momentumLeft.data(), momentumRight.data(),
+			                                 bathymetryLeft.data(), bathymetryRight.data(),
+			                                 cachedLeft.sqrtHeight, cachedRight.sqrtHeight,
+			                                 cachedLeft.velocity, cachedRight.velocity,
+			                                 cachedLeft.flux, cachedRight.flux,
+			                                 netUpdateLeftHeight.data(), netUpdateLeftMomentum.data(),
+			                                 netUpdateRightHeight.data(), netUpdateRightMomentum.data(),
+			                                 waveSpeed.data() );
+			solvedCount += in_count;
+
+			for( idx edge = 0; edge < in_count; edge++ ) {
+				in_waveSpeedMax = std::max( in_waveSpeedMax, waveSpeed[edge] );
+			}
+			return in_waveSpeedMax;
+		}
+
+		/**
+		 * @brief Solves a row of edges on the cells without gather, using the precomputed classes of the edges.
+		 *
+		 * The row is traversed in runs of the same class. Runs of wet edges are solved in place with the batched Riemann solver,
+		 * runs of edges with a single dry cell by the closed-form update of a reflecting wall, which is identical to the solver on the mirrored state.
+		 * Dry cells receive zero net-updates and wave speeds, i.e., edges between two dry cells are skipped.
+		 * All inputs are unit-stride as in gather.
+		 *
+		 * @param in_count number of edges; at most the capacity.
+		 * @param in_heightLeft heights of the left (bottom) cells.
+		 * @param in_heightRight heights of the right (top) cells.
+		 * @param in_momentumLeft momenta normal to the edges of the left (bottom) cells.
+		 * @param in_momentumRight momenta normal to the edges of the right (top) cells.
+		 * @param in_bathymetryLeft bathymetry of the left (bottom) cells.
+		 * @param in_bathymetryRight bathymetry of the right (top) cells.
+		 * @param in_classes dry cells of the patch.
+		 * @param in_rowLeft row of the left (bottom) cells in in_classes.
+		 * @param in_cellLeft left (bottom) cell of the first edge in in_classes.
+		 * @param in_rowRight row of the right (top) cells in in_classes.
+		 * @param in_cellRight right (top) cell of the first edge in in_classes.
+		 * @param in_cellsLeft cached row of the left (bottom) cells; nullptr if the cell cache is not used.
+		 * @param in_offsetLeft position of the left (bottom) cell of the first edge in in_cellsLeft.
+		 * @param in_cellsRight cached row of the right (top) cells; nullptr if the cell cache is not used.
+		 * @param in_offsetRight position of the right (top) cell of the first edge in in_cellsRight.
+		 * @param in_waveSpeedMax maximum wave speed of the edges solved before.
+		 * @return maximum of in_waveSpeedMax and the wave speeds of the solved edges.
+		 *
+		 * @tparam t_solver Riemann solver.
+		 **/
+		template< typename t_solver >
+		real solveClassified( idx in_count,
+		                      real const * in_heightLeft,
+		                      real const * in_heightRight,
+		                      real const * in_momentumLeft,
+		                      real const * in_momentumRight,
+		                      real const * in_bathymetryLeft,
+		                      real const * in_bathymetryRight,
+		                      EdgeClasses const & in_classes,
+		                      idx in_rowLeft,
+		                      idx in_cellLeft,
+		                      idx in_rowRight,
+		                      idx in_cellRight,
+		                      CellRow const * in_cellsLeft,
+		                      idx in_offsetLeft,
+		                      CellRow const * in_cellsRight,
+		                      idx in_offsetRight,
+		                      real in_waveSpeedMax ) {
+			instrumentation::ScopedTimer timer( instrumentation::Profiler::SOLVER );
+
+			real * nuLH = netUpdateLeftHeight.data();
+			real * nuLHu = netUpdateLeftMomentum.data();
+			real * nuRH = netUpdateRightHeight.data();
+			real * nuRHu = netUpdateRightMomentum.data();
+			real * speed = waveSpeed.data();
+
+			idx first = 0;
+			while( first < in_count ) {
+				EdgeClasses::Class edgeClass;
+				idx length = in_classes.getRun( in_rowLeft, in_cellLeft, in_rowRight, in_cellRight, first, in_count, edgeClass );
+
+				if( edgeClass == EdgeClasses::WET && in_cellsLeft != nullptr ) {
+					t_solver::netUpdatesBatchCached( length,
+					                                 in_heightLeft + first, in_heightRight + first,
+					                                 in_momentumLeft + first, in_momentumRight + first,
+					                                 in_bathymetryLeft + first, in_bathymetryRight + first,
+					                                 in_cellsLeft->sqrtHeight.data() + in_offsetLeft + first, in_cellsRight->sqrtHeight.data() + in_offsetRight + first,
+					                                 in_cellsLeft->velocity.data() + in_offsetLeft + first, in_cellsRight->velocity.data() + in_offsetRight + first,
+					                                 in_cellsLeft->flux.data() + in_offsetLeft + first, in_cellsRight->flux.data() + in_offsetRight + first,
+					                                 nuLH + first, nuLHu + first,
+					                                 nuRH + first, nuRHu + first,
+					                                 speed + first );
+					solvedCount += length;
+				}
+				else if( edgeClass == EdgeClasses::WET ) {
+					t_solver::netUpdatesBatch( length,
+					                           in_heightLeft + first, in_heightRight + first,
+					                           in_momentumLeft + first, in_momentumRight + first,
+					                           in_bathymetryLeft + first, in_bathymetryRight + first,
+					                           nuLH + first, nuLHu + first,
+					                           nuRH + first, nuRHu + first,
+					                           speed + first );
+					solvedCount += length;
+				}
+				else if( edgeClass == EdgeClasses::WALL_RIGHT ) {
+					t_solver::wallNetUpdatesBatch( length, in_heightLeft + first, in_momentumLeft + first, false, nuLH + first, nuLHu + first, speed + first );
+					std::fill( nuRH + first, nuRH + first + length, real(0) );
+					std::fill( nuRHu + first, nuRHu + first + length, real(0) );
+					solvedCount += length;
+					wallCount += length;
+				}
+				else if( edgeClass == EdgeClasses::WALL_LEFT ) {
+					t_solver::wallNetUpdatesBatch( length, in_heightRight + first, in_momentumRight + first, true, nuRH + first, nuRHu + first, speed + first );
+					std::fill( nuLH + first, nuLH + first + length, real(0) );
+					std::fill( nuLHu + first, nuLHu + first + length, real(0) );
+					solvedCount += length;
+					wallCount += length;
+				}
+				else {
+					// the dry cells keep their values
+					real * buffers[5] = { nuLH, nuLHu, nuRH, nuRHu, speed };
+					for( unsigned short buffer = 0; buffer < 5; buffer++ ) {
+						std::fill( buffers[buffer] + first, buffers[buffer] + first + length, real(0) );
+					}
+					skippedCount += length;
+				}
+
+				first += length;
+			}
+
+			for( idx edge = 0; edge < in_count; edge++ ) {
+				in_waveSpeedMax = std::max( in_waveSpeedMax, speed[edge] );
+			}
+			return in_waveSpeedMax;
+		}
+};
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the edge buffers of the patches.
+ **/
+#include <catch2/catch.hpp>
+#include "EdgeBatch.h"
+#include "../solvers/FWave.h"
+#include "../solvers/Roe.h"
+
+TEST_CASE( "Test the gather of the edge buffers with dry cells.", "[EdgeBatchGather]" ) {
+  // cells: wet, wet, dry, wet, dry, dry
+  tsunami_lab::real height[6]     = { 10,  8,  0,  6,  0,  0 };
+  tsunami_lab::real momentum[6]   = {  1,  2,  3,  4,  5,  6 };
+  tsunami_lab::real bathymetry[6] = { -5, -4,  2, -3,  1,  3 };
+
+  tsunami_lab::patches::EdgeBatch edges( 5 );
+  REQUIRE( edges.gather( 5, height, height+1, momentum, momentum+1, bathymetry, bathymetry+1 ) == 4 );
+
+  // wet-wet
+  REQUIRE( edges.heightLeft[0] == 10 );
+  REQUIRE( edges.heightRight[0] == 8 );
+  REQUIRE( edges.momentumLeft[0] == 1 );
+  REQUIRE( edges.momentumRight[0] == 2 );
+  REQUIRE( edges.bathymetryLeft[0] == -5 );
+  REQUIRE( edges.bathymetryRight[0] == -4 );
+
+  // wet-dry: the right side mirrors the left one
+  REQUIRE( edges.heightRight[1] == 8 );
+  REQUIRE( edges.momentumRight[1] == -2 );
+  REQUIRE( edges.bathymetryRight[1] == -4 );
+
+  // dry-wet: the left side mirrors the right one
+  REQUIRE( edges.heightLeft[2] == 6 );
+  REQUIRE( edges.momentumLeft[2] == -4 );
+  REQUIRE( edges.bathymetryLeft[2] == -3 );
+  REQUIRE( edges.heightRight[2] == 6 );
+  REQUIRE( edges.momentumRight[2] == 4 );
+
+  // dry-dry: the left side mirrors the right one, which then mirrors the new left side
+  REQUIRE( edges.heightLeft[4] == 0 );
+  REQUIRE( edges.momentumLeft[4] == -6 );
+  REQUIRE( edges.bathymetryLeft[4] == 3 );
+  REQUIRE( edges.heightRight[4] == 0 );
+  REQUIRE( edges.momentumRight[4] == 6 );
+  REQUIRE( edges.bathymetryRight[4] == 3 );
+
+  // the wet edges match the scalar solver
+  tsunami_lab::real speedMax = edges.solve< tsunami_lab::solvers::FWave >( 3, 0 );
+
+  tsunami_lab::real netUpdates[2][2];
+  tsunami_lab::real speed;
+  tsunami_lab::solvers::FWave::netUpdates( 10, 8, 1, 2, -5, -4, netUpdates[0], netUpdates[1], speed );
+  REQUIRE( edges.netUpdateLeftHeight[0] == Approx( netUpdates[0][0] ) );
+  REQUIRE( edges.netUpdateLeftMomentum[0] == Approx( netUpdates[0][1] ) );
+  REQUIRE( edges.netUpdateRightHeight[0] == Approx( netUpdates[1][0] ) );
+  REQUIRE( edges.netUpdateRightMomentum[0] == Approx( netUpdates[1][1] ) );
+  REQUIRE( edges.waveSpeed[0] == Approx( speed ) );
+
+  // reflecting wall: equal heights and opposite momenta
+  tsunami_lab::solvers::FWave::netUpdates( 8, 8, 2, -2, -4, -4, netUpdates[0], netUpdates[1], speed );
+  REQUIRE( edges.netUpdateLeftHeight[1] == Approx( netUpdates[0][0] ) );
+  REQUIRE( edges.netUpdateRightMomentum[1] == Approx( netUpdates[1][1] ) );
+
+  REQUIRE( speedMax == std::max( edges.waveSpeed[0], std::max( edges.waveSpeed[1], edges.waveSpeed[2] ) ) );
+}
+
+TEST_CASE( "Test the cached gather of the edge buffers with dry cells.", "[EdgeBatchGatherCached]" ) {
+  // cells: wet, wet, dry, wet, dry, wet
+  tsunami_lab::real height[6]     = { 10,  8,  0,  6,  0,  4 };
+  tsunami_lab::real momentum[6]   = {  1,  2,  3, -4,  5,  6 };
+  tsunami_lab::real bathymetry[6] = { -5, -4,  2, -3,  1, -2 };
+
+  tsunami_lab::patches::EdgeBatch edges( 5 );
+  tsunami_lab::patches::EdgeBatch edgesCached( 5, true );
+  REQUIRE( edges.cellRows[0].sqrtHeight.size() == 0 );
+  REQUIRE( edgesCached.cellRows[1].flux.size() == 6 );
+
+  edges.gather( 5, height, height+1, momentum, momentum+1, bathymetry, bathymetry+1 );
+  tsunami_lab::real speedMax = edges.solve< tsunami_lab::solvers::FWave >( 5, 0 );
+
+  tsunami_lab::patches::EdgeBatch::CellRow & cells = edgesCached.cellRows[0];
+  edgesCached.computeCells< tsunami_lab::solvers::FWave >( cells, 6, height, momentum );
+  edgesCached.gatherCached( 5, height, height+1, momentum, momentum+1, bathymetry, bathymetry+1, cells, 0, cells, 1 );
+  REQUIRE( edgesCached.cachedLeft.sqrtHeight == edgesCached.sqrtHeightLeft.data() );
+
+  // dry-wet: the left side mirrors the right one
+  REQUIRE( edgesCached.sqrtHeightLeft[2] == std::sqrt( tsunami_lab::realCompute( 6 ) ) );
+  REQUIRE( edgesCached.velocityLeft[2] == tsunami_lab::realCompute( 4 ) / 6 );
+  REQUIRE( edgesCached.velocityRight[2] == tsunami_lab::realCompute( -4 ) / 6 );
+  REQUIRE( edgesCached.fluxLeft[2] == edgesCached.fluxRight[2] );
+
+  // wet-dry: the right side mirrors the left one
+  REQUIRE( edgesCached.sqrtHeightRight[3] == edgesCached.sqrtHeightLeft[3] );
+  REQUIRE( edgesCached.velocityRight[3] == -edgesCached.velocityLeft[3] );
+
+  // the cached solver is bitwise identical
+  REQUIRE( edgesCached.solveCached< tsunami_lab::solvers::FWave >( 5, 0 ) == speedMax );
+  for( tsunami_lab::idx edge = 0; edge < 5; edge++ ) {
+    REQUIRE( edgesCached.heightLeft[edge] == edges.heightLeft[edge] );
+    REQUIRE( edgesCached.netUpdateLeftHeight[edge] == edges.netUpdateLeftHeight[edge] );
+    REQUIRE( edgesCached.netUpdateLeftMomentum[edge] == edges.netUpdateLeftMomentum[edge] );
+    REQUIRE( edgesCached.netUpdateRightHeight[edge] == edges.netUpdateRightHeight[edge] );
+    REQUIRE( edgesCached.netUpdateRightMomentum[edge] == edges.netUpdateRightMomentum[edge] );
+    REQUIRE( edgesCached.waveSpeed[edge] == edges.waveSpeed[edge] );
+  }
+  REQUIRE( edgesCached.solvedCount == 5 );
+
+  // without dry cells, the solver reads the cached row of cells
+  edgesCached.gatherCached( 1, height, height+1, momentum, momentum+1, bathymetry, bathymetry+1, cells, 0, cells, 1 );
+  REQUIRE( edgesCached.cachedLeft.velocity == cells.velocity.data() );
+  REQUIRE( edgesCached.cachedRight.flux == cells.flux.data() + 1 );
+}
+
+/**
+ * Compares the edges solved by their classes to the gathered edges.
+ *
+ * @param in_cellCache true if the cached cell quantities are passed to the solver.
+ *
+ * @tparam t_solver Riemann solver.
+ **/
+template< typename t_solver >
+static void testSolveClassified( bool in_cellCache ) {
+  // cells: wet, wet, dry, wet, dry, dry, wet, wet
+  tsunami_lab::real height[8]     = { 10,  8,  0,  6,  0,  0,  4,  3 };
+  tsunami_lab::real momentum[8]   = {  1,  2,  0, -4,  0,  0,  6, -1 };
+  tsunami_lab::real bathymetry[8] = { -5, -4,  2, -3,  1,  3, -2, -1 };
+
+  tsunami_lab::patches::EdgeClasses classes( 8, 1 );
+  classes.setRow( 0, 8, bathymetry );
+
+  tsunami_lab::patches::EdgeBatch edges( 7 );
+  edges.gather( 7, height, height+1, momentum, momentum+1, bathymetry, bathymetry+1 );
+  tsunami_lab::real speedMax = edges.solve< t_solver >( 7, 0 );
+
+  tsunami_lab::patches::EdgeBatch edgesClassified( 7, in_cellCache );
+  tsunami_lab::patches::EdgeBatch::CellRow * cells = nullptr;
+  if( in_cellCache ) {
+    cells = &edgesClassified.cellRows[0];
+    edgesClassified.computeCells< t_solver >( *cells, 8, height, momentum );
+  }
+  REQUIRE( edgesClassified.solveClassified< t_solver >( 7,
+                                                        height, height+1,
+                                                        momentum, momentum+1,
+                                                        bathymetry, bathymetry+1,
+                                                        classes,
+                                                        0, 0,
+                                                        0, 1,
+                                                        cells, 0,
+                                                        cells, 1,
+                                                        0 ) == speedMax );
+
+  // the wet sides are bitwise identical, the dry ones receive no updates
+  for( tsunami_lab::idx edge = 0; edge < 7; edge++ ) {
+    bool dryLeft = bathymetry[edge] > 0;
+    bool dryRight = bathymetry[edge+1] > 0;
+
+    if( dryLeft ) {
+      REQUIRE( edgesClassified.netUpdateLeftHeight[edge] == 0 );
+      REQUIRE( edgesClassified.netUpdateLeftMomentum[edge] == 0 );
+    }
+    else {
+      REQUIRE( edgesClassified.netUpdateLeftHeight[edge] == edges.netUpdateLeftHeight[edge] );
+      REQUIRE( edgesClassified.netUpdateLeftMomentum[edge] == edges.netUpdateLeftMomentum[edge] );
+    }
+
+    if( dryRight ) {
+      REQUIRE( edgesClassified.netUpdateRightHeight[edge] == 0 );
+      REQUIRE( edgesClassified.netUpdateRightMomentum[edge] == 0 );
+    }
+    else {
+      REQUIRE( edgesClassified.netUpdateRightHeight[edge] == edges.netUpdateRightHeight[edge] );
+      REQUIRE( edgesClassified.netUpdateRightMomentum[edge] == edges.netUpdateRightMomentum[edge] );
+    }
+
+    if( !dryLeft || !dryRight ) {
+      REQUIRE( edgesClassified.waveSpeed[edge] == edges.waveSpeed[edge] );
+    }
+  }
+
+  // wet-wet: 0, 6; walls: 1, 2, 3, 5 (right cell dry: 1, 3); dry-dry: 4
+  REQUIRE( edgesClassified.solvedCount == 6 );
+  REQUIRE( edgesClassified.wallCount == 4 );
+  REQUIRE( edgesClassified.skippedCount == 1 );
+}
+
+TEST_CASE( "Test the edge buffers solved by the classes of the edges.", "[EdgeBatchSolveClassified]" ) {
+  testSolveClassified< tsunami_lab::solvers::FWave >( false );
+  testSolveClassified< tsunami_lab::solvers::FWave >( true );
+  testSolveClassified< tsunami_lab::solvers::Roe >( false );
+  testSolveClassified< tsunami_lab::solvers::Roe >( true );
+}
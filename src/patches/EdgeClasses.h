@@ -0,0 +1,178 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Classes of the edges (wet, wall, dry) derived from the static bathymetry.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_EDGE_CLASSES
+#define TSUNAMI_LAB_PATCHES_EDGE_CLASSES
+
+#include "../constants.h"
+#include <cstdint>
+#include <vector>
+
+namespace tsunami_lab {
+	namespace patches {
+		class EdgeClasses;
+	}
+}
+
+/**
+ * @brief Bitmask of the dry cells (bathymetry > 0) of a grid, which classifies the edges between the cells.
+ *
+ * The class of an edge consists of two bits, whether its left (bottom) and whether its right (top) cell is dry.
+ * Both bits are stored once per cell, i.e., a bit of the mask belongs to the edges on all sides of the cell.
+ * A row of edges is traversed in runs of the same class, which are found 64 edges at a time.
+ **/
+class tsunami_lab::patches::EdgeClasses {
+	public:
+		//! class of an edge: bit 1 is set if the left (bottom) cell is dry, bit 0 if the right (top) cell is dry
+		enum Class {
+			WET = 0,
+			WALL_RIGHT = 1,
+			WALL_LEFT = 2,
+			DRY = 3
+		};
+
+	private:
+		//! number of 64-bit words of a row; one more than required, such that a window of 64 bits may start at every cell
+		idx wordCount = 0;
+
+		//! dry bits of the rows of cells
+		std::vector< std::uint64_t > dry;
+
+		/**
+		 * @brief Gets 64 dry bits of a row.
+		 *
+		 * @param in_row id of the row.
+		 * @param in_cell first cell of the window.
+		 * @return dry bits of the cells [in_cell, in_cell + 64) in the bits [0, 64).
+		 **/
+		std::uint64_t window( idx in_row,
+		                      idx in_cell ) const {
+			std::uint64_t const * words = dry.data() + in_row * wordCount + in_cell / 64;
+			unsigned short shift = in_cell % 64;
+			return shift == 0 ? words[0] : ( words[0] >> shift ) | ( words[1] << (64 - shift) );
+		}
+
+	public:
+		/**
+		 * @brief Allocates the bitmask; all cells are wet.
+		 *
+		 * @param in_cellCount number of cells of a row.
+		 * @param in_rowCount number of rows.
+		 **/
+		explicit EdgeClasses( idx in_cellCount = 0,
+		                      idx in_rowCount = 0 ) {
+			resize( in_cellCount, in_rowCount );
+		}
+
+		/**
+		 * @brief Resizes the bitmask; all cells are wet.
+		 *
+		 * @param in_cellCount number of cells of a row.
+		 * @param in_rowCount number of rows.
+		 **/
+		void resize( idx in_cellCount,
+		             idx in_rowCount ) {
+			wordCount = in_cellCount / 64 + 2;
+			dry.assign( wordCount * in_rowCount, 0 );
+		}
+
+		/**
+		 * @brief Sets the dry bits of a row of cells from the bathymetry.
+		 *
+		 * @param in_row id of the row.
+		 * @param in_cellCount number of cells of the row.
+		 * @param in_bathymetry bathymetry of the cells.
+		 **/
+		void setRow( idx in_row,
+		             idx in_cellCount,
+		             real const * in_bathymetry ) {
+			std::uint64_t * words = dry.data() + in_row * wordCount;
+			for( idx word = 0; word < wordCount; word++ ) {
+				std::uint64_t bits = 0;
+				for( idx bit = 0; bit < 64 && word * 64 + bit < in_cellCount; bit++ ) {
+					bits |= std::uint64_t( in_bathymetry[word * 64 + bit] > 0 ) << bit;
+				}
+				words[word] = bits;
+			}
+		}
+
+		/**
+		 * @brief Sets the dry bit of a single cell from its bathymetry.
+		 *
+		 * @param in_row id of the row.
+		 * @param in_cell id of the cell in the row.
+		 * @param in_bathymetry bathymetry of the cell.
+		 **/
+		void setCell( idx in_row,
+		              idx in_cell,
+		              real in_bathymetry ) {
+			std::uint64_t & word = dry[in_row * wordCount + in_cell / 64];
+			std::uint64_t bit = std::uint64_t(1) << (in_cell % 64);
+			word = in_bathymetry > 0 ? word | bit : word & ~bit;
+		}
+
+		/**
+		 * @brief Gets the class of an edge.
+		 *
+		 * @param in_rowLeft row of the left (bottom) cell.
+		 * @param in_cellLeft id of the left (bottom) cell in its row.
+		 * @param in_rowRight row of the right (top) cell.
+		 * @param in_cellRight id of the right (top) cell in its row.
+		 * @return class of the edge.
+		 **/
+		Class getClass( idx in_rowLeft,
+		                idx in_cellLeft,
+		                idx in_rowRight,
+		                idx in_cellRight ) const {
+			return Class( 2 * ( window( in_rowLeft, in_cellLeft ) & 1 ) + ( window( in_rowRight, in_cellRight ) & 1 ) );
+		}
+
+		/**
+		 * @brief Gets the run of edges of the same class which starts at an edge of a row.
+		 *
+		 * Edge i of the row is located between the cells in_cellLeft + i of the row in_rowLeft and in_cellRight + i of the row in_rowRight,
+		 * i.e., in_cellRight = in_cellLeft + 1 and in_rowLeft = in_rowRight for the edges in x-direction,
+		 * in_cellLeft = in_cellRight and in_rowRight = in_rowLeft + 1 for the edges in y-direction.
+		 *
+		 * @param in_rowLeft row of the left (bottom) cells.
+		 * @param in_cellLeft left (bottom) cell of the first edge of the row.
+		 * @param in_rowRight row of the right (top) cells.
+		 * @param in_cellRight right (top) cell of the first edge of the row.
+		 * @param in_first first edge of the run.
+		 * @param in_count number of edges of the row.
+		 * @param out_class class of the edges of the run.
+		 * @return number of edges of the run.
+		 **/
+		idx getRun( idx in_rowLeft,
+		            idx in_cellLeft,
+		            idx in_rowRight,
+		            idx in_cellRight,
+		            idx in_first,
+		            idx in_count,
+		            Class & out_class ) const {
+			out_class = getClass( in_rowLeft, in_cellLeft + in_first, in_rowRight, in_cellRight + in_first );
+
+			// bits which differ from the class of the run
+			std::uint64_t flipLeft = ( out_class & WALL_LEFT ) ? ~std::uint64_t(0) : 0;
+			std::uint64_t flipRight = ( out_class & WALL_RIGHT ) ? ~std::uint64_t(0) : 0;
+
+			idx edge = in_first;
+			while( edge < in_count ) {
+				std::uint64_t other = ( window( in_rowLeft, in_cellLeft + edge ) ^ flipLeft ) |
+				                      ( window( in_rowRight, in_cellRight + edge ) ^ flipRight );
+				if( other != 0 ) {
+					edge += __builtin_ctzll( other );
+					break;
+				}
+				edge += 64;
+			}
+
+			return ( edge < in_count ? edge : in_count ) - in_first;
+		}
+};
+
+#endif
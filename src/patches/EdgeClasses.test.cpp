@@ -0,0 +1,71 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the classes of the edges.
+ **/
+#include <catch2/catch.hpp>
+#include "EdgeClasses.h"
+#include <vector>
+
+TEST_CASE( "Test the classes of the edges.", "[EdgeClasses]" ) {
+  // two rows of 150 cells, such that the runs cross the words of the bitmask
+  std::vector< tsunami_lab::real > bathymetry( 300, -10 );
+  for( std::size_t cell = 60; cell < 140; cell++ ) bathymetry[cell] = 5;
+  bathymetry[145] = 0;
+  bathymetry[146] = 1;
+  for( std::size_t cell = 150 + 100; cell < 300; cell++ ) bathymetry[cell] = 2;
+
+  tsunami_lab::patches::EdgeClasses classes( 150, 2 );
+  classes.setRow( 0, 150, bathymetry.data() );
+  classes.setRow( 1, 150, bathymetry.data() + 150 );
+
+  // single edges in x- and y-direction; a bathymetry of 0 is wet
+  REQUIRE( classes.getClass( 0, 58, 0, 59 ) == tsunami_lab::patches::EdgeClasses::WET );
+  REQUIRE( classes.getClass( 0, 59, 0, 60 ) == tsunami_lab::patches::EdgeClasses::WALL_RIGHT );
+  REQUIRE( classes.getClass( 0, 60, 0, 61 ) == tsunami_lab::patches::EdgeClasses::DRY );
+  REQUIRE( classes.getClass( 0, 139, 0, 140 ) == tsunami_lab::patches::EdgeClasses::WALL_LEFT );
+  REQUIRE( classes.getClass( 0, 144, 0, 145 ) == tsunami_lab::patches::EdgeClasses::WET );
+  REQUIRE( classes.getClass( 0, 145, 0, 146 ) == tsunami_lab::patches::EdgeClasses::WALL_RIGHT );
+  REQUIRE( classes.getClass( 0, 80, 1, 80 ) == tsunami_lab::patches::EdgeClasses::WALL_LEFT );
+  REQUIRE( classes.getClass( 0, 20, 1, 120 ) == tsunami_lab::patches::EdgeClasses::WALL_RIGHT );
+
+  // runs of the x-edges of the first row: edge i is located between the cells i and i+1
+  tsunami_lab::idx runs[7][2] = { { tsunami_lab::patches::EdgeClasses::WET, 59 },
+                                  { tsunami_lab::patches::EdgeClasses::WALL_RIGHT, 1 },
+                                  { tsunami_lab::patches::EdgeClasses::DRY, 79 },
+                                  { tsunami_lab::patches::EdgeClasses::WALL_LEFT, 1 },
+                                  { tsunami_lab::patches::EdgeClasses::WET, 5 },
+                                  { tsunami_lab::patches::EdgeClasses::WALL_RIGHT, 1 },
+                                  { tsunami_lab::patches::EdgeClasses::WALL_LEFT, 1 } };
+  tsunami_lab::idx first = 0;
+  for( unsigned short run = 0; run < 7; run++ ) {
+    tsunami_lab::patches::EdgeClasses::Class edgeClass;
+    tsunami_lab::idx length = classes.getRun( 0, 0, 0, 1, first, 149, edgeClass );
+    REQUIRE( edgeClass == tsunami_lab::patches::EdgeClasses::Class( runs[run][0] ) );
+    REQUIRE( length == runs[run][1] );
+    first += length;
+  }
+
+  // the last run ends at the end of the row
+  tsunami_lab::patches::EdgeClasses::Class edgeClass;
+  REQUIRE( classes.getRun( 0, 0, 0, 1, first, 149, edgeClass ) == 2 );
+  REQUIRE( edgeClass == tsunami_lab::patches::EdgeClasses::WET );
+
+  // y-edges between the rows, starting in the middle of the rows
+  REQUIRE( classes.getRun( 0, 10, 1, 10, 0, 140, edgeClass ) == 50 );
+  REQUIRE( edgeClass == tsunami_lab::patches::EdgeClasses::WET );
+  REQUIRE( classes.getRun( 0, 10, 1, 10, 50, 140, edgeClass ) == 40 );
+  REQUIRE( edgeClass == tsunami_lab::patches::EdgeClasses::WALL_LEFT );
+  REQUIRE( classes.getRun( 0, 10, 1, 10, 90, 140, edgeClass ) == 40 );
+  REQUIRE( edgeClass == tsunami_lab::patches::EdgeClasses::DRY );
+
+  // single cells
+  classes.setCell( 0, 100, -1 );
+  classes.setCell( 0, 0, 3 );
+  REQUIRE( classes.getClass( 0, 99, 0, 100 ) == tsunami_lab::patches::EdgeClasses::WALL_LEFT );
+  REQUIRE( classes.getClass( 0, 100, 0, 101 ) == tsunami_lab::patches::EdgeClasses::WALL_RIGHT );
+  REQUIRE( classes.getClass( 0, 0, 0, 1 ) == tsunami_lab::patches::EdgeClasses::WALL_LEFT );
+  REQUIRE( classes.getRun( 0, 0, 0, 1, 1, 149, edgeClass ) == 58 );
+}
@@ -0,0 +1,42 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Contiguous two-dimensional grid including a single layer of ghost cells.
+ **/
+#include "Grid2d.h"
+#include <cstdint>
+
+using namespace tsunami_lab::patches;
+
+Grid2d::Grid2d( idx in_cellCountX, idx in_cellCountY ) {
+	cellCountX = in_cellCountX;
+	cellCountY = in_cellCountY;
+
+	// pad the stride (including the ghost cells) to a multiple of the alignment
+	idx valuesPerAlignment = alignment / sizeof(real);
+	stride = ( (cellCountX + 2 + valuesPerAlignment - 1) / valuesPerAlignment ) * valuesPerAlignment;
+
+	// single allocation with enough slack to align the first row
+	idx size = stride * (cellCountY + 2);
+	memory = new real[ size + valuesPerAlignment ];
+
+	std::uintptr_t address = reinterpret_cast< std::uintptr_t >( memory );
+	std::uintptr_t offset = (alignment - address % alignment) % alignment;
+	data = memory + offset / sizeof(real);
+
+	// init to zero; the rows are distributed as the row bands of tiles in the time step, such that the first touch places
+	// the pages of a thread's tiles on its NUMA node
+#pragma omp parallel for schedule(static)
+	for( idx row = 0; row < cellCountY + 2; row++ ) {
+		real * rowData = data + row * stride;
+		for( idx cell = 0; cell < stride; cell++ ) {
+			rowData[cell] = 0;
+		}
+	}
+}
+
+Grid2d::~Grid2d() {
+	delete[] memory;
+}
@@ -0,0 +1,124 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Contiguous two-dimensional grid including a single layer of ghost cells.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_GRID_2D
+#define TSUNAMI_LAB_PATCHES_GRID_2D
+
+#include "../../constants.h"
+
+namespace tsunami_lab {
+	namespace patches {
+		class Grid2d;
+	}
+}
+
+/**
+ * @brief Row-major grid which stores all cells (including ghost cells) in a single aligned allocation.
+ *
+ * Cell (x, y) with x in [0, cellCountX+1] and y in [0, cellCountY+1] is located at y * stride + x,
+ * where x = 0, x = cellCountX+1, y = 0 and y = cellCountY+1 are ghost cells.
+ * The stride is padded such that every row starts at an aligned address.
+ **/
+class tsunami_lab::patches::Grid2d {
+	public:
+		//! alignment of the rows in bytes
+		static idx constexpr alignment = 64;
+
+	private:
+		//! number of cells in x-direction (without ghost cells)
+		idx cellCountX = 0;
+
+		//! number of cells in y-direction (without ghost cells)
+		idx cellCountY = 0;
+
+		//! distance of two consecutive rows in number of values
+		idx stride = 0;
+
+		//! raw allocation (not aligned)
+		real * memory = nullptr;
+
+		//! aligned pointer to cell (0, 0)
+		real * data = nullptr;
+
+	public:
+		/**
+		 * @brief Allocates the grid and initializes all values (including ghost cells) to zero.
+		 *
+		 * @param in_cellCountX number of cells in x-direction (without ghost cells).
+		 * @param in_cellCountY number of cells in y-direction (without ghost cells).
+		 **/
+		Grid2d( idx in_cellCountX, idx in_cellCountY );
+
+		/**
+		 * @brief Destructor which frees all allocated memory.
+		 **/
+		~Grid2d();
+
+		Grid2d( Grid2d const & ) = delete;
+		Grid2d & operator=( Grid2d const & ) = delete;
+
+		/**
+		 * @brief Gets the stride in y-direction. x-direction is stride-1.
+		 *
+		 * @return stride in y-direction.
+		 **/
+		idx getStride() const {
+			return stride;
+		}
+
+		/**
+		 * @brief Gets a pointer to the first ghost cell (0, 0).
+		 *
+		 * @return pointer to cell (0, 0).
+		 **/
+		real * getData() {
+			return data;
+		}
+
+		/**
+		 * @brief Gets a pointer to the first ghost cell (0, 0).
+		 *
+		 * @return pointer to cell (0, 0).
+		 **/
+		real const * getData() const {
+			return data;
+		}
+
+		/**
+		 * @brief Gets a pointer to the first cell (ghost cell) of a row.
+		 *
+		 * @param in_y id of the row; 0 and cellCountY+1 are ghost rows.
+		 * @return pointer to cell (0, in_y).
+		 **/
+		real * getRow( idx in_y ) {
+			return data + in_y * stride;
+		}
+
+		/**
+		 * @brief Accesses a cell; ids include the ghost cells.
+		 *
+		 * @param in_x id of the cell in x-direction; 0 and cellCountX+1 are ghost cells.
+		 * @param in_y id of the cell in y-direction; 0 and cellCountY+1 are ghost cells.
+		 * @return reference to the value of the cell.
+		 **/
+		real & operator()( idx in_x, idx in_y ) {
+			return data[ in_y * stride + in_x ];
+		}
+
+		/**
+		 * @brief Accesses a cell; ids include the ghost cells.
+		 *
+		 * @param in_x id of the cell in x-direction; 0 and cellCountX+1 are ghost cells.
+		 * @param in_y id of the cell in y-direction; 0 and cellCountY+1 are ghost cells.
+		 * @return value of the cell.
+		 **/
+		real operator()( idx in_x, idx in_y ) const {
+			return data[ in_y * stride + in_x ];
+		}
+};
+
+#endif
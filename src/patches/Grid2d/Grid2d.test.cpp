@@ -0,0 +1,36 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the contiguous two-dimensional grid.
+ **/
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include "Grid2d.h"
+
+TEST_CASE( "Test the layout of the 2d grid.", "[Grid2d]" ) {
+  tsunami_lab::patches::Grid2d grid( 5, 3 );
+
+  // stride covers both ghost cells and keeps every row aligned
+  REQUIRE( grid.getStride() >= 5 + 2 );
+  REQUIRE( (grid.getStride() * sizeof(tsunami_lab::real)) % tsunami_lab::patches::Grid2d::alignment == 0 );
+
+  for( tsunami_lab::idx y = 0; y < 3 + 2; y++ ) {
+    std::uintptr_t address = reinterpret_cast< std::uintptr_t >( grid.getRow( y ) );
+    REQUIRE( address % tsunami_lab::patches::Grid2d::alignment == 0 );
+  }
+
+  // all cells including the ghost cells are initialized to zero
+  for( tsunami_lab::idx y = 0; y < 3 + 2; y++ ) {
+    for( tsunami_lab::idx x = 0; x < 5 + 2; x++ ) {
+      REQUIRE( grid( x, y ) == 0 );
+    }
+  }
+
+  // row-major indexing
+  grid( 6, 4 ) = 3;
+  grid( 1, 2 ) = 7;
+  REQUIRE( grid.getData()[ 4 * grid.getStride() + 6 ] == 3 );
+  REQUIRE( grid.getRow( 2 )[1] == 7 );
+}
@@ -29,7 +29,7 @@ class tsunami_lab::patches::WavePropagation {
      *
      * @param in_scaling scaling of the time step.
      **/
-    virtual void timeStep( real in_scaling, Solver in_solver ) = 0; 
+    virtual void timeStep( real in_scaling ) = 0;
 
 	 /**
 	  * @brief Sets the values of the ghost cells according to outflow boundary conditions.
@@ -38,6 +38,74 @@ class tsunami_lab::patches::WavePropagation {
 	  */
     virtual void setGhostOutflow(Boundary in_boundary[2]) = 0;
 
+    /**
+     * @brief Gets the maximum wave speed observed in the last time step.
+     *
+     * The speeds are a by-product of the Riemann solvers, i.e., they are derived from the values before the time step.
+     *
+     * @return maximum absolute wave speed; 0 before the first time step.
+     **/
+    virtual real getWaveSpeedMax() = 0;
+
+    /**
+     * @brief Gets the number of dimensions of the patch.
+     *
+     * A 1d patch holds a single row of cells and ignores the y-ids of the setters.
+     *
+     * @return 1 or 2.
+     **/
+    virtual unsigned short getDimensions() = 0;
+
+    /**
+     * @brief Enables or disables the cache of the cell quantities shared by the edges of a cell.
+     *
+     * If enabled, the square roots of the heights, the particle velocities and the fluxes are computed once per cell and sweep
+     * instead of once per side of an edge. The results do not change.
+     *
+     * @param in_cellCache true to enable the cache.
+     **/
+    virtual void setCellCache( bool in_cellCache ) = 0;
+
+    /**
+     * @brief Enables or disables the precomputed classes of the edges (wet, wall, dry), which are derived from the bathymetry.
+     *
+     * If enabled, the edges between two dry cells are skipped and the edges with a single dry cell are solved as reflecting walls in closed form.
+     * The results of the wet cells do not change.
+     *
+     * @param in_edgeClasses true to enable the classes.
+     **/
+    virtual void setEdgeClasses( bool in_edgeClasses ) = 0;
+
+    /**
+     * @brief Gets the fraction of the edges of the last time step which were skipped since both of their cells are dry.
+     *
+     * @return fraction of the skipped edges.
+     **/
+    virtual real getSkippedFraction() = 0;
+
+    /**
+     * @brief Enables or disables the tracking of the active regions, which skips the regions at rest.
+     *
+     * The default implementation ignores the tracking, i.e., all cells are solved in every time step.
+     *
+     * @param in_activity true to enable the tracking.
+     * @param in_threshold largest change of a cell's height or momenta in a time step at which the cell is considered at rest.
+     **/
+    virtual void setActivity( bool in_activity,
+                              real in_threshold ) {
+      (void) in_activity;
+      (void) in_threshold;
+    }
+
+    /**
+     * @brief Gets the fraction of the patch which was solved in the last time step.
+     *
+     * @return active fraction; 1 if all cells are solved.
+     **/
+    virtual real getActiveFraction() {
+      return 1;
+    }
+
     /**
      * @brief Gets the stride in y-direction. x-direction is stride-1.
      *
@@ -116,6 +184,41 @@ class tsunami_lab::patches::WavePropagation {
 	 virtual void setBathymetry( idx in_x,
 	 									  idx in_y,
 										  real in_bathymetry ) = 0;
+
+    /**
+     * @brief Sets the values of a rectangular region of cells.
+     *
+     * The default implementation calls the setters of the cells. Different regions may be set concurrently.
+     *
+     * @param in_x id of the first cell in x-direction.
+     * @param in_y id of the first cell in y-direction.
+     * @param in_countX number of cells in x-direction.
+     * @param in_countY number of cells in y-direction.
+     * @param in_stride stride of the input arrays in y-direction (x is assumed to be stride-1).
+     * @param in_height water heights.
+     * @param in_momentumX momenta in x-direction.
+     * @param in_momentumY momenta in y-direction.
+     * @param in_bathymetry bathymetry.
+     **/
+    virtual void setValues( idx          in_x,
+                            idx          in_y,
+                            idx          in_countX,
+                            idx          in_countY,
+                            idx          in_stride,
+                            real const * in_height,
+                            real const * in_momentumX,
+                            real const * in_momentumY,
+                            real const * in_bathymetry ) {
+      for( idx y = 0; y < in_countY; y++ ) {
+        for( idx x = 0; x < in_countX; x++ ) {
+          idx cell = y * in_stride + x;
+          setHeight( in_x + x, in_y + y, in_height[cell] );
+          setMomentumX( in_x + x, in_y + y, in_momentumX[cell] );
+          setMomentumY( in_x + x, in_y + y, in_momentumY[cell] );
+          setBathymetry( in_x + x, in_y + y, in_bathymetry[cell] );
+        }
+      }
+    }
 };
 
 #endif
\ No newline at end of file
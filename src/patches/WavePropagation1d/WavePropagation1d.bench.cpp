@@ -0,0 +1,334 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the one-dimensional wave propagation patch.
+ **/
+#include "../../benchmarks/Benchmark.h"
+#include "WavePropagation1d.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  //! uniform signature of the solvers' net-updates
+  typedef void (*t_netUpdates)( tsunami_lab::real, tsunami_lab::real,
+                                tsunami_lab::real, tsunami_lab::real,
+                                tsunami_lab::real, tsunami_lab::real,
+                                tsunami_lab::real *, tsunami_lab::real *,
+                                tsunami_lab::real & );
+
+  //! solvers called through volatile pointers, which keeps the compiler from inlining them (like the former out-of-line solvers)
+  t_netUpdates volatile netUpdatesFWave = &tsunami_lab::solvers::FWave::netUpdates;
+  t_netUpdates volatile netUpdatesRoe = &tsunami_lab::solvers::Roe::netUpdates;
+
+  /**
+   * Time step of the 1d patch with the solver selected at runtime per edge, i.e., the dispatch before the patches were templated.
+   *
+   * @param in_solver solver type to use (Roe / FWave).
+   * @param in_cellCount number of cells (without ghost cells).
+   * @param in_scaling scaling of the time step (dt / dx).
+   * @param in_heightOld, in_momentumOld, in_bathymetry old quantities including ghost cells.
+   * @param out_heightNew, out_momentumNew will be set to the new quantities.
+   * @return maximum wave speed.
+   **/
+  tsunami_lab::real timeStepRuntime( tsunami_lab::Solver in_solver,
+                                     tsunami_lab::idx in_cellCount,
+                                     tsunami_lab::real in_scaling,
+                                     tsunami_lab::real const * in_heightOld,
+                                     tsunami_lab::real const * in_momentumOld,
+                                     tsunami_lab::real const * in_bathymetry,
+                                     tsunami_lab::real * out_heightNew,
+                                     tsunami_lab::real * out_momentumNew ) {
+    for( tsunami_lab::idx cell = 1; cell < in_cellCount+1; cell++ ) {
+      out_heightNew[cell] = in_heightOld[cell];
+      out_momentumNew[cell] = in_momentumOld[cell];
+    }
+
+    tsunami_lab::real waveSpeedMax = 0;
+    for( tsunami_lab::idx edge = 0; edge < in_cellCount+1; edge++ ) {
+      tsunami_lab::real netUpdates[2][2];
+      tsunami_lab::real speed;
+
+      if( in_solver == tsunami_lab::FWAVE ) {
+        netUpdatesFWave( in_heightOld[edge], in_heightOld[edge+1],
+                         in_momentumOld[edge], in_momentumOld[edge+1],
+                         in_bathymetry[edge], in_bathymetry[edge+1],
+                         netUpdates[0], netUpdates[1], speed );
+      } else {
+        netUpdatesRoe( in_heightOld[edge], in_heightOld[edge+1],
+                       in_momentumOld[edge], in_momentumOld[edge+1],
+                       in_bathymetry[edge], in_bathymetry[edge+1],
+                       netUpdates[0], netUpdates[1], speed );
+      }
+      waveSpeedMax = std::max( waveSpeedMax, speed );
+
+      out_heightNew[edge]     -= in_scaling * netUpdates[0][0];
+      out_momentumNew[edge]   -= in_scaling * netUpdates[0][1];
+      out_heightNew[edge+1]   -= in_scaling * netUpdates[1][0];
+      out_momentumNew[edge+1] -= in_scaling * netUpdates[1][1];
+    }
+
+    return waveSpeedMax;
+  }
+
+  /**
+   * Measures the cell updates per second of the templated patch and of the runtime dispatch for a dam break.
+   *
+   * @param in_solver solver type of the runtime dispatch.
+   * @param in_name name of the solver in the report.
+   * @param io_stream stream to which the results are written.
+   **/
+  template< typename t_solver >
+  void benchDispatch( tsunami_lab::Solver in_solver,
+                      std::string const & in_name,
+                      std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 1000000;
+    tsunami_lab::idx const stepCount = 20;
+    tsunami_lab::real const scaling = 0.001;
+
+    // after: solver compiled into the patch
+    tsunami_lab::patches::WavePropagation1d< t_solver > waveProp( cellCount );
+    for( tsunami_lab::idx cell = 0; cell < cellCount; cell++ ) {
+      waveProp.setHeight( cell, 0, cell < cellCount / 2 ? 10 : 5 );
+      waveProp.setMomentumX( cell, 0, 0 );
+      waveProp.setBathymetry( cell, 0, -5 );
+    }
+
+    tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+    double timeTemplate = 0;
+    for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+      waveProp.setGhostOutflow( boundary );
+      double start = tsunami_lab::instrumentation::Profiler::now();
+      waveProp.timeStep( scaling );
+      timeTemplate += tsunami_lab::instrumentation::Profiler::now() - start;
+    }
+
+    // before: solver selected per edge at runtime
+    std::vector< tsunami_lab::real > height[2];
+    std::vector< tsunami_lab::real > momentum[2];
+    std::vector< tsunami_lab::real > bathymetry( cellCount+2, -5 );
+    for( unsigned short buffer = 0; buffer < 2; buffer++ ) {
+      height[buffer].assign( cellCount+2, 0 );
+      momentum[buffer].assign( cellCount+2, 0 );
+    }
+    for( tsunami_lab::idx cell = 0; cell < cellCount; cell++ ) {
+      height[0][cell+1] = cell < cellCount / 2 ? 10 : 5;
+    }
+
+    double timeRuntime = 0;
+    for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+      std::vector< tsunami_lab::real > & heightOld = height[step % 2];
+      std::vector< tsunami_lab::real > & momentumOld = momentum[step % 2];
+      heightOld[0] = heightOld[1];
+      momentumOld[0] = momentumOld[1];
+      heightOld[cellCount+1] = heightOld[cellCount];
+      momentumOld[cellCount+1] = momentumOld[cellCount];
+
+      double start = tsunami_lab::instrumentation::Profiler::now();
+      timeStepRuntime( in_solver,
+                       cellCount,
+                       scaling,
+                       heightOld.data(),
+                       momentumOld.data(),
+                       bathymetry.data(),
+                       height[(step+1) % 2].data(),
+                       momentum[(step+1) % 2].data() );
+      timeRuntime += tsunami_lab::instrumentation::Profiler::now() - start;
+    }
+
+    double cellUpdates = double(cellCount) * stepCount;
+
+    std::string name = "WavePropagation1d/dispatch_" + in_name;
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/runtime", "cell_updates_per_second", cellUpdates / timeRuntime, "1/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/template", "cell_updates_per_second", cellUpdates / timeTemplate, "1/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "speedup", timeRuntime / timeTemplate, "" );
+  }
+
+  void benchSolverDispatch( std::ostream & io_stream ) {
+    benchDispatch< tsunami_lab::solvers::FWave >( tsunami_lab::FWAVE, "fwave", io_stream );
+    benchDispatch< tsunami_lab::solvers::Roe >( tsunami_lab::ROE, "roe", io_stream );
+  }
+
+  /**
+   * Bytes which a time step has to move per cell update at least: h, hu, b are read and h, hu are written once.
+   * The same count is used for all grid sizes, such that the effective bandwidth is proportional to the cell updates per second.
+   **/
+  double const bytesPerCell = 5 * sizeof(tsunami_lab::real);
+
+  /**
+   * Measures the time steps of the patch for dam breaks of several sizes.
+   *
+   * @param in_name name of the solver in the report.
+   * @param io_stream stream to which the results are written.
+   *
+   * @tparam t_solver Riemann solver.
+   **/
+  template< typename t_solver >
+  void benchTimeStep( std::string const & in_name,
+                      std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCounts[4] = { 1000, 10000, 100000, 1000000 };
+
+    for( unsigned short size = 0; size < 4; size++ ) {
+      tsunami_lab::idx cellCount = cellCounts[size];
+
+      // about 2^24 cell updates per measured run
+      tsunami_lab::idx stepCount = std::max( tsunami_lab::idx(1), ( tsunami_lab::idx(1) << 24 ) / cellCount );
+
+      tsunami_lab::patches::WavePropagation1d< t_solver > waveProp( cellCount );
+      for( tsunami_lab::idx cell = 0; cell < cellCount; cell++ ) {
+        waveProp.setHeight( cell, 0, cell < cellCount / 2 ? 10 : 5 );
+        waveProp.setMomentumX( cell, 0, 0 );
+        waveProp.setBathymetry( cell, 0, -5 );
+      }
+
+      tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+      double time = tsunami_lab::benchmarks::Benchmark::median( 5, [&]() {
+        for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+          waveProp.setGhostOutflow( boundary );
+          waveProp.timeStep( 0.001 );
+        }
+      } );
+
+      double cellUpdates = double(cellCount) * stepCount;
+      double edges = double(cellCount + 1) * stepCount;
+
+      std::string name = "WavePropagation1d/time_step_" + in_name + "/" + std::to_string( cellCount );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "time_per_edge", time / edges * 1E9, "ns" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "cell_updates_per_second", cellUpdates / time, "1/s" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "effective_bandwidth", bytesPerCell * cellUpdates / time * 1E-9, "GB/s" );
+    }
+  }
+
+  void benchTimeSteps( std::ostream & io_stream ) {
+    benchTimeStep< tsunami_lab::solvers::FWave >( "fwave", io_stream );
+    benchTimeStep< tsunami_lab::solvers::Roe >( "roe", io_stream );
+  }
+
+  /**
+   * Time step of a wet 1d grid with outflow boundaries in double precision, the reference of the precision benchmark.
+   * Performs the operations of FWave::netUpdates and WavePropagation1d::timeStep.
+   *
+   * @param in_scaling scaling of the time step (dt / dx).
+   * @param io_height water heights including ghost cells.
+   * @param io_momentum momenta including ghost cells.
+   * @param in_bathymetry bathymetry including ghost cells.
+   **/
+  void timeStepReference( double in_scaling,
+                          std::vector< double > & io_height,
+                          std::vector< double > & io_momentum,
+                          std::vector< double > const & in_bathymetry ) {
+    double const g = 9.80665;
+    tsunami_lab::idx cellCount = io_height.size() - 2;
+
+    io_height[0] = io_height[1];
+    io_momentum[0] = io_momentum[1];
+    io_height[cellCount+1] = io_height[cellCount];
+    io_momentum[cellCount+1] = io_momentum[cellCount];
+
+    std::vector< double > heightNew( io_height );
+    std::vector< double > momentumNew( io_momentum );
+
+    for( tsunami_lab::idx edge = 0; edge < cellCount+1; edge++ ) {
+      double hL = io_height[edge];
+      double hR = io_height[edge+1];
+      double huL = io_momentum[edge];
+      double huR = io_momentum[edge+1];
+
+      double sqrtHL = std::sqrt( hL );
+      double sqrtHR = std::sqrt( hR );
+      double velocityRoe = ( huL / hL * sqrtHL + huR / hR * sqrtHR ) / ( sqrtHL + sqrtHR );
+      double celerity = std::sqrt( g * 0.5 * ( hL + hR ) );
+      double eigenvalues[2] = { velocityRoe - celerity, velocityRoe + celerity };
+
+      double fluxJump0 = huR - huL;
+      double fluxJump1 = huR * huR / hR + 0.5 * g * hR * hR - huL * huL / hL - 0.5 * g * hL * hL
+                       + g * ( in_bathymetry[edge+1] - in_bathymetry[edge] ) * ( hL + hR ) / 2;
+
+      double alpha[2] = { ( eigenvalues[1] * fluxJump0 - fluxJump1 ) / ( eigenvalues[1] - eigenvalues[0] ),
+                          ( fluxJump1 - eigenvalues[0] * fluxJump0 ) / ( eigenvalues[1] - eigenvalues[0] ) };
+
+      for( unsigned short wave = 0; wave < 2; wave++ ) {
+        tsunami_lab::idx cell = eigenvalues[wave] < 0 ? edge : edge+1;
+        if( cell < 1 || cell > cellCount ) continue;
+        heightNew[cell] -= in_scaling * alpha[wave];
+        momentumNew[cell] -= in_scaling * alpha[wave] * eigenvalues[wave];
+      }
+    }
+
+    io_height.swap( heightNew );
+    io_momentum.swap( momentumNew );
+  }
+
+  /**
+   * Measures throughput and error of the floating point configuration of the build (single, double or mixed, see constants.h):
+   * a Gaussian wave of 1 m in a 4 km deep ocean runs onto a shelf.
+   * The heights of deep water are large compared to the wave, which makes the jump in the fluxes prone to cancellation.
+   * The error is the deviation of the surface elevation from the same scheme in double precision.
+   **/
+  void benchPrecision( std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 10000;
+    tsunami_lab::idx const stepCount = 4000;
+    double const scaling = 0.0025;
+
+    std::vector< double > heightReference( cellCount+2 );
+    std::vector< double > momentumReference( cellCount+2, 0 );
+    std::vector< double > bathymetryReference( cellCount+2 );
+
+    tsunami_lab::patches::WavePropagation1d< tsunami_lab::solvers::FWave > waveProp( cellCount );
+    for( tsunami_lab::idx cell = 0; cell < cellCount; cell++ ) {
+      double shelf = std::min( std::max( ( double(cell) - 2500 ) / 2500, 0.0 ), 1.0 );
+      double bathymetry = -4000 + shelf * 3950;
+      double elevation = std::exp( -std::pow( ( double(cell) - 2000 ) / 50, 2 ) );
+
+      // both runs start from the same, representable values
+      tsunami_lab::real height = tsunami_lab::real( elevation - bathymetry );
+      waveProp.setHeight( cell, 0, height );
+      waveProp.setMomentumX( cell, 0, 0 );
+      waveProp.setBathymetry( cell, 0, tsunami_lab::real( bathymetry ) );
+
+      heightReference[cell+1] = height;
+      bathymetryReference[cell+1] = tsunami_lab::real( bathymetry );
+    }
+    bathymetryReference[0] = bathymetryReference[1];
+    bathymetryReference[cellCount+1] = bathymetryReference[cellCount];
+
+    tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+    double start = tsunami_lab::instrumentation::Profiler::now();
+    for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+      waveProp.setGhostOutflow( boundary );
+      waveProp.timeStep( tsunami_lab::real( scaling ) );
+    }
+    double time = tsunami_lab::instrumentation::Profiler::now() - start;
+
+    for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+      timeStepReference( tsunami_lab::real( scaling ), heightReference, momentumReference, bathymetryReference );
+    }
+
+    double errorMax = 0;
+    double errorSquares = 0;
+    for( tsunami_lab::idx cell = 0; cell < cellCount; cell++ ) {
+      double error = std::abs( double( waveProp.getHeight()[cell] ) - heightReference[cell+1] );
+      errorMax = std::max( errorMax, error );
+      errorSquares += error * error;
+    }
+
+    double cellUpdates = double(cellCount) * stepCount;
+
+    std::string name = std::string( "WavePropagation1d/precision_" ) + tsunami_lab::precisionName + "/ocean_shelf";
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "bytes_per_value", sizeof(tsunami_lab::real), "B" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "cell_updates_per_second", cellUpdates / time, "1/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "error_surface_max", errorMax * 1E3, "mm" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "error_surface_rms", std::sqrt( errorSquares / cellCount ) * 1E3, "mm" );
+  }
+
+  tsunami_lab::benchmarks::Benchmark solverDispatch( "WavePropagation1d/solver_dispatch", benchSolverDispatch );
+  tsunami_lab::benchmarks::Benchmark precision( "WavePropagation1d/precision", benchPrecision );
+  tsunami_lab::benchmarks::Benchmark timeSteps( "WavePropagation1d/time_step", benchTimeSteps );
+}
@@ -7,12 +7,12 @@
  * One-dimensional wave propagation patch.
  **/
 #include "WavePropagation1d.h"
-#include "../../solvers/FWave.h"
-#include "../../solvers/Roe.h"
+#include "../../instrumentation/Profiler.h"
 
 using namespace tsunami_lab::patches;
 
-WavePropagation1d::WavePropagation1d( idx in_cellCount ) {
+template< typename t_solver >
+WavePropagation1d< t_solver >::WavePropagation1d( idx in_cellCount ): edges( in_cellCount+1 ), edgeClasses( in_cellCount+2, 1 ) {
   cellCount = in_cellCount;
 
   // allocate memory including a single ghost cell on each side
@@ -34,7 +34,8 @@ WavePropagation1d::WavePropagation1d( idx in_cellCount ) {
   }
 }
 
-WavePropagation1d::~WavePropagation1d() {
+template< typename t_solver >
+WavePropagation1d< t_solver >::~WavePropagation1d() {
   for( unsigned short i = 0; i < 2; i++ ) {
     delete[] height[i];
     delete[] momentum[i];
@@ -42,7 +43,11 @@ WavePropagation1d::~WavePropagation1d() {
   delete[] bathymetry;
 }
 
-void WavePropagation1d::timeStep( real in_scaling, Solver in_solver ) {
+template< typename t_solver >
+void WavePropagation1d< t_solver >::timeStep( real in_scaling ) {
+  // the one-dimensional patch performs a single sweep in x-direction
+  instrumentation::ScopedTimer timer( instrumentation::Profiler::SWEEP_X );
+
   // pointers to old and new data
   real * heightOld = height[step];
   real * momentumOld = momentum[step];
@@ -51,60 +56,72 @@ void WavePropagation1d::timeStep( real in_scaling, Solver in_solver ) {
   real * heightNew =  height[step];
   real * momentumNew = momentum[step];
 
-  // init new cell quantities
-  for( idx cell = 1; cell < cellCount+1; cell++ ) {
-    heightNew[cell] = heightOld[cell];
-    momentumNew[cell] = momentumOld[cell];
+  // the cells including the ghost cells bound the edges: the left cell of edge i is cell i, the right one is cell i+1
+  EdgeBatch::CellRow * cells = nullptr;
+  if( cellCache ) {
+    cells = &edges.cellRows[0];
+    edges.template computeCells< t_solver >( *cells, cellCount+2, heightOld, momentumOld );
+  }
+
+  idx skippedCount = edges.skippedCount;
+  if( edgeClassesEnabled ) {
+    // the bathymetry of the reflecting ghost cells depends on the heights, thus their classes are updated in every time step
+    if( !edgeClassesValid ) {
+      edgeClasses.setRow( 0, cellCount+2, bathymetry );
+      edgeClassesValid = true;
+    }
+    edgeClasses.setCell( 0, 0, bathymetry[0] );
+    edgeClasses.setCell( 0, cellCount+1, bathymetry[cellCount+1] );
+
+    // solve the edges in place by their classes
+    waveSpeedMax = edges.template solveClassified< t_solver >( cellCount+1,
+                                                               heightOld, heightOld+1,
+                                                               momentumOld, momentumOld+1,
+                                                               bathymetry, bathymetry+1,
+                                                               edgeClasses,
+                                                               0, 0,
+                                                               0, 1,
+                                                               cells, 0,
+                                                               cells, 1,
+                                                               0 );
+  }
+  // gather the states of all edges, solve them as a batch
+  else if( cellCache ) {
+    edges.gatherCached( cellCount+1,
+                        heightOld, heightOld+1,
+                        momentumOld, momentumOld+1,
+                        bathymetry, bathymetry+1,
+                        *cells, 0,
+                        *cells, 1 );
+    waveSpeedMax = edges.template solveCached< t_solver >( cellCount+1, 0 );
   }
+  else {
+    edges.gather( cellCount+1,
+                  heightOld, heightOld+1,
+                  momentumOld, momentumOld+1,
+                  bathymetry, bathymetry+1 );
+    waveSpeedMax = edges.template solve< t_solver >( cellCount+1, 0 );
+  }
+  edgeCountSkipped = edges.skippedCount - skippedCount;
+
+  // scatter: every cell receives the update of its left edge first, then the one of its right edge
+  real const * netUpdateLeftHeight = edges.netUpdateLeftHeight.data();
+  real const * netUpdateLeftMomentum = edges.netUpdateLeftMomentum.data();
+  real const * netUpdateRightHeight = edges.netUpdateRightHeight.data();
+  real const * netUpdateRightMomentum = edges.netUpdateRightMomentum.data();
+
+  // the updates are accumulated in realCompute, i.e., in double precision for mixed precision builds
+  realCompute scaling = in_scaling;
 
-  // iterate over edges and update with Riemann solutions
-  for( idx edge = 0; edge < cellCount+1; edge++ ) {
-    // determine left and right cell-id
-    idx cellLeft = edge;
-    idx cellRight = edge+1;
-
-    // compute net-updates
-    real netUpdates[2][2];
-	 
-	 real stateLeft[3] = { heightOld[cellLeft], momentumOld[cellLeft], bathymetry[cellLeft] };
-	 real stateRight[3] = { heightOld[cellRight], momentumOld[cellRight], bathymetry[cellRight] };
-
-	 if(bathymetry[cellLeft] > 0) {
-		stateLeft[0] = stateRight[0];
-		stateLeft[1] = -stateRight[1];
-		stateLeft[2] = stateRight[2];
-	 }
-
-	 if(bathymetry[cellRight] > 0) {
-		stateRight[0] = stateLeft[0];
-		stateRight[1] = -stateLeft[1];
-		stateRight[2] = stateLeft[2];
-	 }
-
-	 if ( in_solver == FWAVE ) {
-		solvers::FWave::netUpdates( stateLeft, 
-	 										 stateRight, 
-                              	 netUpdates[0],
-                              	 netUpdates[1] );
-	 } else {
-		solvers::Roe::netUpdates( stateLeft[0], 
-	 									  stateRight[0], 
-	 									  stateLeft[1], 
-	 									  stateRight[1], 
-                                netUpdates[0],
-                                netUpdates[1] );
-	 }
-
-    // update the cells' quantities
-    heightNew[cellLeft]  -= in_scaling * netUpdates[0][0];
-    momentumNew[cellLeft] -= in_scaling * netUpdates[0][1];
-
-    heightNew[cellRight]  -= in_scaling * netUpdates[1][0];
-    momentumNew[cellRight] -= in_scaling * netUpdates[1][1];
+#pragma omp simd
+  for( idx cell = 1; cell < cellCount+1; cell++ ) {
+    heightNew[cell] = real( heightOld[cell] - scaling * netUpdateRightHeight[cell-1] - scaling * netUpdateLeftHeight[cell] );
+    momentumNew[cell] = real( momentumOld[cell] - scaling * netUpdateRightMomentum[cell-1] - scaling * netUpdateLeftMomentum[cell] );
   }
 }
 
-void WavePropagation1d::setGhostOutflow( Boundary boundary[2] ) {
+template< typename t_solver >
+void WavePropagation1d< t_solver >::setGhostOutflow( Boundary boundary[2] ) {
   real * heightLocal = height[step];
   real * momentumLocal = momentum[step];
   real * bathymetryLocal = bathymetry;
@@ -130,4 +147,8 @@ void WavePropagation1d::setGhostOutflow( Boundary boundary[2] ) {
 	 momentumLocal[cellCount+1] = 0;
 	 bathymetryLocal[cellCount+1] = heightLocal[cellCount]+bathymetryLocal[cellCount]+1;
   }
-}
\ No newline at end of file
+}
+
+// instantiations for the available solvers
+template class tsunami_lab::patches::WavePropagation1d< tsunami_lab::solvers::FWave >;
+template class tsunami_lab::patches::WavePropagation1d< tsunami_lab::solvers::Roe >;
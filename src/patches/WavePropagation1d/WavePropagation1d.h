@@ -10,13 +10,28 @@
 #define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_1D
 
 #include "../WavePropagation.h"
+#include "../EdgeBatch.h"
+#include "../EdgeClasses.h"
+#include "../../solvers/FWave.h"
+#include "../../solvers/Roe.h"
+#include <atomic>
 
 namespace tsunami_lab {
   namespace patches {
+    template< typename t_solver >
     class WavePropagation1d;
   }
 }
 
+/**
+ * One-dimensional wave propagation patch.
+ *
+ * The patch is templated on the Riemann solver (solvers::FWave or solvers::Roe), which is called through the common
+ * netUpdates interface of the solvers. Thus, the solver is selected once at construction and inlined into the edge loop.
+ *
+ * @tparam t_solver Riemann solver.
+ **/
+template< typename t_solver >
 class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
   private:
     //! current step which indicates the active values in the arrays below
@@ -34,6 +49,27 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
     //! bathymetry for all cells
     real * bathymetry = nullptr;
 
+    //! maximum wave speed of the last time step
+    real waveSpeedMax = 0;
+
+    //! buffers of the edges, which are gathered, solved and scattered in a single batch
+    EdgeBatch edges;
+
+    //! true if the quantities shared by the edges of a cell are computed once per cell
+    bool cellCache = false;
+
+    //! true if the edges are solved by their precomputed classes instead of being gathered
+    bool edgeClassesEnabled = true;
+
+    //! dry cells including the ghost cells, which classify the edges
+    EdgeClasses edgeClasses;
+
+    //! false if the bathymetry changed since the classes were computed; regions might be set concurrently
+    std::atomic< bool > edgeClassesValid{ false };
+
+    //! number of edges between two dry cells skipped in the last time step
+    idx edgeCountSkipped = 0;
+
 	 //! minmal bathymetry depth
 	 real dy = -20;
 
@@ -54,9 +90,8 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
      * @brief Performs a time step.
      *
      * @param in_scaling scaling of the time step (dt / dx).
-	  * @param in_solver solver type to use (Roe / FWave)
      **/
-    void timeStep( real in_scaling, Solver in_solver );
+    void timeStep( real in_scaling );
 
     /**
 	  * @brief Sets the values of the ghost cells according to outflow boundary conditions.
@@ -65,6 +100,53 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
 	  */
     void setGhostOutflow(Boundary in_boundary[2]);
 
+    /**
+     * @brief Gets the maximum wave speed of all edges of the last time step.
+     *
+     * @return maximum wave speed.
+     **/
+    real getWaveSpeedMax(){
+      return waveSpeedMax;
+    }
+
+    /**
+     * @brief Gets the number of dimensions of the patch.
+     *
+     * @return 1.
+     **/
+    unsigned short getDimensions(){
+      return 1;
+    }
+
+    /**
+     * @brief Enables or disables the cache of the cell quantities shared by the edges of a cell.
+     *
+     * @param in_cellCache true to enable the cache.
+     **/
+    void setCellCache( bool in_cellCache ) {
+      cellCache = in_cellCache;
+      edges.resize( cellCount+1, cellCache );
+    }
+
+    /**
+     * @brief Enables or disables the precomputed classes of the edges.
+     *
+     * @param in_edgeClasses true to enable the classes.
+     **/
+    void setEdgeClasses( bool in_edgeClasses ) {
+      edgeClassesEnabled = in_edgeClasses;
+      edgeClassesValid = false;
+    }
+
+    /**
+     * @brief Gets the fraction of the edges of the last time step which were skipped since both of their cells are dry.
+     *
+     * @return fraction of the skipped edges.
+     **/
+    real getSkippedFraction(){
+      return real(edgeCountSkipped) / real(cellCount+1);
+    }
+
     /**
      * @brief Gets the stride in y-direction. x-direction is stride-1.
      *
@@ -147,6 +229,7 @@ class tsunami_lab::patches::WavePropagation1d: public WavePropagation {
 		// 	in_bathymetry = dy;
 		// }
 		bathymetry[in_x + 1] = in_bathymetry;
+		edgeClassesValid = false;
 	};
 };
 
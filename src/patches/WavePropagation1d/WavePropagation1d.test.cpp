@@ -28,7 +28,8 @@ TEST_CASE( "Test the 1d wave propagation solver.", "[WaveProp1d]" ) {
    */
 
   // construct solver and setup a dambreak problem
-  tsunami_lab::patches::WavePropagation1d waveProp( 100 );
+  tsunami_lab::patches::WavePropagation1d< tsunami_lab::solvers::FWave > waveProp( 100 );
+  REQUIRE( waveProp.getDimensions() == 1 );
 
   for( std::size_t cell = 0; cell < 50; cell++ ) {
     waveProp.setHeight( cell,
@@ -60,7 +61,10 @@ TEST_CASE( "Test the 1d wave propagation solver.", "[WaveProp1d]" ) {
   waveProp.setGhostOutflow( boundary );
 
   // perform a time step
-  waveProp.timeStep( 0.1, tsunami_lab::FWAVE );
+  waveProp.timeStep( 0.1 );
+
+  // fastest waves are the gravity waves in the deeper steady state: sqrt(9.80665 * 10)
+  REQUIRE( waveProp.getWaveSpeedMax() == Approx(9.902853124) );
 
   // steady state
   for( std::size_t cell = 0; cell < 49; cell++ ) {
@@ -82,6 +86,101 @@ TEST_CASE( "Test the 1d wave propagation solver.", "[WaveProp1d]" ) {
   }
 }
 
+/**
+ * Checks that the cache of the cell quantities does not change the time steps of the given solver's patch.
+ *
+ * @tparam t_solver Riemann solver of the patches.
+ **/
+template< typename t_solver >
+static void testCellCache() {
+  tsunami_lab::patches::WavePropagation1d< t_solver > reference( 50 );
+  tsunami_lab::patches::WavePropagation1d< t_solver > cached( 50 );
+  cached.setCellCache( true );
+  tsunami_lab::patches::WavePropagation * waveProps[2] = { &reference, &cached };
+
+  // dam break over a varying bathymetry, the reflecting boundaries are dry ghost cells
+  for( unsigned short patch = 0; patch < 2; patch++ ) {
+    for( std::size_t cell = 0; cell < 50; cell++ ) {
+      waveProps[patch]->setHeight( cell, 0, cell < 20 ? 10 : 5 );
+      waveProps[patch]->setMomentumX( cell, 0, cell < 20 ? 3 : -1 );
+      waveProps[patch]->setBathymetry( cell, 0, -5 + tsunami_lab::real( cell % 3 ) / 5 );
+    }
+  }
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::REFLECTING,
+		tsunami_lab::REFLECTING };
+
+  for( unsigned short step = 0; step < 20; step++ ) {
+    for( unsigned short patch = 0; patch < 2; patch++ ) {
+      waveProps[patch]->setGhostOutflow( boundary );
+      waveProps[patch]->timeStep( 0.05 );
+    }
+    REQUIRE( cached.getWaveSpeedMax() == reference.getWaveSpeedMax() );
+  }
+
+  for( std::size_t cell = 0; cell < 50; cell++ ) {
+    REQUIRE( cached.getHeight()[cell] == reference.getHeight()[cell] );
+    REQUIRE( cached.getMomentumX()[cell] == reference.getMomentumX()[cell] );
+  }
+}
+
+TEST_CASE( "Test that the cache of the cell quantities does not change the 1d time step.", "[WaveProp1dCellCache]" ) {
+  testCellCache< tsunami_lab::solvers::FWave >();
+  testCellCache< tsunami_lab::solvers::Roe >();
+}
+
+/**
+ * Checks that the classes of the edges do not change the time steps of the wet cells of the given solver's patch.
+ *
+ * @tparam t_solver Riemann solver of the patches.
+ **/
+template< typename t_solver >
+static void testEdgeClasses() {
+  tsunami_lab::patches::WavePropagation1d< t_solver > reference( 50 );
+  tsunami_lab::patches::WavePropagation1d< t_solver > classified( 50 );
+  reference.setEdgeClasses( false );
+  tsunami_lab::patches::WavePropagation * waveProps[2] = { &reference, &classified };
+
+  // dam break between a dry shore and a dry bar, the reflecting boundaries are dry ghost cells
+  for( unsigned short patch = 0; patch < 2; patch++ ) {
+    for( std::size_t cell = 0; cell < 50; cell++ ) {
+      bool dry = cell < 5 || ( cell >= 30 && cell < 33 );
+      waveProps[patch]->setHeight( cell, 0, dry ? 0 : ( cell < 20 ? 10 : 5 ) );
+      waveProps[patch]->setMomentumX( cell, 0, dry ? 0 : ( cell < 20 ? 3 : -1 ) );
+      waveProps[patch]->setBathymetry( cell, 0, dry ? 2 : -5 + tsunami_lab::real( cell % 3 ) / 5 );
+    }
+  }
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::REFLECTING,
+		tsunami_lab::REFLECTING };
+
+  for( unsigned short step = 0; step < 20; step++ ) {
+    for( unsigned short patch = 0; patch < 2; patch++ ) {
+      waveProps[patch]->setGhostOutflow( boundary );
+      waveProps[patch]->timeStep( 0.05 );
+    }
+    REQUIRE( classified.getWaveSpeedMax() == reference.getWaveSpeedMax() );
+  }
+
+  // the edges left of the cells 0-4 (including the dry ghost cell) and 31-32 are located between two dry cells
+  REQUIRE( classified.getSkippedFraction() == Approx( 7.0 / 51 ) );
+  REQUIRE( reference.getSkippedFraction() == 0 );
+
+  for( std::size_t cell = 0; cell < 50; cell++ ) {
+    if( reference.getBathymetry()[cell] > 0 ) continue;
+
+    REQUIRE( classified.getHeight()[cell] == reference.getHeight()[cell] );
+    REQUIRE( classified.getMomentumX()[cell] == reference.getMomentumX()[cell] );
+  }
+}
+
+TEST_CASE( "Test that the classes of the edges do not change the 1d time step of the wet cells.", "[WaveProp1dEdgeClasses]" ) {
+  testEdgeClasses< tsunami_lab::solvers::FWave >();
+  testEdgeClasses< tsunami_lab::solvers::Roe >();
+}
+
 TEST_CASE("Test the 1d wave propagation FWave solver (Shock-Shock Problem).", "[WaveProp1dFWaveShockShock]")
 {
   /*
@@ -95,7 +194,7 @@ TEST_CASE("Test the 1d wave propagation FWave solver (Shock-Shock Problem).", "[
    */
 
   // construct solver and setup a Shock-Shock problem
-  tsunami_lab::patches::WavePropagation1d waveProp( 100 );
+  tsunami_lab::patches::WavePropagation1d< tsunami_lab::solvers::FWave > waveProp( 100 );
 
   for (std::size_t cell = 0; cell < 50; cell++)
   {
@@ -131,7 +230,7 @@ TEST_CASE("Test the 1d wave propagation FWave solver (Shock-Shock Problem).", "[
   // perform a time step
   for (int i = 0; i < 50; i++) {
 		waveProp.setGhostOutflow( boundary );
-		waveProp.timeStep(0.001, tsunami_lab::FWAVE );
+		waveProp.timeStep( 0.001 );
   }
 
   // test for h*
@@ -152,7 +251,7 @@ TEST_CASE("Test the 1d wave propagation FWave solver (Rare-Rare Problem", "[Wave
    */
 
   // construct solver and setup a Rare-Rare problem
-  tsunami_lab::patches::WavePropagation1d waveProp( 100 );
+  tsunami_lab::patches::WavePropagation1d< tsunami_lab::solvers::FWave > waveProp( 100 );
 
   for (std::size_t cell = 0; cell < 50; cell++)
   {
@@ -188,7 +287,7 @@ TEST_CASE("Test the 1d wave propagation FWave solver (Rare-Rare Problem", "[Wave
   // perform a time step
   for (int i = 0; i < 50; i++) {
 		waveProp.setGhostOutflow( boundary );
-		waveProp.timeStep(0.001, tsunami_lab::FWAVE );
+		waveProp.timeStep( 0.001 );
   }
 
   // test for h*
@@ -0,0 +1,541 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the two-dimensional wave propagation patch.
+ **/
+#include "../../benchmarks/Benchmark.h"
+#include "WavePropagation2d.h"
+#include "../../setups/DamBreak2d/DamBreak2d.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+  //! assumed size of the L2 cache in bytes, used by the traffic model
+  tsunami_lab::idx const l2Size = 1024 * 1024;
+
+  /**
+   * Modelled DRAM traffic per cell update in bytes.
+   *
+   * If the working set of a tile does not fit the L2 cache, the tile is processed in three streaming passes:
+   *   copy: 3 values read, 3 values written,
+   *   x-sweep: h, hu, b read (old), h, hu read and written (new),
+   *   y-sweep: h, hv, b read (old), h, hv read and written (new),
+   * which moves 20 values per cell.
+   * Otherwise all passes hit the cache and only h, hu, hv, b (old) are read and h, hu, hv (new) are written once, i.e., 7 values per cell.
+   **/
+  double bytesPerCell( tsunami_lab::idx in_tileSizeX,
+                       tsunami_lab::idx in_tileSizeY ) {
+    tsunami_lab::idx workingSet = (in_tileSizeX + 2) * (in_tileSizeY + 2) * 7 * sizeof(tsunami_lab::real);
+    return (workingSet <= l2Size ? 7 : 20) * sizeof(tsunami_lab::real);
+  }
+
+  /**
+   * Bytes which a time step has to move per cell update at least: h, hu, hv, b are read and h, hu, hv are written once.
+   * The same count is used for all grid sizes, such that the effective bandwidth is proportional to the cell updates per second.
+   **/
+  double const bytesPerCellMin = 7 * sizeof(tsunami_lab::real);
+
+  void benchTiling( std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 1024;
+    tsunami_lab::idx const stepCount = 20;
+    tsunami_lab::idx const tileSizes[4][2] = { { cellCount, cellCount },
+                                               { 1024, 8 },
+                                               { 256, 32 },
+                                               { 64, 64 } };
+
+    for( unsigned short config = 0; config < 4; config++ ) {
+      tsunami_lab::idx tileSizeX = tileSizes[config][0];
+      tsunami_lab::idx tileSizeY = tileSizes[config][1];
+
+      tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( cellCount,
+                                                        cellCount,
+                                                        tileSizeX,
+                                                        tileSizeY );
+
+      // circular dam break
+      for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+        for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+          tsunami_lab::real dx = tsunami_lab::real(x) - cellCount / 2;
+          tsunami_lab::real dy = tsunami_lab::real(y) - cellCount / 2;
+          waveProp.setHeight( x, y, dx*dx + dy*dy < cellCount*cellCount / 16 ? 10 : 5 );
+          waveProp.setBathymetry( x, y, -5 );
+        }
+      }
+
+      tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+      double time = 0;
+      for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+        waveProp.setGhostOutflow( boundary );
+        double start = tsunami_lab::instrumentation::Profiler::now();
+        waveProp.timeStep( 0.01 );
+        time += tsunami_lab::instrumentation::Profiler::now() - start;
+      }
+
+      double cellUpdates = double(cellCount) * cellCount * stepCount;
+      double bytes = bytesPerCell( tileSizeX, tileSizeY );
+
+      std::stringstream name;
+      name << "WavePropagation2d/tile_" << tileSizeX << "x" << tileSizeY;
+
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "time_per_cell_update", time / cellUpdates * 1E9, "ns" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "bytes_per_cell_update", bytes, "B (model)" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "bandwidth", bytes * cellUpdates / time * 1E-9, "GB/s (model)" );
+    }
+  }
+
+  void benchStrongScaling( std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 2048;
+    tsunami_lab::idx const stepCount = 10;
+
+    // DAMBREAK2D setup of the driver scaled to the number of cells
+    tsunami_lab::setups::DamBreak2d damBreak( 10, 5, cellCount / 10, cellCount, cellCount, 1 );
+
+    tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( cellCount, cellCount );
+    for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+      for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+        waveProp.setHeight( x, y, damBreak.getHeight( x, y ) );
+        waveProp.setBathymetry( x, y, damBreak.getBathymetry( x, y ) );
+      }
+    }
+
+    int threadCountMax = 1;
+#ifdef _OPENMP
+    threadCountMax = omp_get_max_threads();
+#endif
+
+    tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+    double timeSerial = 0;
+
+    // powers of two and the maximum number of threads
+    for( int threadCount = 1; threadCount <= threadCountMax; threadCount = ( threadCount * 2 > threadCountMax && threadCount < threadCountMax ) ? threadCountMax : threadCount * 2 ) {
+#ifdef _OPENMP
+      omp_set_num_threads( threadCount );
+#endif
+
+      double time = 0;
+      for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+        waveProp.setGhostOutflow( boundary );
+        double start = tsunami_lab::instrumentation::Profiler::now();
+        waveProp.timeStep( 0.001 );
+        time += tsunami_lab::instrumentation::Profiler::now() - start;
+      }
+      if( threadCount == 1 ) timeSerial = time;
+
+      std::stringstream name;
+      name << "WavePropagation2d/dambreak2d_" << cellCount << "/threads_" << threadCount;
+
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "time_per_step", time / stepCount * 1E3, "ms" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "speedup", timeSerial / time, "" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "parallel_efficiency", timeSerial / time / threadCount * 100, "%" );
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads( threadCountMax );
+#endif
+  }
+
+  /**
+   * Runs the DAMBREAK2D setup of the driver up to the given time with the adaptive time step of the driver.
+   *
+   * @param in_cellCount number of cells in x- and y-direction.
+   * @param in_endTime simulated time.
+   * @param in_splitting dimensional splitting of the patch.
+   * @param in_cfl CFL number.
+   * @param out_height will be set to the water heights at the end time.
+   * @param out_stepCount will be set to the number of time steps.
+   * @return time to solution in seconds.
+   **/
+  double runDamBreak( tsunami_lab::idx in_cellCount,
+                      tsunami_lab::real in_endTime,
+                      tsunami_lab::Splitting in_splitting,
+                      tsunami_lab::real in_cfl,
+                      std::vector< tsunami_lab::real > & out_height,
+                      tsunami_lab::idx & out_stepCount ) {
+    tsunami_lab::setups::DamBreak2d damBreak( 10, 5, in_cellCount / 10, in_cellCount, in_cellCount, 1 );
+
+    tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( in_cellCount, in_cellCount, 256, 32, in_splitting );
+    for( tsunami_lab::idx y = 0; y < in_cellCount; y++ ) {
+      for( tsunami_lab::idx x = 0; x < in_cellCount; x++ ) {
+        waveProp.setHeight( x, y, damBreak.getHeight( x, y ) );
+        waveProp.setBathymetry( x, y, damBreak.getBathymetry( x, y ) );
+      }
+    }
+
+    tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+    double start = tsunami_lab::instrumentation::Profiler::now();
+    tsunami_lab::real speedMax = std::sqrt( tsunami_lab::real(9.80665) * 10 );
+    tsunami_lab::real time = 0;
+    out_stepCount = 0;
+    while( time < in_endTime ) {
+      tsunami_lab::real dt = std::min( in_cfl / speedMax, in_endTime - time );
+
+      waveProp.setGhostOutflow( boundary );
+      waveProp.timeStep( dt );
+      speedMax = waveProp.getWaveSpeedMax();
+
+      time += dt;
+      out_stepCount++;
+    }
+    double timeToSolution = tsunami_lab::instrumentation::Profiler::now() - start;
+
+    out_height.resize( in_cellCount * in_cellCount );
+    for( tsunami_lab::idx y = 0; y < in_cellCount; y++ ) {
+      for( tsunami_lab::idx x = 0; x < in_cellCount; x++ ) {
+        out_height[y * in_cellCount + x] = waveProp.getHeight()[y * waveProp.getStride() + x];
+      }
+    }
+
+    return timeToSolution;
+  }
+
+  void benchSplitting( std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 256;
+    tsunami_lab::real const endTime = 8;
+
+    // reference: unsplit scheme with a small time step, all schemes converge to it for dt -> 0
+    std::vector< tsunami_lab::real > heightReference;
+    tsunami_lab::idx stepCount = 0;
+    runDamBreak( cellCount, endTime, tsunami_lab::UNSPLIT, 0.05, heightReference, stepCount );
+
+    struct Config {
+      tsunami_lab::Splitting splitting;
+      char const * name;
+      tsunami_lab::real cfl;
+    };
+    Config const configs[8] = { { tsunami_lab::UNSPLIT, "none", 0.25 },
+                                { tsunami_lab::UNSPLIT, "none", 0.5 },
+                                { tsunami_lab::GODUNOV, "godunov", 0.5 },
+                                { tsunami_lab::GODUNOV, "godunov", 0.6 },
+                                { tsunami_lab::GODUNOV, "godunov", 0.9 },
+                                { tsunami_lab::STRANG, "strang", 0.5 },
+                                { tsunami_lab::STRANG, "strang", 0.6 },
+                                { tsunami_lab::STRANG, "strang", 0.9 } };
+
+    // baseline: unsplit scheme at its default CFL number; split configurations with an error ratio <= 1 are at least as accurate
+    double timeBaseline = 0;
+    double errorBaseline = 0;
+
+    for( unsigned short config = 0; config < 8; config++ ) {
+      std::vector< tsunami_lab::real > height;
+      double time = runDamBreak( cellCount, endTime, configs[config].splitting, configs[config].cfl, height, stepCount );
+
+      // mean absolute error of the water height
+      double error = 0;
+      for( tsunami_lab::idx cell = 0; cell < height.size(); cell++ ) {
+        error += std::abs( height[cell] - heightReference[cell] );
+      }
+      error /= height.size();
+
+      if( config == 1 ) {
+        timeBaseline = time;
+        errorBaseline = error;
+      }
+
+      std::stringstream name;
+      name << "WavePropagation2d/splitting_" << configs[config].name << "/cfl_" << configs[config].cfl;
+
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "time_steps", stepCount, "" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "time_to_solution", time * 1E3, "ms" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "error_height", error, "m (mean abs)" );
+      if( config >= 1 ) {
+        tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "error_vs_unsplit", error / errorBaseline, "" );
+        tsunami_lab::benchmarks::Benchmark::report( io_stream, name.str(), "speedup_vs_unsplit", timeBaseline / time, "" );
+      }
+    }
+  }
+
+  /**
+   * Measures the time steps of the patch with the default tiles for dam breaks of several sizes.
+   *
+   * @param in_name name of the solver in the report.
+   * @param io_stream stream to which the results are written.
+   *
+   * @tparam t_solver Riemann solver.
+   **/
+  template< typename t_solver >
+  void benchTimeStep( std::string const & in_name,
+                      std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCounts[4] = { 64, 256, 1024, 2048 };
+
+    for( unsigned short size = 0; size < 4; size++ ) {
+      tsunami_lab::idx cellCount = cellCounts[size];
+
+      // about 2^24 cell updates per measured run
+      tsunami_lab::idx stepCount = std::max( tsunami_lab::idx(1), ( tsunami_lab::idx(1) << 24 ) / ( cellCount * cellCount ) );
+
+      // DAMBREAK2D setup of the driver scaled to the number of cells
+      tsunami_lab::setups::DamBreak2d damBreak( 10, 5, cellCount / 10, cellCount, cellCount, 1 );
+
+      tsunami_lab::patches::WavePropagation2d< t_solver > waveProp( cellCount, cellCount );
+      for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+        for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+          waveProp.setHeight( x, y, damBreak.getHeight( x, y ) );
+          waveProp.setBathymetry( x, y, damBreak.getBathymetry( x, y ) );
+        }
+      }
+
+      tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+      double edges = 0;
+      double time = tsunami_lab::benchmarks::Benchmark::median( 5, [&]() {
+        edges = 0;
+        for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+          waveProp.setGhostOutflow( boundary );
+          waveProp.timeStep( 0.001 );
+          edges += waveProp.getEdgeCount();
+        }
+      } );
+
+      double cellUpdates = double(cellCount) * cellCount * stepCount;
+
+      std::string name = "WavePropagation2d/time_step_" + in_name + "/" + std::to_string( cellCount ) + "x" + std::to_string( cellCount );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "time_per_edge", time / edges * 1E9, "ns" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "cell_updates_per_second", cellUpdates / time, "1/s" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "effective_bandwidth", bytesPerCellMin * cellUpdates / time * 1E-9, "GB/s" );
+    }
+  }
+
+  /**
+   * Modelled number of operations (square roots or divisions) per cell update of a time step with tiles of the given size.
+   *
+   * A tile of w x h cells solves (w+1) h x-edges and w (h+1) y-edges. Every edge performs its own operations and those of its two cells.
+   * With the cell cache, the operations of the cells are performed once per cell of a row instead:
+   * for (w+2) h cells in the x-sweep and w (h+2) cells in the y-sweep.
+   *
+   * @param in_tileSizeX number of cells of a tile in x-direction.
+   * @param in_tileSizeY number of cells of a tile in y-direction.
+   * @param in_perEdge operations of an edge which do not depend on a single cell.
+   * @param in_perCell operations which depend on a single cell.
+   * @param in_cellCache true if the cell cache is used.
+   * @return operations per cell update.
+   **/
+  double operationsPerCell( tsunami_lab::idx in_tileSizeX,
+                            tsunami_lab::idx in_tileSizeY,
+                            double in_perEdge,
+                            double in_perCell,
+                            bool in_cellCache ) {
+    double w = double(in_tileSizeX);
+    double h = double(in_tileSizeY);
+    double edges = (w + 1) * h + w * (h + 1);
+    double cells = in_cellCache ? (w + 2) * h + w * (h + 2) : 2 * edges;
+    return (edges * in_perEdge + cells * in_perCell) / (w * h);
+  }
+
+  /**
+   * Measures the time steps of the patch with and without the cache of the cell quantities.
+   *
+   * @param in_name name of the solver in the report.
+   * @param in_sqrtPerEdge square roots of an edge which do not depend on a single cell.
+   * @param in_divisionsPerEdge divisions of an edge which do not depend on a single cell.
+   * @param in_sqrtPerCell square roots which depend on a single cell.
+   * @param in_divisionsPerCell divisions which depend on a single cell.
+   * @param io_stream stream to which the results are written.
+   *
+   * @tparam t_solver Riemann solver.
+   **/
+  template< typename t_solver >
+  void benchCellCache( std::string const & in_name,
+                       double in_sqrtPerEdge,
+                       double in_divisionsPerEdge,
+                       double in_sqrtPerCell,
+                       double in_divisionsPerCell,
+                       std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 1024;
+    tsunami_lab::idx const stepCount = 16;
+
+    // DAMBREAK2D setup of the driver scaled to the number of cells
+    tsunami_lab::setups::DamBreak2d damBreak( 10, 5, cellCount / 10, cellCount, cellCount, 1 );
+
+    double times[2] = { 0, 0 };
+    for( unsigned short cache = 0; cache < 2; cache++ ) {
+      tsunami_lab::patches::WavePropagation2d< t_solver > waveProp( cellCount, cellCount );
+      waveProp.setCellCache( cache == 1 );
+      for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+        for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+          waveProp.setHeight( x, y, damBreak.getHeight( x, y ) );
+          waveProp.setBathymetry( x, y, damBreak.getBathymetry( x, y ) );
+        }
+      }
+
+      tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+      times[cache] = tsunami_lab::benchmarks::Benchmark::median( 5, [&]() {
+        for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+          waveProp.setGhostOutflow( boundary );
+          waveProp.timeStep( 0.001 );
+        }
+      } );
+    }
+
+    double cellUpdates = double(cellCount) * cellCount * stepCount;
+
+    std::string name = "WavePropagation2d/cell_cache_" + in_name;
+    char const * configs[2] = { "/off", "/on" };
+    for( unsigned short cache = 0; cache < 2; cache++ ) {
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name + configs[cache], "time_per_cell_update", times[cache] / cellUpdates * 1E9, "ns" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name + configs[cache], "sqrt_per_cell_update",
+                                                  operationsPerCell( 256, 32, in_sqrtPerEdge, in_sqrtPerCell, cache == 1 ), "(model)" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name + configs[cache], "divisions_per_cell_update",
+                                                  operationsPerCell( 256, 32, in_divisionsPerEdge, in_divisionsPerCell, cache == 1 ), "(model)" );
+    }
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "speedup_cache", times[0] / times[1], "" );
+  }
+
+  void benchCellCaches( std::ostream & io_stream ) {
+    // f-wave: sqrt(h_Roe), the Roe velocity and the inverted determinant per edge; sqrt(h), hu/h and hu^2/h per cell
+    benchCellCache< tsunami_lab::solvers::FWave >( "fwave", 1, 2, 1, 2, io_stream );
+    // Roe: sqrt(h_Roe), the Roe velocity and the inverted determinant per edge; sqrt(h) and hu/h per cell
+    benchCellCache< tsunami_lab::solvers::Roe >( "roe", 1, 2, 1, 1, io_stream );
+  }
+
+  /**
+   * Measures the time steps of the early phase of a dam break in a large lake with and without skipping the tiles at rest.
+   *
+   * @param io_stream stream to which the results are written.
+   **/
+  void benchActivity( std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 1024;
+    tsunami_lab::idx const stepCount = 128;
+
+    // small dam in the center of the lake
+    tsunami_lab::setups::DamBreak2d damBreak( 10, 5, cellCount / 64, cellCount, cellCount, 1 );
+
+    double times[2] = { 0, 0 };
+    double activeFractions[2] = { 0, 0 };
+    for( unsigned short activity = 0; activity < 2; activity++ ) {
+      tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( cellCount, cellCount );
+      waveProp.setActivity( activity == 1, 0 );
+      for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+        for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+          waveProp.setHeight( x, y, damBreak.getHeight( x, y ) );
+          waveProp.setBathymetry( x, y, damBreak.getBathymetry( x, y ) );
+        }
+      }
+
+      tsunami_lab::Boundary boundary[2] = { tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW };
+
+      tsunami_lab::real speedMax = std::sqrt( tsunami_lab::real(9.80665) * 10 );
+      for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+        waveProp.setGhostOutflow( boundary );
+        double start = tsunami_lab::instrumentation::Profiler::now();
+        waveProp.timeStep( tsunami_lab::real(0.45) / speedMax );
+        times[activity] += tsunami_lab::instrumentation::Profiler::now() - start;
+
+        speedMax = waveProp.getWaveSpeedMax();
+        activeFractions[activity] += waveProp.getActiveFraction();
+      }
+    }
+
+    std::string name = "WavePropagation2d/activity";
+    char const * configs[2] = { "/off", "/on" };
+    for( unsigned short activity = 0; activity < 2; activity++ ) {
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name + configs[activity], "time_per_step", times[activity] / stepCount * 1E3, "ms" );
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name + configs[activity], "active_fraction", activeFractions[activity] / stepCount, "" );
+    }
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "speedup_activity", times[0] / times[1], "" );
+  }
+
+  /**
+   * Measures the time steps of a wave approaching a coastline with and without the classes of the edges.
+   *
+   * The synthetic coast resembles a continental margin: land behind a coastline which meanders with several wavelengths,
+   * a shelf in front of it and islands offshore, such that about a third of the domain is dry.
+   *
+   * @param io_stream stream to which the results are written.
+   **/
+  void benchEdgeClasses( std::ostream & io_stream ) {
+    tsunami_lab::idx const cellCount = 1024;
+    tsunami_lab::idx const stepCount = 16;
+    double const pi = 3.14159265358979323846;
+
+    std::vector< tsunami_lab::real > bathymetry( cellCount * cellCount );
+    for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+      double v = double(y) / cellCount;
+      double coast = cellCount * ( 0.65 + 0.06 * std::sin( 2 * pi * 3 * v ) + 0.03 * std::sin( 2 * pi * 11 * v + 1 ) + 0.01 * std::sin( 2 * pi * 37 * v + 2 ) );
+      for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+        // distance to the coast and to the closest of three islands in cells
+        double distance = coast - double(x);
+        double islands[3][3] = { { 0.45, 0.2, 30 }, { 0.5, 0.55, 18 }, { 0.4, 0.8, 40 } };
+        for( unsigned short island = 0; island < 3; island++ ) {
+          double dx = double(x) - islands[island][0] * cellCount;
+          double dy = double(y) - islands[island][1] * cellCount;
+          distance = std::min( distance, std::sqrt( dx * dx + dy * dy ) - islands[island][2] );
+        }
+
+        // land rises behind the coast, the shelf drops to the deep sea within 100 cells
+        bathymetry[y * cellCount + x] = tsunami_lab::real( distance < 0 ? 10 - distance / 10 : -std::min( 4000.0, 20 + 40 * distance ) );
+      }
+    }
+
+    // edges in x- and y-direction with a single dry cell
+    double wallCount = 0;
+    for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+      for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+        bool dry = bathymetry[y * cellCount + x] > 0;
+        if( x + 1 < cellCount && dry != ( bathymetry[y * cellCount + x + 1] > 0 ) ) wallCount++;
+        if( y + 1 < cellCount && dry != ( bathymetry[(y + 1) * cellCount + x] > 0 ) ) wallCount++;
+      }
+    }
+
+    double times[2] = { 0, 0 };
+    double skippedFraction = 0;
+    for( unsigned short classes = 0; classes < 2; classes++ ) {
+      tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( cellCount, cellCount );
+      waveProp.setEdgeClasses( classes == 1 );
+      for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+        for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+          // sea at rest with a wave offshore
+          tsunami_lab::real b = bathymetry[y * cellCount + x];
+          double dx = double(x) - 0.2 * cellCount;
+          tsunami_lab::real wave = tsunami_lab::real( 5 * std::exp( -dx * dx / 2000 ) );
+          waveProp.setHeight( x, y, b > 0 ? 0 : -b + wave );
+          waveProp.setBathymetry( x, y, b );
+        }
+      }
+
+      tsunami_lab::Boundary boundary[2] = { tsunami_lab::REFLECTING, tsunami_lab::REFLECTING };
+
+      times[classes] = tsunami_lab::benchmarks::Benchmark::median( 3, [&]() {
+        for( tsunami_lab::idx step = 0; step < stepCount; step++ ) {
+          waveProp.setGhostOutflow( boundary );
+          waveProp.timeStep( 0.001 );
+        }
+      } );
+      if( classes == 1 ) skippedFraction = waveProp.getSkippedFraction();
+    }
+
+    double edgeCount = 2.0 * cellCount * (cellCount + 1);
+
+    std::string name = "WavePropagation2d/edge_classes";
+    char const * configs[2] = { "/off", "/on" };
+    for( unsigned short classes = 0; classes < 2; classes++ ) {
+      tsunami_lab::benchmarks::Benchmark::report( io_stream, name + configs[classes], "time_per_step", times[classes] / stepCount * 1E3, "ms" );
+    }
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "skipped_fraction", skippedFraction, "" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "wall_fraction", wallCount / edgeCount, "" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "speedup_classes", times[0] / times[1], "" );
+  }
+
+  void benchTimeSteps( std::ostream & io_stream ) {
+    benchTimeStep< tsunami_lab::solvers::FWave >( "fwave", io_stream );
+    benchTimeStep< tsunami_lab::solvers::Roe >( "roe", io_stream );
+  }
+
+  tsunami_lab::benchmarks::Benchmark tiling( "WavePropagation2d/tiling", benchTiling );
+  tsunami_lab::benchmarks::Benchmark timeSteps( "WavePropagation2d/time_step", benchTimeSteps );
+  tsunami_lab::benchmarks::Benchmark cellCache( "WavePropagation2d/cell_cache", benchCellCaches );
+  tsunami_lab::benchmarks::Benchmark activity( "WavePropagation2d/activity", benchActivity );
+  tsunami_lab::benchmarks::Benchmark edgeClasses( "WavePropagation2d/edge_classes", benchEdgeClasses );
+  tsunami_lab::benchmarks::Benchmark strongScaling( "WavePropagation2d/strong_scaling", benchStrongScaling );
+  tsunami_lab::benchmarks::Benchmark splitting( "WavePropagation2d/splitting", benchSplitting );
+}
@@ -4,268 +4,672 @@
  * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
  *
  * @section DESCRIPTION
- * One-dimensional wave propagation patch.
+ * Two-dimensional wave propagation patch.
  **/
 #include "WavePropagation2d.h"
-#include "../../solvers/FWave.h"
-#include "../../solvers/Roe.h"
+#include "../../instrumentation/Profiler.h"
+#include <algorithm>
+#include <cmath>
 
 using namespace tsunami_lab::patches;
 
-WavePropagation2d::WavePropagation2d( idx in_cellCountX, idx in_cellCountY ) {
+template< typename t_solver >
+WavePropagation2d< t_solver >::WavePropagation2d( idx in_cellCountX,
+                                                  idx in_cellCountY,
+                                                  idx in_tileSizeX,
+                                                  idx in_tileSizeY,
+                                                  Splitting in_splitting ) {
 	cellCountX = in_cellCountX;
+	splitting = in_splitting;
 	cellCountY = in_cellCountY;
 
-	// allocate memory including a single ghost cell on each side
+	// a tile never exceeds the domain and contains at least one cell
+	tileSizeX = std::max( idx(1), std::min( in_tileSizeX, cellCountX ) );
+	tileSizeY = std::max( idx(1), std::min( in_tileSizeY, cellCountY ) );
+	tileCountX = (cellCountX + tileSizeX - 1) / tileSizeX;
+	tileCountY = (cellCountY + tileSizeY - 1) / tileSizeY;
+
+	// allocate memory including a single ghost cell on each side (initialized to zero)
+	for( unsigned short step = 0; step < 2; step++ ) {
+		height[step] = new Grid2d( cellCountX, cellCountY );
+		momentumX[step] = new Grid2d( cellCountX, cellCountY );
+		momentumY[step] = new Grid2d( cellCountX, cellCountY );
+	}
+	bathymetry = new Grid2d( cellCountX, cellCountY );
+}
+
+template< typename t_solver >
+WavePropagation2d< t_solver >::~WavePropagation2d() {
 	for( unsigned short step = 0; step < 2; step++ ) {
-		height[step] = new real*[ cellCountX + 2 ];
-		momentumX[step] = new real*[ cellCountX + 2 ];
-		momentumY[step] = new real*[ cellCountX + 2 ];
-		for ( idx x = 0; x < cellCountX + 2; x++) {
-			height[step][x] = new real[ cellCountY + 2];
-			momentumX[step][x] = new real[ cellCountY + 2];
-			momentumY[step][x] = new real[ cellCountY + 2];
+		delete height[step];
+		delete momentumX[step];
+		delete momentumY[step];
+	}
+	delete bathymetry;
+}
+
+template< typename t_solver >
+tsunami_lab::real WavePropagation2d< t_solver >::updateUnsplit( idx in_x0,
+                                                                idx in_x1,
+                                                                idx in_y0,
+                                                                idx in_y1,
+                                                                real in_scaling ) {
+	// tiles only update their own cells and read the old values, thus they are processed in parallel without synchronization;
+	// the tiles of the patch are clipped to the region, such that a region covers every tile at most once
+	idx tileFirstX = (in_x0 - 1) / tileSizeX;
+	idx tileFirstY = (in_y0 - 1) / tileSizeY;
+	idx regionTileCountX = (in_x1 - 2) / tileSizeX + 1 - tileFirstX;
+	idx regionTileCountY = (in_y1 - 2) / tileSizeY + 1 - tileFirstY;
+	idx tileCount = regionTileCountX * regionTileCountY;
+
+	unsigned short stepOld = step;
+	unsigned short stepNew = (step+1) % 2;
+
+	real speedMax = 0;
+	idx edgeCountSolved = 0;
+	idx edgeCountDry = 0;
+#pragma omp parallel reduction(max: speedMax) reduction(+: edgeCountSolved, edgeCountDry)
+	{
+		// edge buffers of the thread, which hold the edges of a tile's row
+		EdgeBatch edges( tileSizeX + 1, cellCache );
+
+		// the x- and y-edges of the old state are applied within the same tile pass
+#pragma omp for schedule(static)
+		for( idx tile = 0; tile < tileCount; tile++ ) {
+			idx tileX = tileFirstX + tile % regionTileCountX;
+			idx tileY = tileFirstY + tile / regionTileCountX;
+			idx tilePatch = tileY * tileCountX + tileX;
+
+			// the first and last tile in each direction might be smaller
+			idx x0 = std::max( in_x0, 1 + tileX * tileSizeX );
+			idx y0 = std::max( in_y0, 1 + tileY * tileSizeY );
+			idx x1 = std::min( 1 + (tileX + 1) * tileSizeX, in_x1 );
+			idx y1 = std::min( 1 + (tileY + 1) * tileSizeY, in_y1 );
+
+			if( !isActive( tilePatch ) ) {
+				copyTile( x0, x1, y0, y1, stepOld, stepNew );
+				continue;
+			}
+
+			real speed = sweepX( x0, x1, y0, y1, in_scaling, stepOld, stepNew, edges );
+			speed = std::max( speed, sweepY( x0, x1, y0, y1, in_scaling, stepOld, stepNew, stepNew, edges ) );
+			speedMax = std::max( speedMax, speed );
+
+			if( activity ) {
+				tileSpeed[tilePatch] = std::max( tileSpeed[tilePatch], speed );
+				if( hasChanged( x0, x1, y0, y1, stepOld, stepNew ) ) tileChanged[tilePatch] = 1;
+			}
 		}
+
+		edgeCountSolved += edges.solvedCount;
+		edgeCountDry += edges.skippedCount;
 	}
-	bathymetry = new real*[ cellCountX + 2 ];
-	for ( idx x = 0; x < cellCountX + 2; x++) {
-		bathymetry[x] = new real[ cellCountY + 2];
+	edgeCount += edgeCountSolved;
+	edgeCountSkipped += edgeCountDry;
+
+	return speedMax;
+}
+
+template< typename t_solver >
+void WavePropagation2d< t_solver >::timeStep( real in_scaling ) {
+	startActivity();
+	updateEdgeClasses();
+
+	if( splitting == UNSPLIT ) {
+		edgeCount = 0;
+		edgeCountSkipped = 0;
+		waveSpeedMax = updateUnsplit( 1, cellCountX + 1, 1, cellCountY + 1, in_scaling );
+		step = (step+1) % 2;
+		finishActivity();
+		return;
 	}
 
-	array1d = new real[ cellCountX * cellCountY ];
+	// tiles only update their own cells and read the values of the previous sweep, thus they are processed in parallel without synchronization
+	idx tileCount = tileCountX * tileCountY;
+
+	// buffers of the current state and of the intermediate state
+	unsigned short stepOld = step;
+	unsigned short stepNew = (step+1) % 2;
+
+	real speedMax = 0;
+	idx edgeCountSolved = 0;
+	idx edgeCountDry = 0;
+#pragma omp parallel reduction(max: speedMax) reduction(+: edgeCountSolved, edgeCountDry)
+	{
+		// edge buffers of the thread, which hold the edges of a tile's row
+		EdgeBatch edges( tileSizeX + 1, cellCache );
+
+		// first sweep in x-direction: old -> new
+#pragma omp for schedule(static)
+		for( idx tile = 0; tile < tileCount; tile++ ) {
+			// the last tile in each direction might be smaller
+			idx x0 = 1 + (tile % tileCountX) * tileSizeX;
+			idx y0 = 1 + (tile / tileCountX) * tileSizeY;
+			idx x1 = std::min( x0 + tileSizeX, cellCountX + 1 );
+			idx y1 = std::min( y0 + tileSizeY, cellCountY + 1 );
+
+			// a tile at rest holds the same values in both buffers, which are kept by the following sweeps
+			if( !isActive( tile ) ) {
+				copyTile( x0, x1, y0, y1, stepOld, stepNew );
+				continue;
+			}
 
-	// init to zero
-	for( unsigned short step = 0; step < 2; step++ ) {
-		for( idx y = 0; y < cellCountY + 2; y++ ) {
-			for( idx x = 0; x < cellCountX + 2; x++ ) {
-				height[step][x][y] = 0;
-				momentumX[step][x][y] = 0;
-				momentumY[step][x][y] = 0;
-				if( step == 0 ) {
-					bathymetry[x][y] = 0;
+			real scalingX = splitting == STRANG ? in_scaling / 2 : in_scaling;
+			real speed = sweepX( x0, x1, y0, y1, scalingX, stepOld, stepNew, edges );
+			speedMax = std::max( speedMax, speed );
+
+			if( activity ) {
+				tileSpeed[tile] = std::max( tileSpeed[tile], speed );
+				if( hasChanged( x0, x1, y0, y1, stepOld, stepNew ) ) tileChanged[tile] = 1;
+			}
+		}
+
+		// the y-sweep consumes the result of the x-sweep, including the neighbouring tiles' rows and the ghost cells
+#pragma omp single
+		setGhostCells( stepNew );
+
+#pragma omp for schedule(static)
+		for( idx tile = 0; tile < tileCount; tile++ ) {
+			if( !isActive( tile ) ) continue;
+
+			idx x0 = 1 + (tile % tileCountX) * tileSizeX;
+			idx y0 = 1 + (tile / tileCountX) * tileSizeY;
+			idx x1 = std::min( x0 + tileSizeX, cellCountX + 1 );
+			idx y1 = std::min( y0 + tileSizeY, cellCountY + 1 );
+
+			real speed = sweepY( x0, x1, y0, y1, in_scaling, stepNew, stepNew, stepOld, edges );
+			speedMax = std::max( speedMax, speed );
+
+			if( activity ) {
+				tileSpeed[tile] = std::max( tileSpeed[tile], speed );
+				if( hasChanged( x0, x1, y0, y1, stepNew, stepOld ) ) tileChanged[tile] = 1;
+			}
+		}
+
+		if( splitting == STRANG ) {
+			// second half step in x-direction
+#pragma omp single
+			setGhostCells( stepOld );
+
+#pragma omp for schedule(static)
+			for( idx tile = 0; tile < tileCount; tile++ ) {
+				if( !isActive( tile ) ) continue;
+
+				idx x0 = 1 + (tile % tileCountX) * tileSizeX;
+				idx y0 = 1 + (tile / tileCountX) * tileSizeY;
+				idx x1 = std::min( x0 + tileSizeX, cellCountX + 1 );
+				idx y1 = std::min( y0 + tileSizeY, cellCountY + 1 );
+
+				real speed = sweepX( x0, x1, y0, y1, in_scaling / 2, stepOld, stepNew, edges );
+				speedMax = std::max( speedMax, speed );
+
+				if( activity ) {
+					tileSpeed[tile] = std::max( tileSpeed[tile], speed );
+					if( hasChanged( x0, x1, y0, y1, stepOld, stepNew ) ) tileChanged[tile] = 1;
 				}
 			}
 		}
+
+		edgeCountSolved += edges.solvedCount;
+		edgeCountDry += edges.skippedCount;
 	}
+	edgeCount = edgeCountSolved;
+	edgeCountSkipped = edgeCountDry;
+
+	// the Godunov splitting ends in the buffers of the old state
+	step = splitting == GODUNOV ? stepOld : stepNew;
+	waveSpeedMax = speedMax;
+	finishActivity();
+}
+
+template< typename t_solver >
+void WavePropagation2d< t_solver >::setActivity( bool in_activity,
+                                                 real in_threshold ) {
+	activity = in_activity;
+	activityThreshold = in_threshold;
+	activeFraction = 1;
+
+	idx tileCount = activity ? tileCountX * tileCountY : 0;
+	tileActive.assign( tileCount, 1 );
+	tileChanged.assign( tileCount, 0 );
+	tileSpeed.assign( tileCount, 0 );
+	allActive = true;
+}
 
-	for ( idx cell = 0; cell < cellCountX * cellCountY; cell++ ) {
-		array1d[cell] = 0;
+template< typename t_solver >
+void WavePropagation2d< t_solver >::updateEdgeClasses() {
+	if( !edgeClassesEnabled ) return;
+
+	idx stride = bathymetry->getStride();
+	real const * bathymetryData = bathymetry->getData();
+	idx rowCount = cellCountY + 2;
+	idx cellCount = cellCountX + 2;
+
+	if( !edgeClassesValid ) {
+		edgeClasses.resize( cellCount, rowCount );
+
+		// the rows are independent words of the bitmask
+#pragma omp parallel for schedule(static)
+		for( idx y = 0; y < rowCount; y++ ) {
+			edgeClasses.setRow( y, cellCount, bathymetryData + y * stride );
+		}
+		edgeClassesValid = true;
+		return;
+	}
+
+	// the ghost cells might be set without a change of the patch's bathymetry, e.g., by the halo exchange of a distributed patch
+	edgeClasses.setRow( 0, cellCount, bathymetryData );
+	edgeClasses.setRow( rowCount - 1, cellCount, bathymetryData + (rowCount - 1) * stride );
+	for( idx y = 1; y < rowCount - 1; y++ ) {
+		edgeClasses.setCell( y, 0, bathymetryData[y * stride] );
+		edgeClasses.setCell( y, cellCount - 1, bathymetryData[y * stride + cellCount - 1] );
 	}
 }
 
-WavePropagation2d::~WavePropagation2d() {
-	for( unsigned short step = 0; step < 2; step++ ) {
-		for ( idx x = 0; x < cellCountX + 2; x++) {
-			delete height[step][x];
-			delete momentumX[step][x];
-			delete momentumY[step][x];
+template< typename t_solver >
+void WavePropagation2d< t_solver >::startActivity() {
+	if( !activity ) return;
+
+	idx tileCount = tileCountX * tileCountY;
+	for( idx tile = 0; tile < tileCount; tile++ ) {
+		if( allActive ) tileActive[tile] = 1;
+		if( tileActive[tile] ) tileSpeed[tile] = 0;
+		tileChanged[tile] = 0;
+	}
+	allActive = false;
+}
+
+template< typename t_solver >
+void WavePropagation2d< t_solver >::finishActivity() {
+	if( !activity ) return;
+
+	idx tileCount = tileCountX * tileCountY;
+	idx activeCount = 0;
+	real speedMax = 0;
+	for( idx tile = 0; tile < tileCount; tile++ ) {
+		activeCount += tileActive[tile];
+		speedMax = std::max( speedMax, tileSpeed[tile] );
+		tileActive[tile] = 0;
+	}
+	activeFraction = real(activeCount) / real(tileCount);
+
+	// the skipped tiles keep their waves
+	waveSpeedMax = speedMax;
+
+	// the update of a cell depends on the cells within one cell (two in x-direction for the Strang splitting)
+	idx rangeX = splitting == STRANG ? 2 : 1;
+	idx haloX = (rangeX + tileSizeX - 1) / tileSizeX;
+	idx haloY = 1;
+
+	for( idx tileY = 0; tileY < tileCountY; tileY++ ) {
+		for( idx tileX = 0; tileX < tileCountX; tileX++ ) {
+			if( !tileChanged[tileY * tileCountX + tileX] ) continue;
+
+			idx x0 = tileX > haloX ? tileX - haloX : 0;
+			idx y0 = tileY > haloY ? tileY - haloY : 0;
+			idx x1 = std::min( tileX + haloX + 1, tileCountX );
+			idx y1 = std::min( tileY + haloY + 1, tileCountY );
+			for( idx y = y0; y < y1; y++ ) {
+				std::fill( tileActive.begin() + y * tileCountX + x0, tileActive.begin() + y * tileCountX + x1, 1 );
+			}
 		}
-		delete[] height[step];
-		delete[] momentumX[step];
-		delete[] momentumY[step];
 	}
-	for ( idx x = 0; x < cellCountX + 2; x++) {
-		delete bathymetry[x];
+
+	// the ghost cells of the sides without domain boundary are set by the owner of the patch and might change in every time step
+	for( idx tileY = 0; tileY < tileCountY; tileY++ ) {
+		if( !domainBoundary[0] ) tileActive[tileY * tileCountX] = 1;
+		if( !domainBoundary[1] ) tileActive[tileY * tileCountX + tileCountX - 1] = 1;
+	}
+	for( idx tileX = 0; tileX < tileCountX; tileX++ ) {
+		if( !domainBoundary[2] ) tileActive[tileX] = 1;
+		if( !domainBoundary[3] ) tileActive[(tileCountY - 1) * tileCountX + tileX] = 1;
 	}
-	delete[] bathymetry;
 }
 
-void WavePropagation2d::timeStep( real in_scaling, Solver in_solver ) {
-	// pointers to old and new data
-	real ** heightOld = height[step];
-	real ** momentumXOld = momentumX[step];
-	real ** momentumYOld = momentumY[step];
-
-	step = (step+1) % 2;
-	real ** heightNew =	height[step];
-	real ** momentumXNew = momentumX[step];
-	real ** momentumYNew = momentumY[step];
-
-	// init new cell quantities
-	for( idx y = 1; y < cellCountY + 1; y++ ) {
-		for( idx x = 1; x < cellCountX + 1; x++) {
-			heightNew[x][y] = heightOld[x][y];
-			momentumXNew[x][y] = momentumXOld[x][y];
-			momentumYNew[x][y] = momentumYOld[x][y];
+template< typename t_solver >
+bool WavePropagation2d< t_solver >::hasChanged( idx in_x0,
+                                                idx in_x1,
+                                                idx in_y0,
+                                                idx in_y1,
+                                                unsigned short in_stepA,
+                                                unsigned short in_stepB ) const {
+	idx stride = bathymetry->getStride();
+
+	real const * heightA = height[in_stepA]->getData();
+	real const * momentumXA = momentumX[in_stepA]->getData();
+	real const * momentumYA = momentumY[in_stepA]->getData();
+	real const * heightB = height[in_stepB]->getData();
+	real const * momentumXB = momentumX[in_stepB]->getData();
+	real const * momentumYB = momentumY[in_stepB]->getData();
+
+	real change = 0;
+	for( idx y = in_y0; y < in_y1; y++ ) {
+#pragma omp simd reduction(max: change)
+		for( idx cell = y * stride + in_x0; cell < y * stride + in_x1; cell++ ) {
+			change = std::max( change, std::abs( heightB[cell] - heightA[cell] ) );
+			change = std::max( change, std::abs( momentumXB[cell] - momentumXA[cell] ) );
+			change = std::max( change, std::abs( momentumYB[cell] - momentumYA[cell] ) );
 		}
 	}
 
-	// iterate over edges and update with Riemann solutions in x-direction
-	for( idx y = 0; y < cellCountY + 2; y++ ) {
-		for( idx edgeX = 0; edgeX < cellCountX + 1; edgeX++ ) {
-			// determine cell-id
-			idx cellLeft = edgeX;
-			idx cellRight = edgeX+1;
-
-			// compute net-updates
-			real netUpdates[2][2];
-		
-			real stateLeft[3] = { heightOld[cellLeft][y], momentumXOld[cellLeft][y], bathymetry[cellLeft][y] };
-			real stateRight[3] = { heightOld[cellRight][y], momentumXOld[cellRight][y], bathymetry[cellRight][y] };
-
-			if(bathymetry[cellLeft][y] > 0) {
-				stateLeft[0] = stateRight[0];
-				stateLeft[1] = -stateRight[1];
-				stateLeft[2] = stateRight[2];
-			}
+	return change > activityThreshold;
+}
 
-			if(bathymetry[cellRight][y] > 0) {
-				stateRight[0] = stateLeft[0];
-				stateRight[1] = -stateLeft[1];
-				stateRight[2] = stateLeft[2];
-			}
+template< typename t_solver >
+void WavePropagation2d< t_solver >::copyTile( idx in_x0,
+                                              idx in_x1,
+                                              idx in_y0,
+                                              idx in_y1,
+                                              unsigned short in_stepIn,
+                                              unsigned short in_stepOut ) {
+	idx stride = bathymetry->getStride();
+
+	Grid2d const * gridsIn[3] = { height[in_stepIn], momentumX[in_stepIn], momentumY[in_stepIn] };
+	Grid2d * gridsOut[3] = { height[in_stepOut], momentumX[in_stepOut], momentumY[in_stepOut] };
+
+	for( unsigned short grid = 0; grid < 3; grid++ ) {
+		real const * dataIn = gridsIn[grid]->getData();
+		real * dataOut = gridsOut[grid]->getData();
+		for( idx y = in_y0; y < in_y1; y++ ) {
+			std::copy( dataIn + y * stride + in_x0, dataIn + y * stride + in_x1, dataOut + y * stride + in_x0 );
+		}
+	}
+}
 
-			if ( in_solver == FWAVE ) {
-				solvers::FWave::netUpdates( stateLeft, stateRight, netUpdates[0], netUpdates[1] );
-			} else {
-				solvers::Roe::netUpdates( stateLeft[0], stateRight[0], stateLeft[1], stateRight[1], netUpdates[0], netUpdates[1] );
-			}
+template< typename t_solver >
+tsunami_lab::real WavePropagation2d< t_solver >::sweepX( idx in_x0,
+                                                         idx in_x1,
+                                                         idx in_y0,
+                                                         idx in_y1,
+                                                         real in_scaling,
+                                                         unsigned short in_stepIn,
+                                                         unsigned short in_stepOut,
+                                                         EdgeBatch & io_edges ) {
+	instrumentation::ScopedTimer timer( instrumentation::Profiler::SWEEP_X );
+
+	idx stride = bathymetry->getStride();
+
+	real const * heightIn = height[in_stepIn]->getData();
+	real const * momentumXIn = momentumX[in_stepIn]->getData();
+	real const * momentumYIn = momentumY[in_stepIn]->getData();
+
+	real * heightOut = height[in_stepOut]->getData();
+	real * momentumXOut = momentumX[in_stepOut]->getData();
+	real * momentumYOut = momentumY[in_stepOut]->getData();
+
+	real const * bathymetryData = bathymetry->getData();
+
+	real const * netUpdateLeftHeight = io_edges.netUpdateLeftHeight.data();
+	real const * netUpdateLeftMomentum = io_edges.netUpdateLeftMomentum.data();
+	real const * netUpdateRightHeight = io_edges.netUpdateRightHeight.data();
+	real const * netUpdateRightMomentum = io_edges.netUpdateRightMomentum.data();
+
+	// the updates are accumulated in realCompute, i.e., in double precision for mixed precision builds
+	realCompute scaling = in_scaling;
+
+	real speedMax = 0;
+
+	// the edges of a row are left of the cells [in_x0-1, in_x1)
+	idx edgeCount = in_x1 - in_x0 + 1;
+	for( idx y = in_y0; y < in_y1; y++ ) {
+		idx cellLeft = y * stride + in_x0 - 1;
+
+		// the cells [in_x0-1, in_x1] bound the edges: edge i is located between the cells i and i+1 of the row
+		EdgeBatch::CellRow * cells = nullptr;
+		if( cellCache ) {
+			cells = &io_edges.cellRows[0];
+			io_edges.template computeCells< t_solver >( *cells, edgeCount + 1, heightIn + cellLeft, momentumXIn + cellLeft );
+		}
 
-			// update the cells' quantities
-			heightNew[cellLeft][y] -= in_scaling * netUpdates[0][0];
-			momentumXNew[cellLeft][y] -= in_scaling * netUpdates[0][1];
+		if( edgeClassesEnabled ) {
+			speedMax = io_edges.template solveClassified< t_solver >( edgeCount,
+			                                                          heightIn + cellLeft, heightIn + cellLeft + 1,
+			                                                          momentumXIn + cellLeft, momentumXIn + cellLeft + 1,
+			                                                          bathymetryData + cellLeft, bathymetryData + cellLeft + 1,
+			                                                          edgeClasses,
+			                                                          y, in_x0 - 1,
+			                                                          y, in_x0,
+			                                                          cells, 0,
+			                                                          cells, 1,
+			                                                          speedMax );
+		}
+		else if( cellCache ) {
+			io_edges.gatherCached( edgeCount,
+			                       heightIn + cellLeft, heightIn + cellLeft + 1,
+			                       momentumXIn + cellLeft, momentumXIn + cellLeft + 1,
+			                       bathymetryData + cellLeft, bathymetryData + cellLeft + 1,
+			                       *cells, 0,
+			                       *cells, 1 );
+			speedMax = io_edges.template solveCached< t_solver >( edgeCount, speedMax );
+		}
+		else {
+			io_edges.gather( edgeCount,
+			                 heightIn + cellLeft, heightIn + cellLeft + 1,
+			                 momentumXIn + cellLeft, momentumXIn + cellLeft + 1,
+			                 bathymetryData + cellLeft, bathymetryData + cellLeft + 1 );
+			speedMax = io_edges.template solve< t_solver >( edgeCount, speedMax );
+		}
 
-			heightNew[cellRight][y]	-= in_scaling * netUpdates[1][0];
-			momentumXNew[cellRight][y] -= in_scaling * netUpdates[1][1];
+		// every cell of the tile receives the update of its left edge first, then the one of its right edge;
+		// the intermediate value is rounded to real as in the y-sweep, which keeps both sweeps symmetric
+		idx cellFirst = cellLeft + 1;
+#pragma omp simd
+		for( idx edge = 0; edge < edgeCount - 1; edge++ ) {
+			idx cell = cellFirst + edge;
+			heightOut[cell] = real( real( heightIn[cell] - scaling * netUpdateRightHeight[edge] ) - scaling * netUpdateLeftHeight[edge+1] );
+			momentumXOut[cell] = real( real( momentumXIn[cell] - scaling * netUpdateRightMomentum[edge] ) - scaling * netUpdateLeftMomentum[edge+1] );
+			momentumYOut[cell] = momentumYIn[cell];
 		}
 	}
 
-	// iterate over edges and update with Riemann solutions in y-direction
-	for( idx x = 0; x < cellCountX + 2; x++ ) {
-		for( idx edgeY = 0; edgeY < cellCountX + 1; edgeY++ ) {
-			// determine cell-id
-			idx cellTop = edgeY+1;
-			idx cellBottom = edgeY;
-
-			// compute net-updates
-			real netUpdates[2][2];
-		
-			real stateLeft[3] = { heightOld[x][cellBottom], momentumYOld[x][cellBottom], bathymetry[x][cellBottom] };
-			real stateRight[3] = { heightOld[x][cellTop], momentumYOld[x][cellTop], bathymetry[x][cellTop] };
-
-			if(bathymetry[x][cellBottom] > 0) {
-				stateLeft[0] = stateRight[0];
-				stateLeft[1] = -stateRight[1];
-				stateLeft[2] = stateRight[2];
-			}
+	return speedMax;
+}
 
-			if(bathymetry[x][cellTop] > 0) {
-				stateRight[0] = stateLeft[0];
-				stateRight[1] = -stateLeft[1];
-				stateRight[2] = stateLeft[2];
+template< typename t_solver >
+tsunami_lab::real WavePropagation2d< t_solver >::sweepY( idx in_x0,
+                                                         idx in_x1,
+                                                         idx in_y0,
+                                                         idx in_y1,
+                                                         real in_scaling,
+                                                         unsigned short in_stepEdges,
+                                                         unsigned short in_stepIn,
+                                                         unsigned short in_stepOut,
+                                                         EdgeBatch & io_edges ) {
+	instrumentation::ScopedTimer timer( instrumentation::Profiler::SWEEP_Y );
+
+	idx stride = bathymetry->getStride();
+
+	real const * heightEdges = height[in_stepEdges]->getData();
+	real const * momentumYEdges = momentumY[in_stepEdges]->getData();
+
+	real const * heightIn = height[in_stepIn]->getData();
+	real const * momentumXIn = momentumX[in_stepIn]->getData();
+	real const * momentumYIn = momentumY[in_stepIn]->getData();
+
+	real * heightOut = height[in_stepOut]->getData();
+	real * momentumXOut = momentumX[in_stepOut]->getData();
+	real * momentumYOut = momentumY[in_stepOut]->getData();
+
+	real const * bathymetryData = bathymetry->getData();
+
+	real const * netUpdateLeftHeight = io_edges.netUpdateLeftHeight.data();
+	real const * netUpdateLeftMomentum = io_edges.netUpdateLeftMomentum.data();
+	real const * netUpdateRightHeight = io_edges.netUpdateRightHeight.data();
+	real const * netUpdateRightMomentum = io_edges.netUpdateRightMomentum.data();
+
+	// the updates are accumulated in realCompute, i.e., in double precision for mixed precision builds
+	realCompute scaling = in_scaling;
+
+	real speedMax = 0;
+
+	// rows of edges between the rows of cells [in_y0-1, in_y1)
+	idx edgeCount = in_x1 - in_x0;
+	for( idx edgeY = in_y0 - 1; edgeY < in_y1; edgeY++ ) {
+		idx cellBottom = edgeY * stride + in_x0;
+		idx cellTop = cellBottom + stride;
+
+		EdgeBatch::CellRow * cellsBottom = nullptr;
+		EdgeBatch::CellRow * cellsTop = nullptr;
+		if( cellCache ) {
+			// the top row of cells of this edge row is the bottom row of the next one; the edge states are not written by the sweep
+			idx edgeRow = edgeY + 1 - in_y0;
+			cellsBottom = &io_edges.cellRows[edgeRow % 2];
+			cellsTop = &io_edges.cellRows[(edgeRow + 1) % 2];
+			if( edgeRow == 0 ) {
+				io_edges.template computeCells< t_solver >( *cellsBottom, edgeCount, heightEdges + cellBottom, momentumYEdges + cellBottom );
 			}
+			io_edges.template computeCells< t_solver >( *cellsTop, edgeCount, heightEdges + cellTop, momentumYEdges + cellTop );
+		}
 
-			if ( in_solver == FWAVE ) {
-				solvers::FWave::netUpdates( stateLeft, stateRight, netUpdates[0], netUpdates[1] );
-			} else {
-				solvers::Roe::netUpdates( stateLeft[0], stateRight[0], stateLeft[1], stateRight[1], netUpdates[0], netUpdates[1] );
+		if( edgeClassesEnabled ) {
+			speedMax = io_edges.template solveClassified< t_solver >( edgeCount,
+			                                                          heightEdges + cellBottom, heightEdges + cellTop,
+			                                                          momentumYEdges + cellBottom, momentumYEdges + cellTop,
+			                                                          bathymetryData + cellBottom, bathymetryData + cellTop,
+			                                                          edgeClasses,
+			                                                          edgeY, in_x0,
+			                                                          edgeY + 1, in_x0,
+			                                                          cellsBottom, 0,
+			                                                          cellsTop, 0,
+			                                                          speedMax );
+		}
+		else if( cellCache ) {
+			io_edges.gatherCached( edgeCount,
+			                       heightEdges + cellBottom, heightEdges + cellTop,
+			                       momentumYEdges + cellBottom, momentumYEdges + cellTop,
+			                       bathymetryData + cellBottom, bathymetryData + cellTop,
+			                       *cellsBottom, 0,
+			                       *cellsTop, 0 );
+			speedMax = io_edges.template solveCached< t_solver >( edgeCount, speedMax );
+		}
+		else {
+			io_edges.gather( edgeCount,
+			                 heightEdges + cellBottom, heightEdges + cellTop,
+			                 momentumYEdges + cellBottom, momentumYEdges + cellTop,
+			                 bathymetryData + cellBottom, bathymetryData + cellTop );
+			speedMax = io_edges.template solve< t_solver >( edgeCount, speedMax );
+		}
+
+		// the top row receives its first update, the bottom row (initialized by the previous row of edges) its second one
+		if( edgeY + 1 < in_y1 ) {
+			if( in_stepIn != in_stepOut ) {
+				std::copy( momentumXIn + cellTop, momentumXIn + cellTop + edgeCount, momentumXOut + cellTop );
 			}
 
-			// update the cells' quantities
-			heightNew[x][cellBottom] -= in_scaling * netUpdates[0][0];
-			momentumYNew[x][cellBottom] -= in_scaling * netUpdates[0][1];
+#pragma omp simd
+			for( idx edge = 0; edge < edgeCount; edge++ ) {
+				heightOut[cellTop + edge] = real( heightIn[cellTop + edge] - scaling * netUpdateRightHeight[edge] );
+				momentumYOut[cellTop + edge] = real( momentumYIn[cellTop + edge] - scaling * netUpdateRightMomentum[edge] );
+			}
+		}
 
-			heightNew[x][cellTop] -= in_scaling * netUpdates[1][0];
-			momentumYNew[x][cellTop] -= in_scaling * netUpdates[1][1];
+		if( edgeY >= in_y0 ) {
+#pragma omp simd
+			for( idx edge = 0; edge < edgeCount; edge++ ) {
+				heightOut[cellBottom + edge] = real( heightOut[cellBottom + edge] - scaling * netUpdateLeftHeight[edge] );
+				momentumYOut[cellBottom + edge] = real( momentumYOut[cellBottom + edge] - scaling * netUpdateLeftMomentum[edge] );
+			}
 		}
 	}
+
+	return speedMax;
 }
 
-void WavePropagation2d::copyGhostCellsOutflow( real ** out_grid ) {
+template< typename t_solver >
+void WavePropagation2d< t_solver >::copyGhostCellsOutflow( Grid2d & out_grid ) {
 	idx xMax = cellCountX+1;
 	idx yMax = cellCountY+1;
 
 	for( idx x = 1; x < xMax; x++ ) {
-		out_grid[x][0] = out_grid[x][1];
-		out_grid[x][yMax] = out_grid[x][yMax-1];
+		if( domainBoundary[2] ) out_grid(x, 0) = out_grid(x, 1);
+		if( domainBoundary[3] ) out_grid(x, yMax) = out_grid(x, yMax-1);
 	}
 
 	for( idx y = 1; y < yMax; y++ ) {
-		out_grid[0][y] = out_grid[1][y];
-		out_grid[xMax][y] = out_grid[xMax-1][y];
+		if( domainBoundary[0] ) out_grid(0, y) = out_grid(1, y);
+		if( domainBoundary[1] ) out_grid(xMax, y) = out_grid(xMax-1, y);
 	}
 
-	out_grid[0][0] = out_grid[1][1];
-	out_grid[xMax][0] = out_grid[xMax-1][1];
-	out_grid[0][yMax] = out_grid[1][yMax-1];
-	out_grid[xMax][yMax] = out_grid[xMax-1][yMax-1];
+	// the corners are not read by the sweeps
+	out_grid(0, 0) = out_grid(1, 1);
+	out_grid(xMax, 0) = out_grid(xMax-1, 1);
+	out_grid(0, yMax) = out_grid(1, yMax-1);
+	out_grid(xMax, yMax) = out_grid(xMax-1, yMax-1);
 }
 
-void WavePropagation2d::copyGhostCellsReflecting( real ** out_grid, real in_value ) {
+template< typename t_solver >
+void WavePropagation2d< t_solver >::copyGhostCellsReflecting( Grid2d & out_grid, real in_value ) {
 	idx xMax = cellCountX+1;
 	idx yMax = cellCountY+1;
 
 	for( idx x = 1; x < xMax; x++ ) {
-		out_grid[x][0] = in_value;
-		out_grid[x][yMax] = in_value;
+		if( domainBoundary[2] ) out_grid(x, 0) = in_value;
+		if( domainBoundary[3] ) out_grid(x, yMax) = in_value;
 	}
 
 	for( idx y = 1; y < yMax; y++ ) {
-		out_grid[0][y] = in_value;
-		out_grid[xMax][y] = in_value;
+		if( domainBoundary[0] ) out_grid(0, y) = in_value;
+		if( domainBoundary[1] ) out_grid(xMax, y) = in_value;
 	}
 
-	out_grid[0][0] = in_value;
-	out_grid[xMax][0] = in_value;
-	out_grid[0][yMax] = in_value;
-	out_grid[xMax][yMax] = in_value;
+	out_grid(0, 0) = in_value;
+	out_grid(xMax, 0) = in_value;
+	out_grid(0, yMax) = in_value;
+	out_grid(xMax, yMax) = in_value;
 }
 
-void WavePropagation2d::setGhostOutflow( Boundary in_boundary[2] ) {
-	// set left boundary
-	if(in_boundary[0] == OUTFLOW) {
-		copyGhostCellsOutflow( height[step] );
-		copyGhostCellsOutflow( momentumX[step] );
-		copyGhostCellsOutflow( momentumY[step] );
-		copyGhostCellsOutflow( bathymetry );
-	} else if (in_boundary[0] == REFLECTING) {
-		copyGhostCellsReflecting( height[step], 0 );
-		copyGhostCellsReflecting( momentumX[step], 0 );
-		copyGhostCellsReflecting( momentumY[step], 0 );
-		copyGhostCellsReflecting( bathymetry, 20 );
-	}	
-}
-
-void WavePropagation2d::linearizeArray(real ** in_array2d, real * out_array1d) {
-	for(idx y = 0; y < cellCountY; y++) {
-		for(tsunami_lab::idx x = 0; x < cellCountX; x++) {
-			out_array1d[x + y*cellCountX] = in_array2d[x+1][y+1];
-		}
-	}
-}
-
-tsunami_lab::real const * WavePropagation2d::getHeight() {
-	real * height1d = new real[ cellCountX * cellCountY ];
-	for ( idx cell = 0; cell < cellCountX * cellCountY; cell++ ) {
-		height1d[cell] = 0;
+template< typename t_solver >
+void WavePropagation2d< t_solver >::setGhostCells( unsigned short in_step ) {
+	if( boundary == OUTFLOW ) {
+		copyGhostCellsOutflow( *height[in_step] );
+		copyGhostCellsOutflow( *momentumX[in_step] );
+		copyGhostCellsOutflow( *momentumY[in_step] );
+	} else if( boundary == REFLECTING ) {
+		copyGhostCellsReflecting( *height[in_step], 0 );
+		copyGhostCellsReflecting( *momentumX[in_step], 0 );
+		copyGhostCellsReflecting( *momentumY[in_step], 0 );
 	}
-	linearizeArray(height[step], height1d);
-	return height1d;
 }
 
-tsunami_lab::real const * WavePropagation2d::getMomentumX() {
-	real * momentumX1d = new real[ cellCountX * cellCountY ];
-	for ( idx cell = 0; cell < cellCountX * cellCountY; cell++ ) {
-		momentumX1d[cell] = 0;
+template< typename t_solver >
+void WavePropagation2d< t_solver >::setGhostOutflow( Boundary in_boundary[2] ) {
+	// set left boundary
+	if( in_boundary[0] != boundary ) allActive = true;
+	boundary = in_boundary[0];
+	setGhostCells( step );
+
+	if(boundary == OUTFLOW) {
+		copyGhostCellsOutflow( *bathymetry );
+	} else if (boundary == REFLECTING) {
+		copyGhostCellsReflecting( *bathymetry, 20 );
 	}
-	linearizeArray(momentumX[step], momentumX1d);
-	return momentumX1d;
 }
 
-tsunami_lab::real const * WavePropagation2d::getMomentumY() {
-	real * momentumY1d = new real[ cellCountX * cellCountY ];
-	for ( idx cell = 0; cell < cellCountX * cellCountY; cell++ ) {
-		momentumY1d[cell] = 0;
+template< typename t_solver >
+void WavePropagation2d< t_solver >::setValues( idx in_x,
+                                               idx in_y,
+                                               idx in_countX,
+                                               idx in_countY,
+                                               idx in_stride,
+                                               real const * in_height,
+                                               real const * in_momentumX,
+                                               real const * in_momentumY,
+                                               real const * in_bathymetry ) {
+	allActive = true;
+	edgeClassesValid = false;
+
+	real const * fields[4] = { in_height, in_momentumX, in_momentumY, in_bathymetry };
+	Grid2d * grids[4] = { height[step], momentumX[step], momentumY[step], bathymetry };
+
+	for( unsigned short field = 0; field < 4; field++ ) {
+		for( idx y = 0; y < in_countY; y++ ) {
+			real const * rowIn = fields[field] + y * in_stride;
+			real * rowOut = grids[field]->getRow( in_y+y+1 ) + in_x+1;
+			std::copy( rowIn, rowIn + in_countX, rowOut );
+		}
 	}
-	linearizeArray(momentumY[step], momentumY1d);
-	return momentumY1d;
 }
 
-tsunami_lab::real const * WavePropagation2d::getBathymetry() {
-	real * bathymetry1d = new real[ cellCountX * cellCountY ];
-	for ( idx cell = 0; cell < cellCountX * cellCountY; cell++ ) {
-		bathymetry1d[cell] = 0;
-	}
-	linearizeArray(bathymetry, bathymetry1d);
-	return bathymetry1d;
-}
\ No newline at end of file
+// instantiations for the available solvers
+template class tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave >;
+template class tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::Roe >;
@@ -10,15 +10,32 @@
 #define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D
 
 #include "../WavePropagation.h"
+#include "../Grid2d/Grid2d.h"
+#include "../EdgeBatch.h"
+#include "../EdgeClasses.h"
+#include "../../solvers/FWave.h"
+#include "../../solvers/Roe.h"
+#include <atomic>
+#include <vector>
 
 namespace tsunami_lab {
 	namespace patches {
+		template< typename t_solver >
 		class WavePropagation2d;
 	}
 }
 
+/**
+ * Two-dimensional wave propagation patch.
+ *
+ * The patch is templated on the Riemann solver (solvers::FWave or solvers::Roe), which is called through the common
+ * netUpdates interface of the solvers. Thus, the solver is selected once at construction and inlined into the edge loops.
+ *
+ * @tparam t_solver Riemann solver.
+ **/
+template< typename t_solver >
 class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
-	private:
+	protected:
 		//! current step which indicates the active values in the arrays below
 		unsigned short step = 0;
 
@@ -27,33 +44,247 @@ class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
 		idx cellCountY = 0;
 
 		//! water heights for the current and next time step for all cells
-		real ** height[2] = { nullptr, nullptr };
+		Grid2d * height[2] = { nullptr, nullptr };
 
 		//! momenta for the current and next time step for all cells in x-direction
-		real ** momentumX[2] = { nullptr, nullptr };
+		Grid2d * momentumX[2] = { nullptr, nullptr };
 
 		//! momenta for the current and next time step for all cells in y-direction
-		real ** momentumY[2] = { nullptr, nullptr };
-
-		//! array used to convert 2d array into 1d
-		real * array1d;
+		Grid2d * momentumY[2] = { nullptr, nullptr };
 
 		//! bathymetry for all cells
-		real ** bathymetry;
+		Grid2d * bathymetry = nullptr;
+
+		//! number of cells of a tile in x- and y-direction
+		idx tileSizeX = 0;
+		idx tileSizeY = 0;
+
+		//! maximum wave speed of the last time step
+		real waveSpeedMax = 0;
+
+		//! treatment of the x- and y-edges within a time step
+		Splitting splitting = UNSPLIT;
+
+		//! boundary condition of the ghost cells, set by setGhostOutflow
+		Boundary boundary = OUTFLOW;
+
+		//! number of edges solved in the last time step
+		idx edgeCount = 0;
+
+		//! number of edges between two dry cells skipped in the last time step
+		idx edgeCountSkipped = 0;
+
+		//! true if the sweeps use the precomputed classes of the edges instead of gathering the edges
+		bool edgeClassesEnabled = true;
+
+		//! dry cells of the patch including the ghost cells, which classify the edges
+		EdgeClasses edgeClasses;
+
+		//! false if the bathymetry changed since the classes were computed; regions might be set concurrently
+		std::atomic< bool > edgeClassesValid{ false };
+
+		//! true if the quantities shared by the edges of a cell are computed once per cell and sweep
+		bool cellCache = false;
+
+		//! sides of the patch (-x, x, -y, y) which are boundaries of the domain; the ghost cells of the others are set by the owner of the patch
+		bool domainBoundary[4] = { true, true, true, true };
+
+		//! true if the tiles at rest are skipped
+		bool activity = false;
+
+		//! largest change of a cell's height or momenta in a sweep at which the cell is considered at rest
+		real activityThreshold = 0;
+
+		//! number of tiles of the patch in x- and y-direction; the tiles start at the first non-ghost cell
+		idx tileCountX = 0;
+		idx tileCountY = 0;
+
+		//! tiles which are solved in the current (during a time step) or next time step
+		std::vector< unsigned char > tileActive;
+
+		//! tiles of which a cell changed in the current time step
+		std::vector< unsigned char > tileChanged;
+
+		//! maximum wave speed of the tiles' edges when they were solved last; kept for the skipped tiles
+		std::vector< real > tileSpeed;
+
+		//! true if all tiles are solved in the next time step, e.g., after values of cells were set; regions might be set concurrently
+		std::atomic< bool > allActive{ true };
+
+		//! fraction of the tiles solved in the last time step
+		real activeFraction = 1;
+
+		/**
+		 * @brief Computes the classes of the edges if the bathymetry changed and updates the ghost cells of the classes.
+		 **/
+		void updateEdgeClasses();
+
+		/**
+		 * @brief Starts the activity tracking of a time step: the tiles of the map and the ones set by allActive are solved.
+		 **/
+		void startActivity();
 
-		
-		void linearizeArray(real ** in_array2d, real * out_array1d);
-		void copyGhostCellsOutflow( real ** out_grid );
-		void copyGhostCellsReflecting( real ** out_grid, real in_value );
+		/**
+		 * @brief Finishes the activity tracking of a time step.
+		 *
+		 * Sets activeFraction and the maximum wave speed of all tiles, including the skipped ones.
+		 * The tiles which changed and their neighbours within the dependency range of the scheme (a single tile unless the tiles are narrower
+		 * than the stencil of the sweeps) are solved in the next time step, the tiles at sides without domain boundary in every time step.
+		 **/
+		void finishActivity();
+
+		/**
+		 * @brief Checks if a tile is solved in the current time step.
+		 *
+		 * @param in_tile id of the tile.
+		 * @return true if the tile is solved, false if it is at rest.
+		 **/
+		bool isActive( idx in_tile ) const {
+			return !activity || tileActive[in_tile] != 0;
+		}
+
+		/**
+		 * @brief Checks if the height or a momentum of a cell in [in_x0, in_x1) x [in_y0, in_y1) differs by more than the activity threshold between two buffers.
+		 *
+		 * @param in_x0 first cell of the tile in x-direction (including the ghost cell offset).
+		 * @param in_x1 first cell in x-direction behind the tile.
+		 * @param in_y0 first cell of the tile in y-direction (including the ghost cell offset).
+		 * @param in_y1 first cell in y-direction behind the tile.
+		 * @param in_stepA first buffers.
+		 * @param in_stepB second buffers.
+		 * @return true if a cell changed.
+		 **/
+		bool hasChanged( idx in_x0,
+		                 idx in_x1,
+		                 idx in_y0,
+		                 idx in_y1,
+		                 unsigned short in_stepA,
+		                 unsigned short in_stepB ) const;
+
+		/**
+		 * @brief Copies the heights and momenta of the cells [in_x0, in_x1) x [in_y0, in_y1) of a skipped tile.
+		 *
+		 * @param in_x0 first cell of the tile in x-direction (including the ghost cell offset).
+		 * @param in_x1 first cell in x-direction behind the tile.
+		 * @param in_y0 first cell of the tile in y-direction (including the ghost cell offset).
+		 * @param in_y1 first cell in y-direction behind the tile.
+		 * @param in_stepIn buffers which are read.
+		 * @param in_stepOut buffers which are written.
+		 **/
+		void copyTile( idx in_x0,
+		               idx in_x1,
+		               idx in_y0,
+		               idx in_y1,
+		               unsigned short in_stepIn,
+		               unsigned short in_stepOut );
+
+		/**
+		 * @brief Applies the x- and y-edges of the old state to the cells [in_x0, in_x1) x [in_y0, in_y1), writing the new state (unsplit scheme).
+		 *
+		 * The region is processed by the threads in the tiles of the patch, clipped to the region. The result of a cell does not depend on the region,
+		 * i.e., the cells may be updated in any partition of regions.
+		 * The number of solved edges is added to edgeCount, the one of the skipped dry edges to edgeCountSkipped. Tiles at rest are copied if the activity tracking is enabled.
+		 *
+		 * @param in_x0 first cell of the region in x-direction (including the ghost cell offset).
+		 * @param in_x1 first cell in x-direction behind the region.
+		 * @param in_y0 first cell of the region in y-direction (including the ghost cell offset).
+		 * @param in_y1 first cell in y-direction behind the region.
+		 * @param in_scaling scaling of the time step (dt / dx).
+		 * @return maximum wave speed of the edges solved in the region.
+		 **/
+		real updateUnsplit( idx in_x0,
+		                    idx in_x1,
+		                    idx in_y0,
+		                    idx in_y1,
+		                    real in_scaling );
+
+		/**
+		 * @brief Applies the x-edges adjacent to the cells [in_x0, in_x1) x [in_y0, in_y1) of a tile.
+		 *
+		 * The edges are processed row by row through the edge buffers (gather, solve, scatter), or solved in place by their classes.
+		 * Edges on the border of the tile are solved by both neighbouring tiles, each only updating its own cells.
+		 * Thus, tiles are independent of each other (and processed by different threads without races) and
+		 * every cell sees the same updates in the same order as in an unblocked sweep.
+		 * The momenta in y-direction are copied.
+		 *
+		 * @param in_x0 first cell of the tile in x-direction (including the ghost cell offset).
+		 * @param in_x1 first cell in x-direction behind the tile.
+		 * @param in_y0 first cell of the tile in y-direction (including the ghost cell offset).
+		 * @param in_y1 first cell in y-direction behind the tile.
+		 * @param in_scaling scaling of the time step (dt / dx).
+		 * @param in_stepIn buffers which are read.
+		 * @param in_stepOut buffers which are written; different from in_stepIn.
+		 * @param io_edges edge buffers of the calling thread; hold at least in_x1 - in_x0 + 1 edges.
+		 * @return maximum wave speed of the edges solved by the tile.
+		 **/
+		real sweepX( idx in_x0,
+		             idx in_x1,
+		             idx in_y0,
+		             idx in_y1,
+		             real in_scaling,
+		             unsigned short in_stepIn,
+		             unsigned short in_stepOut,
+		             EdgeBatch & io_edges );
+
+		/**
+		 * @brief Applies the y-edges adjacent to the cells [in_x0, in_x1) x [in_y0, in_y1) of a tile.
+		 *
+		 * The states of the edges and the values which are updated are given separately:
+		 * the unsplit scheme solves the edges of the old state and updates the result of the x-sweep in place,
+		 * the split schemes solve and update the result of the x-sweep, writing to the other buffers.
+		 * The momenta in x-direction are copied.
+		 *
+		 * @param in_x0 first cell of the tile in x-direction (including the ghost cell offset).
+		 * @param in_x1 first cell in x-direction behind the tile.
+		 * @param in_y0 first cell of the tile in y-direction (including the ghost cell offset).
+		 * @param in_y1 first cell in y-direction behind the tile.
+		 * @param in_scaling scaling of the time step (dt / dy).
+		 * @param in_stepEdges buffers of which the edges are solved.
+		 * @param in_stepIn buffers which are updated.
+		 * @param in_stepOut buffers which are written; either in_stepIn or different from in_stepEdges.
+		 * @param io_edges edge buffers of the calling thread; hold at least in_x1 - in_x0 edges.
+		 * @return maximum wave speed of the edges solved by the tile.
+		 **/
+		real sweepY( idx in_x0,
+		             idx in_x1,
+		             idx in_y0,
+		             idx in_y1,
+		             real in_scaling,
+		             unsigned short in_stepEdges,
+		             unsigned short in_stepIn,
+		             unsigned short in_stepOut,
+		             EdgeBatch & io_edges );
+
+		/**
+		 * @brief Sets the ghost cells of the water heights and momenta according to the boundary condition.
+		 *
+		 * Only the sides in domainBoundary are set.
+		 *
+		 * @param in_step buffers whose ghost cells are set.
+		 **/
+		virtual void setGhostCells( unsigned short in_step );
+
+		void copyGhostCellsOutflow( Grid2d & out_grid );
+		void copyGhostCellsReflecting( Grid2d & out_grid, real in_value );
 
 	public:
 		/**
 		 * @brief Constructs the 2d wave propagation solver.
 		 *
+		 * The default tile size of 256 x 32 cells keeps the working set of a tile (~230 KiB in single precision) in the L2 cache.
+		 *
 		 * @param in_cellCountX number of cells in x-direction.
 		 * @param in_cellCountY number of cells in y-direction.
+		 * @param in_tileSizeX number of cells of a tile in x-direction.
+		 * @param in_tileSizeY number of cells of a tile in y-direction.
+		 * @param in_splitting UNSPLIT: x- and y-edges are solved on the old state; GODUNOV: the y-sweep consumes the result of the x-sweep;
+		 *                     STRANG: half x-sweep, y-sweep, half x-sweep. The split schemes are stable up to a CFL number of 1 instead of 1/2.
 		 **/
-		WavePropagation2d( idx in_cellCountX, idx in_cellCountY );
+		WavePropagation2d( idx in_cellCountX,
+		                   idx in_cellCountY,
+		                   idx in_tileSizeX = 256,
+		                   idx in_tileSizeY = 32,
+		                   Splitting in_splitting = UNSPLIT );
 
 		/**
 		 * @brief Destructor which frees all allocated memory.
@@ -64,9 +295,8 @@ class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
 		 * @brief Performs a time step.
 		 *
 		 * @param in_scaling scaling of the time step (dt / dx).
-		 * @param in_solver solver type to use (Roe / FWave)
 		 **/
-		void timeStep( real in_scaling, Solver in_solver );
+		void timeStep( real in_scaling );
 
 		/**
 		* @brief Sets the values of the ghost cells according to outflow boundary conditions.
@@ -75,42 +305,137 @@ class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
 		*/
 		void setGhostOutflow(Boundary in_boundary[4]);
 
+		/**
+		 * @brief Gets the maximum wave speed of all edges in x- and y-direction of the last time step.
+		 *
+		 * @return maximum wave speed.
+		 **/
+		real getWaveSpeedMax(){
+			return waveSpeedMax;
+		}
+
+		/**
+		 * @brief Gets the number of edges solved in the last time step, i.e., the work of the step.
+		 *
+		 * Edges on the border of two tiles are counted twice.
+		 *
+		 * @return number of solved edges.
+		 **/
+		idx getEdgeCount(){
+			return edgeCount;
+		}
+
+		/**
+		 * @brief Gets the fraction of the edges of the last time step which were skipped since both of their cells are dry.
+		 *
+		 * @return fraction of the skipped edges; 0 if the classes of the edges are disabled.
+		 **/
+		real getSkippedFraction(){
+			idx edgeCountAll = edgeCount + edgeCountSkipped;
+			return edgeCountAll > 0 ? real(edgeCountSkipped) / real(edgeCountAll) : 0;
+		}
+
+		/**
+		 * @brief Gets the number of dimensions of the patch.
+		 *
+		 * @return 2.
+		 **/
+		unsigned short getDimensions(){
+			return 2;
+		}
+
+		/**
+		 * @brief Enables or disables the cache of the cell quantities shared by the edges of a cell.
+		 *
+		 * The x-sweep computes the quantities of a tile's row of cells once, the y-sweep keeps two rows of cells
+		 * and reuses the top row of an edge row as the bottom row of the next one.
+		 *
+		 * @param in_cellCache true to enable the cache.
+		 **/
+		void setCellCache( bool in_cellCache ) {
+			cellCache = in_cellCache;
+		}
+
+		/**
+		 * @brief Enables or disables the precomputed classes of the edges.
+		 *
+		 * The classes are derived from the bathymetry once (and after it was set) and stored as a bitmask of the dry cells.
+		 * The sweeps skip the edges between two dry cells and solve the edges with a single dry cell by the closed-form update of a reflecting wall.
+		 * The results of the wet cells do not change, the dry cells keep their values.
+		 *
+		 * @param in_edgeClasses true to enable the classes.
+		 **/
+		void setEdgeClasses( bool in_edgeClasses ) {
+			edgeClassesEnabled = in_edgeClasses;
+			edgeClassesValid = false;
+		}
+
+		/**
+		 * @brief Enables or disables the tracking of the active tiles.
+		 *
+		 * If enabled, a time step only solves the tiles of which a cell or a neighbouring tile's cell changed by more than the threshold
+		 * in the previous time step; the other tiles are copied. All tiles are solved in the first time step and after values of cells were set.
+		 * A threshold of 0 skips tiles whose values did not change at all, which leaves the results unchanged unless updates vanish in the rounding of the cells.
+		 *
+		 * @param in_activity true to enable the tracking.
+		 * @param in_threshold largest change of a cell's height or momenta in a sweep at which the cell is considered at rest.
+		 **/
+		void setActivity( bool in_activity,
+		                  real in_threshold );
+
+		/**
+		 * @brief Gets the fraction of the tiles solved in the last time step.
+		 *
+		 * @return fraction of active tiles; 1 if the activity tracking is disabled.
+		 **/
+		real getActiveFraction(){
+			return activeFraction;
+		}
+
 		/**
 		 * @brief Gets the stride in y-direction. x-direction is stride-1.
 		 *
 		 * @return stride in y-direction.
 		 **/
 		idx getStride(){
-			return 0;
+			return bathymetry->getStride();
 		}
 
 		/**
 		 * @brief Gets cells' water heights.
 		 *
-		 * @return water heights.
+		 * @return water heights of the first non-ghost cell; rows are getStride() apart.
 		 */
-		real const * getHeight();
+		real const * getHeight(){
+			return height[step]->getRow(1) + 1;
+		}
 
 		/**
 		 * @brief Gets the cells' momenta in x-direction.
 		 *
-		 * @return momenta in x-direction.
+		 * @return momenta in x-direction of the first non-ghost cell; rows are getStride() apart.
 		 **/
-		real const * getMomentumX();
+		real const * getMomentumX(){
+			return momentumX[step]->getRow(1) + 1;
+		}
 
 		/**
 		 * @brief Gets the cells' momenta in y-direction.
 		 *
-		 * @return momenta in y-direction.
+		 * @return momenta in y-direction of the first non-ghost cell; rows are getStride() apart.
 		 **/
-		real const * getMomentumY();
+		real const * getMomentumY(){
+			return momentumY[step]->getRow(1) + 1;
+		}
 
 		/**
 		 * @brief Get the bathymetry.
 		 * 
-		 * @return bathymetry.
+		 * @return bathymetry of the first non-ghost cell; rows are getStride() apart.
 		 */
-		real const * getBathymetry();
+		real const * getBathymetry(){
+			return bathymetry->getRow(1) + 1;
+		}
 
 		/**
 		 * @brief Sets the height of the cell to the given value.
@@ -120,7 +445,8 @@ class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
 		 * @param in_height water height.
 		 **/
 		void setHeight( idx in_x, idx in_y, real in_height ) {
-			height[step][in_x+1][in_y+1] = in_height;
+			(*height[step])(in_x+1, in_y+1) = in_height;
+			allActive = true;
 		}
 
 		/**
@@ -131,7 +457,8 @@ class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
 		 * @param in_momentumX momentum in x-direction.
 		 **/
 		void setMomentumX( idx in_x, idx in_y, real in_momentumX ) {
-			momentumX[step][in_x+1][in_y+1] = in_momentumX;
+			(*momentumX[step])(in_x+1, in_y+1) = in_momentumX;
+			allActive = true;
 		}
 
 		/**
@@ -142,7 +469,8 @@ class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
 		 * @param in_momentumY momentum in y-direction.
 		 **/
 		void setMomentumY( idx in_x, idx in_y, real in_momentumY ) {
-			momentumY[step][in_x+1][in_y+1] = in_momentumY;
+			(*momentumY[step])(in_x+1, in_y+1) = in_momentumY;
+			allActive = true;
 		}
 	
 		/**
@@ -153,8 +481,33 @@ class tsunami_lab::patches::WavePropagation2d: public WavePropagation {
 		 * @param in_bathymetry bathymetry.
 		**/
 		void setBathymetry( idx in_x, idx in_y, real in_bathymetry ) {
-			bathymetry[in_x+1][in_y+1] = in_bathymetry;
+			(*bathymetry)(in_x+1, in_y+1) = in_bathymetry;
+			allActive = true;
+			edgeClassesValid = false;
 		};
+
+		/**
+		 * @brief Sets the values of a rectangular region of cells with one copy per row and field.
+		 *
+		 * @param in_x id of the first cell in x-direction.
+		 * @param in_y id of the first cell in y-direction.
+		 * @param in_countX number of cells in x-direction.
+		 * @param in_countY number of cells in y-direction.
+		 * @param in_stride stride of the input arrays in y-direction (x is assumed to be stride-1).
+		 * @param in_height water heights.
+		 * @param in_momentumX momenta in x-direction.
+		 * @param in_momentumY momenta in y-direction.
+		 * @param in_bathymetry bathymetry.
+		 **/
+		void setValues( idx in_x,
+		                idx in_y,
+		                idx in_countX,
+		                idx in_countY,
+		                idx in_stride,
+		                real const * in_height,
+		                real const * in_momentumX,
+		                real const * in_momentumY,
+		                real const * in_bathymetry );
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,533 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the two-dimensional wave propagation patch.
+ **/
+#include <catch2/catch.hpp>
+#include "WavePropagation2d.h"
+#include "WavePropagation2d.test.h"
+#include <cmath>
+
+TEST_CASE( "Test the strided field access of the 2d wave propagation patch.", "[WaveProp2dAccess]" ) {
+  tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( 5, 5 );
+
+  for( std::size_t y = 0; y < 5; y++ ) {
+    for( std::size_t x = 0; x < 5; x++ ) {
+      waveProp.setHeight( x, y, 10 * y + x );
+      waveProp.setMomentumX( x, y, 100 + x );
+      waveProp.setMomentumY( x, y, 200 + y );
+      waveProp.setBathymetry( x, y, -1 * (tsunami_lab::real) x );
+    }
+  }
+
+  REQUIRE( waveProp.getDimensions() == 2 );
+
+  tsunami_lab::idx stride = waveProp.getStride();
+  REQUIRE( stride >= 5 );
+
+  // getters are views into the patch data and honor the stride
+  tsunami_lab::real const * height = waveProp.getHeight();
+  REQUIRE( waveProp.getHeight() == height );
+
+  for( std::size_t y = 0; y < 5; y++ ) {
+    for( std::size_t x = 0; x < 5; x++ ) {
+      REQUIRE( height[y * stride + x] == 10 * y + x );
+      REQUIRE( waveProp.getMomentumX()[y * stride + x] == 100 + x );
+      REQUIRE( waveProp.getMomentumY()[y * stride + x] == 200 + y );
+      REQUIRE( waveProp.getBathymetry()[y * stride + x] == -1 * (tsunami_lab::real) x );
+    }
+  }
+
+  // a region of 2x3 cells from arrays with a stride of 4
+  tsunami_lab::real values[4][12];
+  for( unsigned short field = 0; field < 4; field++ ) {
+    for( unsigned short cell = 0; cell < 12; cell++ ) {
+      values[field][cell] = -1000 * field - cell;
+    }
+  }
+  waveProp.setValues( 2, 1, 2, 3, 4, values[0], values[1], values[2], values[3] );
+
+  for( std::size_t y = 0; y < 5; y++ ) {
+    for( std::size_t x = 0; x < 5; x++ ) {
+      bool inside = x >= 2 && x < 4 && y >= 1 && y < 4;
+      tsunami_lab::idx cell = (y-1) * 4 + (x-2);
+      REQUIRE( height[y * stride + x] == ( inside ? values[0][cell] : 10 * y + x ) );
+      REQUIRE( waveProp.getMomentumX()[y * stride + x] == ( inside ? values[1][cell] : 100 + x ) );
+      REQUIRE( waveProp.getMomentumY()[y * stride + x] == ( inside ? values[2][cell] : 200 + y ) );
+      REQUIRE( waveProp.getBathymetry()[y * stride + x] == ( inside ? values[3][cell] : -1 * (tsunami_lab::real) x ) );
+    }
+  }
+}
+
+TEST_CASE( "Test the 2d wave propagation solver.", "[WaveProp2d]" ) {
+  /*
+   * Test case:
+   *
+   *   Dam break problem between cells 49 and 50 in x-direction,
+   *   constant in y-direction.
+   *     left | right
+   *       10 | 8
+   *        0 | 0
+   *
+   *   Elsewhere steady state.
+   *
+   * The net-updates at the respective edge are given as
+   * (see derivation in Roe solver):
+   *    left          | right
+   *     9.394671362  | -9.394671362
+   *    -88.25985     | -88.25985
+   */
+  tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( 100, 100 );
+
+  for( std::size_t y = 0; y < 100; y++ ) {
+    for( std::size_t x = 0; x < 100; x++ ) {
+      waveProp.setHeight( x, y, x < 50 ? 10 : 8 );
+      waveProp.setMomentumX( x, y, 0 );
+      waveProp.setMomentumY( x, y, 0 );
+      waveProp.setBathymetry( x, y, 0 );
+    }
+  }
+
+  // set outflow boundary condition
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::OUTFLOW,
+		tsunami_lab::OUTFLOW };
+  waveProp.setGhostOutflow( boundary );
+
+  // perform a time step
+  waveProp.timeStep( 0.1 );
+
+  // fastest waves are the gravity waves in the deeper steady state: sqrt(9.80665 * 10)
+  REQUIRE( waveProp.getWaveSpeedMax() == Approx(9.902853124) );
+
+  tsunami_lab::idx stride = waveProp.getStride();
+  for( std::size_t y = 0; y < 100; y += 33 ) {
+    tsunami_lab::real const * height = waveProp.getHeight() + y * stride;
+    tsunami_lab::real const * momentumX = waveProp.getMomentumX() + y * stride;
+    tsunami_lab::real const * momentumY = waveProp.getMomentumY() + y * stride;
+
+    // steady state
+    for( std::size_t x = 0; x < 49; x++ ) {
+      REQUIRE( height[x]    == Approx(10) );
+      REQUIRE( momentumX[x] == Approx(0) );
+    }
+
+    // dam-break
+    REQUIRE( height[49]    == Approx(10 - 0.1 * 9.394671362) );
+    REQUIRE( momentumX[49] == Approx( 0 + 0.1 * 88.25985) );
+
+    REQUIRE( height[50]    == Approx(8 + 0.1 * 9.394671362) );
+    REQUIRE( momentumX[50] == Approx(0 + 0.1 * 88.25985) );
+
+    // steady state
+    for( std::size_t x = 51; x < 100; x++ ) {
+      REQUIRE( height[x]    == Approx(8) );
+      REQUIRE( momentumX[x] == Approx(0) );
+    }
+
+    // no waves in y-direction
+    for( std::size_t x = 0; x < 100; x++ ) {
+      REQUIRE( momentumY[x] == Approx(0) );
+    }
+  }
+}
+
+/**
+ * Checks that the tiled time step of the given solver's patch matches the unblocked one.
+ *
+ * @param in_splitting dimensional splitting of the patches.
+ *
+ * @tparam t_solver Riemann solver of the patches.
+ **/
+template< typename t_solver >
+static void testTiles( tsunami_lab::Splitting in_splitting ) {
+  tsunami_lab::patches::WavePropagation2d< t_solver > unblocked( 37, 23, 37, 23, in_splitting );
+  tsunami_lab::patches::WavePropagation2d< t_solver > blocked( 37, 23, 8, 5, in_splitting );
+  tsunami_lab::patches::WavePropagation2d< t_solver > single( 37, 23, 1, 1, in_splitting );
+  tsunami_lab::patches::WavePropagation * waveProps[3] = { &unblocked, &blocked, &single };
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::REFLECTING,
+		tsunami_lab::REFLECTING };
+
+  for( unsigned short patch = 0; patch < 3; patch++ ) {
+    setDamBreak( *waveProps[patch], 37, 23, 10, 8, isIsland, 1 );
+  }
+
+  for( unsigned short step = 0; step < 10; step++ ) {
+    for( unsigned short patch = 0; patch < 3; patch++ ) {
+      waveProps[patch]->setGhostOutflow( boundary );
+      waveProps[patch]->timeStep( 0.05 );
+    }
+  }
+
+  requireWetCells( blocked, unblocked, 37, 23 );
+  requireWetCells( single, unblocked, 37, 23 );
+}
+
+TEST_CASE( "Test that the tiled 2d time step matches the unblocked one.", "[WaveProp2dTiles]" ) {
+  tsunami_lab::Splitting splittings[3] = { tsunami_lab::UNSPLIT, tsunami_lab::GODUNOV, tsunami_lab::STRANG };
+  for( unsigned short splitting = 0; splitting < 3; splitting++ ) {
+    testTiles< tsunami_lab::solvers::FWave >( splittings[splitting] );
+    testTiles< tsunami_lab::solvers::Roe >( splittings[splitting] );
+  }
+}
+
+/**
+ * Checks that the cache of the cell quantities does not change the time steps of the given solver's patch.
+ *
+ * @param in_splitting dimensional splitting of the patches.
+ *
+ * @tparam t_solver Riemann solver of the patches.
+ **/
+template< typename t_solver >
+static void testCellCache( tsunami_lab::Splitting in_splitting ) {
+  tsunami_lab::patches::WavePropagation2d< t_solver > reference( 37, 23, 8, 5, in_splitting );
+  tsunami_lab::patches::WavePropagation2d< t_solver > cached( 37, 23, 8, 5, in_splitting );
+  cached.setCellCache( true );
+  tsunami_lab::patches::WavePropagation * waveProps[2] = { &reference, &cached };
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::REFLECTING,
+		tsunami_lab::REFLECTING };
+
+  for( unsigned short patch = 0; patch < 2; patch++ ) {
+    setDamBreak( *waveProps[patch], 37, 23, 10, 8, isIsland, 1 );
+  }
+
+  for( unsigned short step = 0; step < 10; step++ ) {
+    for( unsigned short patch = 0; patch < 2; patch++ ) {
+      waveProps[patch]->setGhostOutflow( boundary );
+      waveProps[patch]->timeStep( 0.05 );
+    }
+    REQUIRE( cached.getWaveSpeedMax() == reference.getWaveSpeedMax() );
+  }
+
+  requireWetCells( cached, reference, 37, 23 );
+}
+
+TEST_CASE( "Test that the cache of the cell quantities does not change the 2d time step.", "[WaveProp2dCellCache]" ) {
+  tsunami_lab::Splitting splittings[3] = { tsunami_lab::UNSPLIT, tsunami_lab::GODUNOV, tsunami_lab::STRANG };
+  for( unsigned short splitting = 0; splitting < 3; splitting++ ) {
+    testCellCache< tsunami_lab::solvers::FWave >( splittings[splitting] );
+    testCellCache< tsunami_lab::solvers::Roe >( splittings[splitting] );
+  }
+}
+
+/**
+ * Checks if a cell belongs to the land of a coast with an island.
+ *
+ * @param in_x id of the cell in x-direction.
+ * @param in_y id of the cell in y-direction.
+ * @return true if the cell is dry.
+ **/
+static bool isCoast( long in_x,
+                     long in_y ) {
+  return in_x + in_y / 4 > 30 || ( in_x > 14 && in_x < 20 && in_y > 12 && in_y < 17 );
+}
+
+/**
+ * Compares a patch which solves the edges by their classes to a patch which gathers all edges.
+ *
+ * @param in_splitting dimensional splitting of the patches.
+ * @param in_cellCache true if both patches use the cache of the cell quantities.
+ *
+ * @tparam t_solver Riemann solver of the patches.
+ **/
+template< typename t_solver >
+static void testEdgeClasses( tsunami_lab::Splitting in_splitting,
+                             bool in_cellCache ) {
+  tsunami_lab::patches::WavePropagation2d< t_solver > reference( 37, 23, 8, 5, in_splitting );
+  tsunami_lab::patches::WavePropagation2d< t_solver > classified( 37, 23, 8, 5, in_splitting );
+  reference.setEdgeClasses( false );
+  tsunami_lab::patches::WavePropagation * waveProps[2] = { &reference, &classified };
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::REFLECTING,
+		tsunami_lab::REFLECTING };
+
+  for( unsigned short patch = 0; patch < 2; patch++ ) {
+    waveProps[patch]->setCellCache( in_cellCache );
+    setDamBreak( *waveProps[patch], 37, 23, 10, 8, isCoast, 1 );
+  }
+
+  for( unsigned short step = 0; step < 10; step++ ) {
+    // the classes follow a change of the bathymetry
+    if( step == 5 ) {
+      for( unsigned short patch = 0; patch < 2; patch++ ) {
+        waveProps[patch]->setHeight( 5, 20, 0 );
+        waveProps[patch]->setBathymetry( 5, 20, 1 );
+      }
+    }
+
+    for( unsigned short patch = 0; patch < 2; patch++ ) {
+      waveProps[patch]->setGhostOutflow( boundary );
+      waveProps[patch]->timeStep( 0.05 );
+    }
+    REQUIRE( classified.getWaveSpeedMax() == reference.getWaveSpeedMax() );
+    REQUIRE( classified.getSkippedFraction() > 0 );
+    REQUIRE( classified.getEdgeCount() < reference.getEdgeCount() );
+  }
+  REQUIRE( reference.getSkippedFraction() == 0 );
+
+  requireWetCells( classified, reference, 37, 23 );
+
+  // the dry cells keep their values
+  tsunami_lab::idx stride = reference.getStride();
+  for( tsunami_lab::idx y = 0; y < 23; y++ ) {
+    for( tsunami_lab::idx x = 0; x < 37; x++ ) {
+      if( reference.getBathymetry()[y * stride + x] > 0 ) {
+        REQUIRE( classified.getHeight()[y * stride + x] == 0 );
+      }
+    }
+  }
+}
+
+TEST_CASE( "Test that the classes of the edges do not change the 2d time step of the wet cells.", "[WaveProp2dEdgeClasses]" ) {
+  tsunami_lab::Splitting splittings[3] = { tsunami_lab::UNSPLIT, tsunami_lab::GODUNOV, tsunami_lab::STRANG };
+  for( unsigned short splitting = 0; splitting < 3; splitting++ ) {
+    for( unsigned short cellCache = 0; cellCache < 2; cellCache++ ) {
+      testEdgeClasses< tsunami_lab::solvers::FWave >( splittings[splitting], cellCache == 1 );
+      testEdgeClasses< tsunami_lab::solvers::Roe >( splittings[splitting], cellCache == 1 );
+    }
+  }
+}
+
+/**
+ * Compares a patch which skips the tiles at rest to a patch which solves all tiles.
+ *
+ * @param in_splitting dimensional splitting of the patches.
+ * @param in_tileSizeX number of cells of a tile in x-direction.
+ * @param in_tileSizeY number of cells of a tile in y-direction.
+ *
+ * @tparam t_solver Riemann solver of the patches.
+ **/
+template< typename t_solver >
+static void testActivity( tsunami_lab::Splitting in_splitting,
+                          tsunami_lab::idx in_tileSizeX,
+                          tsunami_lab::idx in_tileSizeY ) {
+  tsunami_lab::patches::WavePropagation2d< t_solver > reference( 48, 30, in_tileSizeX, in_tileSizeY, in_splitting );
+  tsunami_lab::patches::WavePropagation2d< t_solver > active( 48, 30, in_tileSizeX, in_tileSizeY, in_splitting );
+  active.setActivity( true, 0 );
+  tsunami_lab::patches::WavePropagation * waveProps[2] = { &reference, &active };
+
+  for( unsigned short patch = 0; patch < 2; patch++ ) {
+    // the tiles of the lake at rest are skipped if the bottom is flat
+    setDamBreak( *waveProps[patch], 48, 30, 8, 6, isIsland, 0 );
+  }
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::OUTFLOW,
+		tsunami_lab::OUTFLOW };
+
+  tsunami_lab::real speedMax = std::sqrt( 9.80665 * 10 );
+  for( unsigned short step = 0; step < 30; step++ ) {
+    // values which are set between two time steps are solved
+    if( step == 20 ) {
+      for( unsigned short patch = 0; patch < 2; patch++ ) {
+        waveProps[patch]->setHeight( 45, 27, 6 );
+      }
+    }
+
+    for( unsigned short patch = 0; patch < 2; patch++ ) {
+      waveProps[patch]->setGhostOutflow( boundary );
+      waveProps[patch]->timeStep( 0.4 / speedMax );
+    }
+
+    // the waves of the skipped tiles are kept
+    REQUIRE( active.getWaveSpeedMax() == reference.getWaveSpeedMax() );
+    speedMax = reference.getWaveSpeedMax();
+
+    // all tiles are solved in the first time step, the far side of the lake is at rest afterwards
+    if( step == 0 ) {
+      REQUIRE( active.getActiveFraction() == 1 );
+    } else if( step < 10 ) {
+      REQUIRE( active.getActiveFraction() < 1 );
+      REQUIRE( active.getEdgeCount() < reference.getEdgeCount() );
+    }
+  }
+  REQUIRE( reference.getActiveFraction() == 1 );
+
+  requireWetCells( active, reference, 48, 30 );
+}
+
+TEST_CASE( "Test that skipping the tiles at rest does not change the 2d time step.", "[WaveProp2dActivity]" ) {
+  tsunami_lab::Splitting splittings[3] = { tsunami_lab::UNSPLIT, tsunami_lab::GODUNOV, tsunami_lab::STRANG };
+  for( unsigned short splitting = 0; splitting < 3; splitting++ ) {
+    testActivity< tsunami_lab::solvers::FWave >( splittings[splitting], 8, 5 );
+    testActivity< tsunami_lab::solvers::Roe >( splittings[splitting], 8, 5 );
+
+    // tiles narrower than the stencil of the Strang splitting
+    testActivity< tsunami_lab::solvers::FWave >( splittings[splitting], 1, 4 );
+  }
+}
+
+TEST_CASE( "Test the dimensional splitting of the 2d wave propagation patch.", "[WaveProp2dSplitting]" ) {
+  tsunami_lab::Splitting splittings[3] = { tsunami_lab::UNSPLIT, tsunami_lab::GODUNOV, tsunami_lab::STRANG };
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::REFLECTING,
+		tsunami_lab::REFLECTING };
+
+  // dam break in the corner of a closed basin
+  tsunami_lab::real heights[3][20][20];
+  for( unsigned short splitting = 0; splitting < 3; splitting++ ) {
+    tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( 20, 20, 8, 8, splittings[splitting] );
+
+    for( std::size_t y = 0; y < 20; y++ ) {
+      for( std::size_t x = 0; x < 20; x++ ) {
+        waveProp.setHeight( x, y, x < 5 && y < 5 ? 10 : 5 );
+        waveProp.setMomentumX( x, y, 0 );
+        waveProp.setMomentumY( x, y, 0 );
+        waveProp.setBathymetry( x, y, -5 );
+      }
+    }
+
+    double massInitial = 20 * 20 * 5 + 5 * 5 * 5;
+
+    // the split schemes are stable for a CFL number close to 1
+    tsunami_lab::real cfl = splittings[splitting] == tsunami_lab::UNSPLIT ? 0.45 : 0.9;
+    tsunami_lab::real speedMax = std::sqrt( 9.80665 * 10 );
+    for( unsigned short step = 0; step < 50; step++ ) {
+      waveProp.setGhostOutflow( boundary );
+      waveProp.timeStep( cfl / speedMax );
+      speedMax = waveProp.getWaveSpeedMax();
+    }
+
+    // mass is conserved by the reflecting walls
+    tsunami_lab::idx stride = waveProp.getStride();
+    double mass = 0;
+    for( std::size_t y = 0; y < 20; y++ ) {
+      for( std::size_t x = 0; x < 20; x++ ) {
+        heights[splitting][y][x] = waveProp.getHeight()[y * stride + x];
+        mass += heights[splitting][y][x];
+      }
+    }
+    REQUIRE( mass == Approx( massInitial ) );
+
+    // the wave speeds stay bounded by the initial gravity waves
+    REQUIRE( speedMax < 12 );
+  }
+
+  // the schemes differ
+  REQUIRE( heights[1][4][4] != heights[0][4][4] );
+  REQUIRE( heights[2][4][4] != heights[1][4][4] );
+}
+
+TEST_CASE( "Test that the y-sweep consumes the x-sweep for dimensional splitting.", "[WaveProp2dSplittingSweeps]" ) {
+  tsunami_lab::Splitting splittings[2] = { tsunami_lab::UNSPLIT, tsunami_lab::GODUNOV };
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::OUTFLOW,
+		tsunami_lab::OUTFLOW };
+
+  tsunami_lab::real diagonal[2];
+  tsunami_lab::real center[2];
+  for( unsigned short splitting = 0; splitting < 2; splitting++ ) {
+    tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveProp( 5, 5, 256, 32, splittings[splitting] );
+
+    // single raised cell in the center
+    for( std::size_t y = 0; y < 5; y++ ) {
+      for( std::size_t x = 0; x < 5; x++ ) {
+        waveProp.setHeight( x, y, x == 2 && y == 2 ? 10 : 5 );
+        waveProp.setMomentumX( x, y, 0 );
+        waveProp.setMomentumY( x, y, 0 );
+        waveProp.setBathymetry( x, y, -5 );
+      }
+    }
+
+    waveProp.setGhostOutflow( boundary );
+    waveProp.timeStep( 0.01 );
+
+    tsunami_lab::idx stride = waveProp.getStride();
+    diagonal[splitting] = waveProp.getHeight()[3 * stride + 3];
+    center[splitting] = waveProp.getHeight()[2 * stride + 2];
+  }
+
+  // unsplit: the diagonal neighbour only sees the old state, which is at rest
+  REQUIRE( diagonal[0] == 5 );
+
+  // split: the x-sweep raises the horizontal neighbour, which then spreads to the diagonal one in the y-sweep
+  REQUIRE( diagonal[1] > 5 );
+  REQUIRE( center[1] < 10 );
+}
+
+TEST_CASE( "Test the 2d wave propagation patch on non-square grids.", "[WaveProp2dNonSquare]" ) {
+  // dam break along the long side of a narrow basin, once in x- and once in y-direction
+  tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveX( 50, 10 );
+  tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > waveY( 10, 50 );
+
+  for( std::size_t l = 0; l < 50; l++ ) {
+    for( std::size_t s = 0; s < 10; s++ ) {
+      waveX.setHeight( l, s, l < 20 ? 10 : 5 );
+      waveX.setMomentumX( l, s, 0 );
+      waveX.setMomentumY( l, s, 0 );
+      waveX.setBathymetry( l, s, l == 40 ? 2 : -5 );
+
+      waveY.setHeight( s, l, l < 20 ? 10 : 5 );
+      waveY.setMomentumX( s, l, 0 );
+      waveY.setMomentumY( s, l, 0 );
+      waveY.setBathymetry( s, l, l == 40 ? 2 : -5 );
+    }
+  }
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::OUTFLOW,
+		tsunami_lab::OUTFLOW };
+
+  for( unsigned short step = 0; step < 20; step++ ) {
+    waveX.setGhostOutflow( boundary );
+    waveX.timeStep( 0.04 );
+    waveY.setGhostOutflow( boundary );
+    waveY.timeStep( 0.04 );
+  }
+
+  REQUIRE( waveX.getWaveSpeedMax() == waveY.getWaveSpeedMax() );
+
+  // the solutions are transposes of each other
+  tsunami_lab::idx strideX = waveX.getStride();
+  tsunami_lab::idx strideY = waveY.getStride();
+  for( std::size_t l = 0; l < 50; l++ ) {
+    if( l == 40 ) continue;
+
+    for( std::size_t s = 0; s < 10; s++ ) {
+      REQUIRE( waveX.getHeight()[s * strideX + l] == waveY.getHeight()[l * strideY + s] );
+      REQUIRE( waveX.getMomentumX()[s * strideX + l] == waveY.getMomentumY()[l * strideY + s] );
+      REQUIRE( waveX.getMomentumY()[s * strideX + l] == 0 );
+      REQUIRE( waveY.getMomentumX()[l * strideY + s] == 0 );
+    }
+  }
+}
+
+TEST_CASE( "Test that the work of the 2d wave propagation patch scales with the number of cells.", "[WaveProp2dWork]" ) {
+  tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > narrow( 1000, 10 );
+  tsunami_lab::patches::WavePropagation2d< tsunami_lab::solvers::FWave > square( 1000, 1000 );
+  tsunami_lab::patches::WavePropagation * waveProps[2] = { &narrow, &square };
+  tsunami_lab::idx cellCountY[2] = { 10, 1000 };
+
+  tsunami_lab::Boundary boundary[2] = {
+		tsunami_lab::OUTFLOW,
+		tsunami_lab::OUTFLOW };
+
+  for( unsigned short patch = 0; patch < 2; patch++ ) {
+    for( std::size_t y = 0; y < cellCountY[patch]; y++ ) {
+      for( std::size_t x = 0; x < 1000; x++ ) {
+        waveProps[patch]->setHeight( x, y, x < 500 ? 10 : 5 );
+        waveProps[patch]->setBathymetry( x, y, -5 );
+      }
+    }
+    waveProps[patch]->setGhostOutflow( boundary );
+    waveProps[patch]->timeStep( 0.01 );
+  }
+
+  // solved edges: 1000x10 uses ~1% of the work of 1000x1000
+  double work = double( narrow.getEdgeCount() ) / square.getEdgeCount();
+  REQUIRE( narrow.getEdgeCount() >= 10 * 1001 + 11 * 1000 );
+  REQUIRE( work > 0.009 );
+  REQUIRE( work < 0.012 );
+
+  // allocated cells including the ghost cells
+  double memory = double( narrow.getStride() * (10+2) ) / ( square.getStride() * (1000+2) );
+  REQUIRE( memory < 0.013 );
+}
@@ -0,0 +1,83 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Dam break fixture shared by the tests of the serial and the distributed two-dimensional patches.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D_TEST
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D_TEST
+
+#include <catch2/catch.hpp>
+#include "../WavePropagation.h"
+
+/**
+ * Checks if a cell belongs to the dry island of the dam break.
+ *
+ * @param in_x id of the cell in x-direction.
+ * @param in_y id of the cell in y-direction.
+ * @return true if the cell is dry.
+ **/
+inline bool isIsland( long in_x,
+                      long in_y ) {
+  return in_x > 25 && in_x < 30 && in_y > 12 && in_y < 17;
+}
+
+/**
+ * Sets an off-center dam break with momenta in both directions in a lake at rest.
+ * The depth of the lake steps across the columns; the cells of the given land are dry.
+ *
+ * @param io_waveProp patch whose cells are set.
+ * @param in_cellCountX number of cells in x-direction.
+ * @param in_cellCountY number of cells in y-direction.
+ * @param in_damX id of the dam's center cell in x-direction.
+ * @param in_damY id of the dam's center cell in y-direction.
+ * @param in_land returns true for the dry cells.
+ * @param in_depthStep difference of the depths of neighbouring columns; 0 for a flat bottom on which the lake is exactly at rest.
+ **/
+inline void setDamBreak( tsunami_lab::patches::WavePropagation & io_waveProp,
+                         tsunami_lab::idx in_cellCountX,
+                         tsunami_lab::idx in_cellCountY,
+                         long in_damX,
+                         long in_damY,
+                         bool (* in_land)( long, long ),
+                         tsunami_lab::real in_depthStep ) {
+  for( long y = 0; y < long( in_cellCountY ); y++ ) {
+    for( long x = 0; x < long( in_cellCountX ); x++ ) {
+      bool dam = (x - in_damX) * (x - in_damX) + (y - in_damY) * (y - in_damY) < 25;
+      bool land = in_land( x, y );
+      tsunami_lab::real depth = 5 + in_depthStep * tsunami_lab::real( x % 3 );
+      io_waveProp.setHeight( x, y, land ? 0 : ( dam ? depth + 5 : depth ) );
+      io_waveProp.setMomentumX( x, y, dam && !land ? 1 : 0 );
+      io_waveProp.setMomentumY( x, y, dam && !land ? -2 : 0 );
+      io_waveProp.setBathymetry( x, y, land ? 2 : -depth );
+    }
+  }
+}
+
+/**
+ * Requires that the wet cells of two patches are bitwise identical.
+ *
+ * @param in_waveProp patch which is checked.
+ * @param in_reference patch which holds the reference values; defines the wet cells.
+ * @param in_cellCountX number of cells in x-direction.
+ * @param in_cellCountY number of cells in y-direction.
+ **/
+inline void requireWetCells( tsunami_lab::patches::WavePropagation & in_waveProp,
+                             tsunami_lab::patches::WavePropagation & in_reference,
+                             tsunami_lab::idx in_cellCountX,
+                             tsunami_lab::idx in_cellCountY ) {
+  tsunami_lab::idx stride = in_reference.getStride();
+  for( tsunami_lab::idx y = 0; y < in_cellCountY; y++ ) {
+    for( tsunami_lab::idx x = 0; x < in_cellCountX; x++ ) {
+      tsunami_lab::idx cell = y * stride + x;
+      if( in_reference.getBathymetry()[cell] > 0 ) continue;
+
+      REQUIRE( in_waveProp.getHeight()[cell] == in_reference.getHeight()[cell] );
+      REQUIRE( in_waveProp.getMomentumX()[cell] == in_reference.getMomentumX()[cell] );
+      REQUIRE( in_waveProp.getMomentumY()[cell] == in_reference.getMomentumY()[cell] );
+    }
+  }
+}
+
+#endif
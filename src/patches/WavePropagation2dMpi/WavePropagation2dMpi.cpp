@@ -0,0 +1,160 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Two-dimensional wave propagation patch which is distributed across MPI processes.
+ **/
+#include "WavePropagation2dMpi.h"
+#include <algorithm>
+
+using namespace tsunami_lab::patches;
+
+template< typename t_solver >
+WavePropagation2dMpi< t_solver >::WavePropagation2dMpi( Decomposition2d const & in_decomposition,
+                                                        MPI_Comm in_communicator,
+                                                        idx in_tileSizeX,
+                                                        idx in_tileSizeY,
+                                                        Splitting in_splitting ): WavePropagation2d< t_solver >( in_decomposition.getCellCountX(),
+                                                                                                                 in_decomposition.getCellCountY(),
+                                                                                                                 in_tileSizeX,
+                                                                                                                 in_tileSizeY,
+                                                                                                                 in_splitting ),
+                                                                                  decomposition( in_decomposition ),
+                                                                                  communicator( in_communicator ) {
+	// the boundary conditions only apply to the sides without neighbours
+	for( unsigned short side = 0; side < 4; side++ ) {
+		this->domainBoundary[side] = decomposition.getNeighbour( Decomposition2d::Side( side ) ) < 0;
+	}
+
+	realType = sizeof(real) == sizeof(float) ? MPI_FLOAT : MPI_DOUBLE;
+
+	MPI_Type_vector( int(this->cellCountY), 1, int(this->bathymetry->getStride()), realType, &column );
+	MPI_Type_commit( &column );
+}
+
+template< typename t_solver >
+WavePropagation2dMpi< t_solver >::~WavePropagation2dMpi() {
+	MPI_Type_free( &column );
+}
+
+template< typename t_solver >
+void WavePropagation2dMpi< t_solver >::startHaloExchange( Grid2d * const * in_grids,
+                                                          unsigned short in_gridCount ) {
+	idx stride = this->bathymetry->getStride();
+	idx cellCountX = this->cellCountX;
+	idx cellCountY = this->cellCountY;
+
+	// first sent (outermost cells of the block) and received (ghost cells) value of the sides: left, right, bottom, top
+	idx sendFirst[4] = { stride + 1, stride + cellCountX, stride + 1, cellCountY * stride + 1 };
+	idx receiveFirst[4] = { stride, stride + cellCountX + 1, 1, (cellCountY + 1) * stride + 1 };
+
+	for( unsigned short grid = 0; grid < in_gridCount; grid++ ) {
+		real * data = in_grids[grid]->getData();
+
+		for( unsigned short side = 0; side < 4; side++ ) {
+			int neighbour = decomposition.getNeighbour( Decomposition2d::Side( side ) );
+			if( neighbour < 0 ) continue;
+
+			// columns are strided, rows are contiguous
+			MPI_Datatype type = side < 2 ? column : realType;
+			int count = side < 2 ? 1 : int(cellCountX);
+
+			// messages are tagged with the side they are sent to; the neighbour sends to the opposite side
+			int opposite = side ^ 1;
+
+			MPI_Request request;
+			MPI_Irecv( data + receiveFirst[side], count, type, neighbour, 4*grid + opposite, communicator, &request );
+			requests.push_back( request );
+			MPI_Isend( data + sendFirst[side], count, type, neighbour, 4*grid + side, communicator, &request );
+			requests.push_back( request );
+		}
+	}
+}
+
+template< typename t_solver >
+void WavePropagation2dMpi< t_solver >::finishHaloExchange() {
+	MPI_Waitall( int(requests.size()), requests.data(), MPI_STATUSES_IGNORE );
+	requests.clear();
+}
+
+template< typename t_solver >
+void WavePropagation2dMpi< t_solver >::setGhostCells( unsigned short in_step ) {
+	WavePropagation2d< t_solver >::setGhostCells( in_step );
+
+	Grid2d * state[3] = { this->height[in_step], this->momentumX[in_step], this->momentumY[in_step] };
+	startHaloExchange( state, 3 );
+	finishHaloExchange();
+}
+
+template< typename t_solver >
+void WavePropagation2dMpi< t_solver >::setGhostOutflow( Boundary in_boundary[2] ) {
+	if( in_boundary[0] != this->boundary ) this->allActive = true;
+	this->boundary = in_boundary[0];
+	WavePropagation2d< t_solver >::setGhostCells( this->step );
+
+	if( this->boundary == OUTFLOW ) {
+		this->copyGhostCellsOutflow( *this->bathymetry );
+	} else if( this->boundary == REFLECTING ) {
+		this->copyGhostCellsReflecting( *this->bathymetry, 20 );
+	}
+
+	if( !bathymetryExchanged ) {
+		startHaloExchange( &this->bathymetry, 1 );
+		finishHaloExchange();
+		bathymetryExchanged = true;
+	}
+}
+
+template< typename t_solver >
+void WavePropagation2dMpi< t_solver >::timeStep( real in_scaling ) {
+	unsigned short step = this->step;
+	Grid2d * state[3] = { this->height[step], this->momentumX[step], this->momentumY[step] };
+
+	if( this->splitting != UNSPLIT ) {
+		// the first sweep reads the halos of the current state, the intermediate states are exchanged by setGhostCells
+		startHaloExchange( state, 3 );
+		finishHaloExchange();
+		WavePropagation2d< t_solver >::timeStep( in_scaling );
+	} else {
+		idx cellCountX = this->cellCountX;
+		idx cellCountY = this->cellCountY;
+
+		startHaloExchange( state, 3 );
+		this->startActivity();
+		this->updateEdgeClasses();
+
+		// the interior of the block does not read ghost cells and is updated while the halos are in flight
+		this->edgeCount = 0;
+		this->edgeCountSkipped = 0;
+		real speedMax = 0;
+		if( cellCountX > 2 && cellCountY > 2 ) {
+			speedMax = this->updateUnsplit( 2, cellCountX, 2, cellCountY, in_scaling );
+		}
+
+		finishHaloExchange();
+
+		// outermost rows and columns
+		speedMax = std::max( speedMax, this->updateUnsplit( 1, cellCountX + 1, 1, 2, in_scaling ) );
+		if( cellCountY > 1 ) {
+			speedMax = std::max( speedMax, this->updateUnsplit( 1, cellCountX + 1, cellCountY, cellCountY + 1, in_scaling ) );
+		}
+		if( cellCountY > 2 ) {
+			speedMax = std::max( speedMax, this->updateUnsplit( 1, 2, 2, cellCountY, in_scaling ) );
+			if( cellCountX > 1 ) {
+				speedMax = std::max( speedMax, this->updateUnsplit( cellCountX, cellCountX + 1, 2, cellCountY, in_scaling ) );
+			}
+		}
+
+		this->step = (step+1) % 2;
+		this->waveSpeedMax = speedMax;
+		this->finishActivity();
+	}
+
+	// all processes use the same time step
+	MPI_Allreduce( MPI_IN_PLACE, &this->waveSpeedMax, 1, realType, MPI_MAX, communicator );
+}
+
+// instantiations for the available solvers
+template class tsunami_lab::patches::WavePropagation2dMpi< tsunami_lab::solvers::FWave >;
+template class tsunami_lab::patches::WavePropagation2dMpi< tsunami_lab::solvers::Roe >;
@@ -0,0 +1,168 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Two-dimensional wave propagation patch which is distributed across MPI processes.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D_MPI
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D_MPI
+
+#include "../WavePropagation2d/WavePropagation2d.h"
+#include "../Decomposition2d/Decomposition2d.h"
+#include <atomic>
+#include <mpi.h>
+#include <vector>
+
+namespace tsunami_lab {
+	namespace patches {
+		template< typename t_solver >
+		class WavePropagation2dMpi;
+	}
+}
+
+/**
+ * Block of a distributed two-dimensional wave propagation patch.
+ *
+ * Every process owns the block of its Decomposition2d. The ghost cells on the sides of the block which are shared with
+ * neighbouring processes hold the adjacent cells of the neighbours, which are exchanged through non-blocking point-to-point messages:
+ * the unsplit scheme updates the interior of the block (which does not read ghost cells) while the halos are in flight
+ * and updates the outermost rows and columns afterwards. The split schemes exchange the intermediate states in between the sweeps.
+ * The maximum wave speed is reduced across all processes, such that all processes derive the same time step.
+ *
+ * The results are bitwise identical to those of WavePropagation2d on the undecomposed grid.
+ * The split schemes call MPI within OpenMP single regions, which requires MPI_THREAD_SERIALIZED.
+ *
+ * @tparam t_solver Riemann solver.
+ **/
+template< typename t_solver >
+class tsunami_lab::patches::WavePropagation2dMpi: public WavePropagation2d< t_solver > {
+	private:
+		//! block of this process
+		Decomposition2d decomposition;
+
+		//! communicator of the processes of the decomposition
+		MPI_Comm communicator;
+
+		//! column of the block's cells (cellCountY values, one row apart)
+		MPI_Datatype column;
+
+		//! MPI type of real
+		MPI_Datatype realType;
+
+		//! outstanding requests of the halo exchange
+		std::vector< MPI_Request > requests;
+
+		//! true if the ghost cells of the bathymetry hold the neighbours' bathymetry; regions might be set concurrently
+		std::atomic< bool > bathymetryExchanged{ false };
+
+		/**
+		 * @brief Starts the exchange of the halos of the given grids with the neighbouring processes.
+		 *
+		 * The outermost cells of the block are sent, the ghost cells are received.
+		 *
+		 * @param in_grids grids whose halos are exchanged.
+		 * @param in_gridCount number of grids.
+		 **/
+		void startHaloExchange( Grid2d * const * in_grids,
+		                        unsigned short in_gridCount );
+
+		/**
+		 * @brief Waits for the halo exchange to complete.
+		 **/
+		void finishHaloExchange();
+
+		/**
+		 * @brief Sets the ghost cells of the water heights and momenta: boundary condition on the domain's boundaries, halo exchange elsewhere.
+		 *
+		 * @param in_step buffers whose ghost cells are set.
+		 **/
+		void setGhostCells( unsigned short in_step );
+
+	public:
+		/**
+		 * @brief Constructs the block of the calling process.
+		 *
+		 * @param in_decomposition decomposition of the grid; block of the calling process.
+		 * @param in_communicator communicator of the processes; the ranks match the processes of the decomposition.
+		 * @param in_tileSizeX number of cells of a tile in x-direction.
+		 * @param in_tileSizeY number of cells of a tile in y-direction.
+		 * @param in_splitting dimensional splitting, see WavePropagation2d.
+		 **/
+		WavePropagation2dMpi( Decomposition2d const & in_decomposition,
+		                      MPI_Comm in_communicator,
+		                      idx in_tileSizeX = 256,
+		                      idx in_tileSizeY = 32,
+		                      Splitting in_splitting = UNSPLIT );
+
+		/**
+		 * @brief Destructor which frees the MPI types.
+		 **/
+		~WavePropagation2dMpi();
+
+		/**
+		 * @brief Performs a time step of the block; collective over all processes.
+		 *
+		 * @param in_scaling scaling of the time step (dt / dx).
+		 **/
+		void timeStep( real in_scaling );
+
+		/**
+		 * @brief Sets the boundary condition and the ghost cells on the domain's boundaries; the halos follow in timeStep.
+		 *
+		 * The bathymetry is exchanged (blocking) once after it changed.
+		 *
+		 * @param in_boundary boundary type to use (outflow/reflective).
+		 **/
+		void setGhostOutflow( Boundary in_boundary[2] );
+
+		/**
+		 * @brief Sets the bathymetry of a cell of the block.
+		 *
+		 * @param in_x id of the cell in x-direction (local to the block).
+		 * @param in_y id of the cell in y-direction (local to the block).
+		 * @param in_bathymetry bathymetry.
+		 **/
+		void setBathymetry( idx in_x, idx in_y, real in_bathymetry ) {
+			WavePropagation2d< t_solver >::setBathymetry( in_x, in_y, in_bathymetry );
+			bathymetryExchanged = false;
+		}
+
+		/**
+		 * @brief Sets the values of a rectangular region of cells of the block.
+		 *
+		 * @param in_x id of the first cell in x-direction (local to the block).
+		 * @param in_y id of the first cell in y-direction (local to the block).
+		 * @param in_countX number of cells in x-direction.
+		 * @param in_countY number of cells in y-direction.
+		 * @param in_stride stride of the input arrays in y-direction (x is assumed to be stride-1).
+		 * @param in_height water heights.
+		 * @param in_momentumX momenta in x-direction.
+		 * @param in_momentumY momenta in y-direction.
+		 * @param in_bathymetry bathymetry.
+		 **/
+		void setValues( idx in_x,
+		                idx in_y,
+		                idx in_countX,
+		                idx in_countY,
+		                idx in_stride,
+		                real const * in_height,
+		                real const * in_momentumX,
+		                real const * in_momentumY,
+		                real const * in_bathymetry ) {
+			WavePropagation2d< t_solver >::setValues( in_x, in_y, in_countX, in_countY, in_stride,
+			                                          in_height, in_momentumX, in_momentumY, in_bathymetry );
+			bathymetryExchanged = false;
+		}
+
+		/**
+		 * @brief Gets the block of this process.
+		 *
+		 * @return decomposition of the grid.
+		 **/
+		Decomposition2d const & getDecomposition() const {
+			return decomposition;
+		}
+};
+
+#endif
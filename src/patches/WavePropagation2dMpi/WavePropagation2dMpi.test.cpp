@@ -0,0 +1,102 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Unit tests for the distributed two-dimensional wave propagation patch; run with mpirun -np N.
+ **/
+#include <catch2/catch.hpp>
+#include "WavePropagation2dMpi.h"
+#include "../WavePropagation2d/WavePropagation2d.test.h"
+
+/**
+ * Runs a dam break with a dry island on the blocks of all processes and on the undecomposed grid (in every process).
+ * Differences are counted instead of checked one by one, such that all processes take part in the collective checks.
+ *
+ * @param in_splitting dimensional splitting of the patches.
+ * @param in_boundary boundary condition of the domain.
+ * @param in_activity true if the distributed patch skips the tiles at rest.
+ *
+ * @tparam t_solver Riemann solver of the patches.
+ **/
+template< typename t_solver >
+static void testDistributed( tsunami_lab::Splitting in_splitting,
+                             tsunami_lab::Boundary in_boundary,
+                             bool in_activity ) {
+  tsunami_lab::idx const cellCountX = 37;
+  tsunami_lab::idx const cellCountY = 23;
+
+  int processCount = 0;
+  int process = 0;
+  MPI_Comm_size( MPI_COMM_WORLD, &processCount );
+  MPI_Comm_rank( MPI_COMM_WORLD, &process );
+
+  tsunami_lab::patches::Decomposition2d decomposition( cellCountX, cellCountY, processCount, process );
+  REQUIRE( decomposition.isValid() );
+
+  tsunami_lab::patches::WavePropagation2dMpi< t_solver > distributed( decomposition, MPI_COMM_WORLD, 8, 5, in_splitting );
+  tsunami_lab::patches::WavePropagation2d< t_solver > reference( cellCountX, cellCountY, 37, 23, in_splitting );
+  distributed.setActivity( in_activity, 0 );
+
+  // off-center dam break including a dry island, the blocks copy their cells from the undecomposed grid
+  setDamBreak( reference, cellCountX, cellCountY, 10, 8, isIsland, 1 );
+
+  tsunami_lab::idx offsetX = decomposition.getOffsetX();
+  tsunami_lab::idx offsetY = decomposition.getOffsetY();
+  tsunami_lab::idx strideReference = reference.getStride();
+  for( std::size_t y = 0; y < decomposition.getCellCountY(); y++ ) {
+    for( std::size_t x = 0; x < decomposition.getCellCountX(); x++ ) {
+      tsunami_lab::idx cell = (offsetY + y) * strideReference + offsetX + x;
+      distributed.setHeight( x, y, reference.getHeight()[cell] );
+      distributed.setMomentumX( x, y, reference.getMomentumX()[cell] );
+      distributed.setMomentumY( x, y, reference.getMomentumY()[cell] );
+      distributed.setBathymetry( x, y, reference.getBathymetry()[cell] );
+    }
+  }
+
+  tsunami_lab::Boundary boundary[2] = { in_boundary, in_boundary };
+
+  tsunami_lab::idx differenceCount = 0;
+  tsunami_lab::real scaling = 0.02;
+  for( unsigned short step = 0; step < 20; step++ ) {
+    reference.setGhostOutflow( boundary );
+    reference.timeStep( scaling );
+    distributed.setGhostOutflow( boundary );
+    distributed.timeStep( scaling );
+
+    // the maximum wave speed is global
+    if( distributed.getWaveSpeedMax() != reference.getWaveSpeedMax() ) differenceCount++;
+    scaling = 0.45 / reference.getWaveSpeedMax();
+  }
+
+  // the wet cells of the blocks are bitwise identical to the undecomposed grid
+  tsunami_lab::idx stride = distributed.getStride();
+  for( std::size_t y = 0; y < decomposition.getCellCountY(); y++ ) {
+    for( std::size_t x = 0; x < decomposition.getCellCountX(); x++ ) {
+      tsunami_lab::idx cell = y * stride + x;
+      tsunami_lab::idx cellReference = (offsetY + y) * strideReference + offsetX + x;
+      if( reference.getBathymetry()[cellReference] > 0 ) continue;
+
+      if( distributed.getHeight()[cell] != reference.getHeight()[cellReference] ) differenceCount++;
+      if( distributed.getMomentumX()[cell] != reference.getMomentumX()[cellReference] ) differenceCount++;
+      if( distributed.getMomentumY()[cell] != reference.getMomentumY()[cellReference] ) differenceCount++;
+    }
+  }
+
+  unsigned long differenceCountGlobal = 0;
+  unsigned long differenceCountLocal = differenceCount;
+  MPI_Allreduce( &differenceCountLocal, &differenceCountGlobal, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD );
+  REQUIRE( differenceCountGlobal == 0 );
+}
+
+TEST_CASE( "Test that the distributed 2d patch matches the undecomposed one.", "[WaveProp2dMpi]" ) {
+  tsunami_lab::Splitting splittings[3] = { tsunami_lab::UNSPLIT, tsunami_lab::GODUNOV, tsunami_lab::STRANG };
+  tsunami_lab::Boundary boundaries[2] = { tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING };
+  for( unsigned short splitting = 0; splitting < 3; splitting++ ) {
+    for( unsigned short boundary = 0; boundary < 2; boundary++ ) {
+      testDistributed< tsunami_lab::solvers::FWave >( splittings[splitting], boundaries[boundary], false );
+      testDistributed< tsunami_lab::solvers::Roe >( splittings[splitting], boundaries[boundary], false );
+      testDistributed< tsunami_lab::solvers::FWave >( splittings[splitting], boundaries[boundary], true );
+    }
+  }
+}
@@ -45,8 +45,8 @@ class tsunami_lab::setups::Bathymetry2d: public Setup {
 		 * @param in_heightInner water height on the inner side of the dam.
 		 * @param in_heightOuter water height on the outer side of the dam.
 		 * @param in_radiusDam radius of the dam.
-		 * @param in_xMax max x position.
-		 * @param in_yMax max y position.
+		 * @param in_xMax number of cells in x-direction; the dam is centered in the domain.
+		 * @param in_yMax number of cells in y-direction.
 		 * @param in_scaling cell Size (scaling).
 		**/
 		Bathymetry2d( real in_heightInner, real in_heightOuter, real in_radiusDam, real in_xMax, real in_yMax, real in_scaling );
@@ -81,6 +81,31 @@ class tsunami_lab::setups::Bathymetry2d: public Setup {
 		**/
    	real getBathymetry( t_real, t_real ) const;
 
+		/**
+		 * @brief Gets the values of a rectangular region of cells in vectorized loops.
+		 *
+		 * @param in_x0 id of the first cell in x-direction.
+		 * @param in_y0 id of the first cell in y-direction.
+		 * @param in_cellSize cell size.
+		 * @param in_countX number of cells in x-direction.
+		 * @param in_countY number of cells in y-direction.
+		 * @param in_stride stride of the output arrays in y-direction.
+		 * @param out_height will be set to the water heights; ignored if nullptr.
+		 * @param out_momentumX will be set to the momenta in x-direction; ignored if nullptr.
+		 * @param out_momentumY will be set to the momenta in y-direction; ignored if nullptr.
+		 * @param out_bathymetry will be set to the bathymetry; ignored if nullptr.
+		**/
+		void getValues( idx in_x0,
+		                idx in_y0,
+		                real in_cellSize,
+		                idx in_countX,
+		                idx in_countY,
+		                idx in_stride,
+		                real * out_height,
+		                real * out_momentumX,
+		                real * out_momentumY,
+		                real * out_bathymetry ) const;
+
 };
 
 #endif
\ No newline at end of file
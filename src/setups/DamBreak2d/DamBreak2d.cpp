@@ -7,6 +7,8 @@
  * One-dimensional dam break problem.
  **/
 #include "DamBreak2d.h"
+#include <cstdint>
+#include <limits>
 
 tsunami_lab::setups::DamBreak2d::DamBreak2d( real in_heightInner, real in_heightOuter, real in_radiusDam, real in_xMax, real in_yMax, real in_scaling ) {
 	heightInner = in_heightInner;
@@ -38,4 +40,49 @@ tsunami_lab::t_real tsunami_lab::setups::DamBreak2d::getMomentumY( t_real, t_rea
 
 tsunami_lab::t_real tsunami_lab::setups::DamBreak2d::getBathymetry( t_real, t_real ) const {
 	return 0;
-}
\ No newline at end of file
+}
+
+void tsunami_lab::setups::DamBreak2d::getValues( idx in_x0,
+                                                 idx in_y0,
+                                                 real in_cellSize,
+                                                 idx in_countX,
+                                                 idx in_countY,
+                                                 idx in_stride,
+                                                 real * out_height,
+                                                 real * out_momentumX,
+                                                 real * out_momentumY,
+                                                 real * out_bathymetry ) const {
+	// the ids of the cells are converted through 32-bit integers, which vectorizes; wider rows use the point getters
+	if( in_x0 + in_countX > idx( std::numeric_limits< std::int32_t >::max() ) ) {
+		Setup::getValues( in_x0, in_y0, in_cellSize, in_countX, in_countY, in_stride,
+		                  out_height, out_momentumX, out_momentumY, out_bathymetry );
+		return;
+	}
+
+	for( idx y = 0; y < in_countY; y++ ) {
+		real pointY = (in_y0 + y) * in_cellSize;
+
+		// the distance in y-direction is shared by the row; no branches, such that the loop is vectorized
+		real distanceY = (centerDam[1]-pointY)*(centerDam[1]-pointY);
+		if( out_height != nullptr ) {
+			real * height = out_height + y * in_stride;
+			real centerX = centerDam[0], radius = radiusDam, inner = heightInner, outer = heightOuter;
+#pragma omp simd
+			for( idx x = 0; x < in_countX; x++ ) {
+				real pointX = real( std::int32_t( in_x0 + x ) ) * in_cellSize;
+				real distanceFromCenter = std::sqrt((centerX-pointX)*(centerX-pointX) + distanceY);
+				height[x] = distanceFromCenter < radius ? inner : outer;
+			}
+		}
+
+		// no momentum, no bathymetry
+		real * fields[3] = { out_momentumX, out_momentumY, out_bathymetry };
+		for( unsigned short field = 0; field < 3; field++ ) {
+			if( fields[field] == nullptr ) continue;
+#pragma omp simd
+			for( idx x = 0; x < in_countX; x++ ) {
+				fields[field][y * in_stride + x] = 0;
+			}
+		}
+	}
+}
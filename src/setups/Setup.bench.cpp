@@ -0,0 +1,77 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Benchmarks of the evaluation of the setups.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "DamBreak2d/DamBreak2d.h"
+#include "Bathymetry2d/Bathymetry2d.h"
+#include <string>
+#include <vector>
+
+namespace {
+  //! number of cells in each direction
+  tsunami_lab::idx const cellCount = 2048;
+
+  //! number of measured runs
+  unsigned int const repetitionCount = 5;
+
+  /**
+   * Measures the evaluation of a setup on a grid through the point getters (as by the driver before the region evaluation)
+   * and through the region evaluation, one row per call.
+   *
+   * @param in_name name of the setup in the report.
+   * @param in_setup setup.
+   * @param io_stream stream to which the results are written.
+   **/
+  void benchSetup( std::string const & in_name,
+                   tsunami_lab::setups::Setup const & in_setup,
+                   std::ostream & io_stream ) {
+    tsunami_lab::real cellSize = 0.01;
+    std::vector< tsunami_lab::real > fields[4];
+    for( unsigned short field = 0; field < 4; field++ ) {
+      fields[field].resize( cellCount * cellCount );
+    }
+
+    double timePoint = tsunami_lab::benchmarks::Benchmark::median( repetitionCount, [&]() {
+      for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+        for( tsunami_lab::idx x = 0; x < cellCount; x++ ) {
+          tsunami_lab::idx cell = y * cellCount + x;
+          fields[0][cell] = in_setup.getHeight( x * cellSize, y * cellSize );
+          fields[1][cell] = in_setup.getMomentumX( x * cellSize, y * cellSize );
+          fields[2][cell] = in_setup.getMomentumY( x * cellSize, y * cellSize );
+          fields[3][cell] = in_setup.getBathymetry( x * cellSize, y * cellSize );
+        }
+      }
+    } );
+
+    double timeRegion = tsunami_lab::benchmarks::Benchmark::median( repetitionCount, [&]() {
+      for( tsunami_lab::idx y = 0; y < cellCount; y++ ) {
+        tsunami_lab::idx row = y * cellCount;
+        in_setup.getValues( 0, y, cellSize, cellCount, 1, cellCount,
+                            fields[0].data() + row, fields[1].data() + row, fields[2].data() + row, fields[3].data() + row );
+      }
+    } );
+
+    double cells = double(cellCount) * cellCount;
+    std::string name = in_name + "/values/" + std::to_string( cellCount ) + "x" + std::to_string( cellCount );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/point", "cells_per_second", cells / timePoint, "1/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/region", "cells_per_second", cells / timeRegion, "1/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "speedup_region", timePoint / timeRegion, "" );
+  }
+
+  void benchDamBreak2d( std::ostream & io_stream ) {
+    tsunami_lab::setups::DamBreak2d setup( 10, 5, 10, cellCount, cellCount, 0.01 );
+    benchSetup( "DamBreak2d", setup, io_stream );
+  }
+
+  void benchBathymetry2d( std::ostream & io_stream ) {
+    tsunami_lab::setups::Bathymetry2d setup( 10, 5, 10, cellCount, cellCount, 0.01 );
+    benchSetup( "Bathymetry2d", setup, io_stream );
+  }
+
+  tsunami_lab::benchmarks::Benchmark damBreak2d( "DamBreak2d/values", benchDamBreak2d );
+  tsunami_lab::benchmarks::Benchmark bathymetry2d( "Bathymetry2d/values", benchBathymetry2d );
+}
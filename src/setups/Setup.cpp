@@ -0,0 +1,34 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Simulation setup.
+ **/
+#include "Setup.h"
+
+void tsunami_lab::setups::Setup::getValues( t_idx    i_ix0,
+                                            t_idx    i_iy0,
+                                            t_real   i_dxy,
+                                            t_idx    i_nx,
+                                            t_idx    i_ny,
+                                            t_idx    i_stride,
+                                            t_real * o_h,
+                                            t_real * o_hu,
+                                            t_real * o_hv,
+                                            t_real * o_b ) const {
+  for( t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
+    t_real l_y = (i_iy0 + l_iy) * i_dxy;
+
+    for( t_idx l_ix = 0; l_ix < i_nx; l_ix++ ) {
+      t_real l_x = (i_ix0 + l_ix) * i_dxy;
+      t_idx l_id = l_iy * i_stride + l_ix;
+
+      if( o_h  != nullptr ) o_h[l_id]  = getHeight( l_x, l_y );
+      if( o_hu != nullptr ) o_hu[l_id] = getMomentumX( l_x, l_y );
+      if( o_hv != nullptr ) o_hv[l_id] = getMomentumY( l_x, l_y );
+      if( o_b  != nullptr ) o_b[l_id]  = getBathymetry( l_x, l_y );
+    }
+  }
+}
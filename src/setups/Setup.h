@@ -64,7 +64,36 @@ class tsunami_lab::setups::Setup {
      **/
     virtual t_real getBathymetry( t_real i_x,
                                   t_real i_y ) const = 0;
-      
+
+    /**
+     * @brief Gets the values of a rectangular region of cells.
+     *
+     * The cell (i_ix0+l_ix, i_iy0+l_iy) is evaluated at the point ((i_ix0+l_ix) * i_dxy, (i_iy0+l_iy) * i_dxy)
+     * and written to index l_iy * i_stride + l_ix of the output arrays.
+     * The default implementation calls the point getters; setups override it to evaluate the region in vectorized loops.
+     * Different regions may be evaluated concurrently.
+     *
+     * @param i_ix0 id of the first cell in x-direction.
+     * @param i_iy0 id of the first cell in y-direction.
+     * @param i_dxy cell size.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the output arrays in y-direction (x is assumed to be stride-1).
+     * @param o_h will be set to the water heights; ignored if nullptr.
+     * @param o_hu will be set to the momenta in x-direction; ignored if nullptr.
+     * @param o_hv will be set to the momenta in y-direction; ignored if nullptr.
+     * @param o_b will be set to the bathymetry; ignored if nullptr.
+     **/
+    virtual void getValues( t_idx    i_ix0,
+                            t_idx    i_iy0,
+                            t_real   i_dxy,
+                            t_idx    i_nx,
+                            t_idx    i_ny,
+                            t_idx    i_stride,
+                            t_real * o_h,
+                            t_real * o_hu,
+                            t_real * o_hv,
+                            t_real * o_b ) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+/**
+ * @author Alexander Breuer (alex.breuer AT uni-jena.de)
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Tests the evaluation of setups over regions of cells.
+ **/
+#include <catch2/catch.hpp>
+#include "DamBreak1d/DamBreak1d.h"
+#include "DamBreak2d/DamBreak2d.h"
+#include "Bathymetry2d/Bathymetry2d.h"
+#include <vector>
+
+/**
+ * Checks that the values of a region match the point getters bitwise.
+ *
+ * @param i_setup setup.
+ * @param i_ix0 id of the first cell in x-direction.
+ * @param i_iy0 id of the first cell in y-direction.
+ * @param i_dxy cell size.
+ * @param i_nx number of cells in x-direction.
+ * @param i_ny number of cells in y-direction.
+ **/
+static void checkRegion( tsunami_lab::setups::Setup const & i_setup,
+                         tsunami_lab::t_idx                 i_ix0,
+                         tsunami_lab::t_idx                 i_iy0,
+                         tsunami_lab::t_real                i_dxy,
+                         tsunami_lab::t_idx                 i_nx,
+                         tsunami_lab::t_idx                 i_ny ) {
+  // padded rows; the padding is not written
+  tsunami_lab::t_idx l_stride = i_nx + 3;
+  std::vector< tsunami_lab::t_real > l_values[4];
+  for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) {
+    l_values[l_fi].assign( l_stride * i_ny, -99 );
+  }
+
+  i_setup.getValues( i_ix0, i_iy0, i_dxy, i_nx, i_ny, l_stride,
+                     l_values[0].data(), l_values[1].data(), l_values[2].data(), l_values[3].data() );
+
+  for( tsunami_lab::t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
+    tsunami_lab::t_real l_y = (i_iy0 + l_iy) * i_dxy;
+    for( tsunami_lab::t_idx l_ix = 0; l_ix < l_stride; l_ix++ ) {
+      tsunami_lab::t_real l_x = (i_ix0 + l_ix) * i_dxy;
+      tsunami_lab::t_idx l_id = l_iy * l_stride + l_ix;
+
+      if( l_ix >= i_nx ) {
+        for( unsigned short l_fi = 0; l_fi < 4; l_fi++ ) REQUIRE( l_values[l_fi][l_id] == -99 );
+        continue;
+      }
+
+      REQUIRE( l_values[0][l_id] == i_setup.getHeight( l_x, l_y ) );
+      REQUIRE( l_values[1][l_id] == i_setup.getMomentumX( l_x, l_y ) );
+      REQUIRE( l_values[2][l_id] == i_setup.getMomentumY( l_x, l_y ) );
+      REQUIRE( l_values[3][l_id] == i_setup.getBathymetry( l_x, l_y ) );
+    }
+  }
+
+  // fields might be skipped
+  i_setup.getValues( i_ix0, i_iy0, i_dxy, i_nx, i_ny, l_stride,
+                     nullptr, l_values[1].data(), nullptr, nullptr );
+}
+
+TEST_CASE( "Test the evaluation of setups over regions of cells.", "[SetupValues]" ) {
+  // default implementation
+  tsunami_lab::setups::DamBreak1d l_damBreak1d( 10, 5, 5 );
+  checkRegion( l_damBreak1d, 0, 0, 0.1f, 100, 1 );
+
+  // vectorized implementations; the regions contain the rim of the dam and the hump
+  tsunami_lab::setups::DamBreak2d l_damBreak2d( 10, 5, 10, 100, 100, 0.1f );
+  REQUIRE( l_damBreak2d.getHeight( 5, 5 ) == 10 );
+  REQUIRE( l_damBreak2d.getHeight( 4, 5 ) == 5 );
+  checkRegion( l_damBreak2d, 0, 0, 0.1f, 100, 100 );
+  checkRegion( l_damBreak2d, 37, 21, 0.1f, 29, 17 );
+
+  tsunami_lab::setups::Bathymetry2d l_bathymetry2d( 10, 5, 10, 100, 100, 0.1f );
+  REQUIRE( l_bathymetry2d.getBathymetry( 7.7f, 7.7f ) == -1 );
+  checkRegion( l_bathymetry2d, 0, 0, 0.1f, 100, 100 );
+  checkRegion( l_bathymetry2d, 70, 71, 0.1f, 13, 7 );
+}
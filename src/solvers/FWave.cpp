@@ -7,106 +7,444 @@
 **/
 
 #include "FWave.h"
+#include "Simd.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace tsunami_lab::solvers;
 
-void FWave::computeEigenvalues(real in_stateLeft[3], real in_stateRight[3], real out_eigenvaluesRoe[2]) {
-	real heightLeft = in_stateLeft[0];
-	real heightRight = in_stateRight[0];
-	real momentumLeft = in_stateLeft[1];
-	real momentumRight = in_stateRight[1];
-
-	real sqrtHeightLeft = sqrt(heightLeft);
-	real sqrtHeightRight = sqrt(heightRight);
-	real particleVelocityLeft = momentumLeft / heightLeft;
-	real particleVelocityRight = momentumRight / heightRight;
-	
-	real heightRoe = real(0.5) * (heightLeft + heightRight);
-	real particleVelocityRoe = particleVelocityLeft * sqrtHeightLeft + particleVelocityRight * sqrtHeightRight;
-	particleVelocityRoe /= sqrtHeightLeft + sqrtHeightRight;
-
-	real sqrtGTimesHeight = const_gSqrt * sqrt(heightRoe);
-	
-	out_eigenvaluesRoe[0] = particleVelocityRoe - sqrtGTimesHeight;
-	out_eigenvaluesRoe[1] = particleVelocityRoe + sqrtGTimesHeight;
-}
+namespace {
+	using tsunami_lab::idx;
+	using tsunami_lab::real;
+	using tsunami_lab::realCompute;
 
-void FWave::computeInvertedEigenmatrix(real in_eigenvalues[2], real out_invertedEigenmatrix[2][2]) {
-	real invertedMatrixDeterminant = 1 / (in_eigenvalues[1] - in_eigenvalues[0]);
+	//! signature of the batched kernels
+	typedef void (*t_batchKernel)( idx, real const *, real const *, real const *, real const *, real const *, real const *,
+	                               real *, real *, real *, real *, real * );
 
-	out_invertedEigenmatrix[0][0] =  invertedMatrixDeterminant * in_eigenvalues[1];
-	out_invertedEigenmatrix[0][1] = -invertedMatrixDeterminant;
-	out_invertedEigenmatrix[1][0] = -invertedMatrixDeterminant * in_eigenvalues[0];
-	out_invertedEigenmatrix[1][1] =  invertedMatrixDeterminant;
-}
+	//! signature of the batched kernels which consume cached cell quantities
+	typedef void (*t_batchCachedKernel)( idx, real const *, real const *, real const *, real const *, real const *, real const *,
+	                                     realCompute const *, realCompute const *, realCompute const *, realCompute const *,
+	                                     realCompute const *, realCompute const *,
+	                                     real *, real *, real *, real *, real * );
 
-void FWave::flux(real in_state[3], real out_flux[2]) {
-	real height = in_state[0];
-	real momentum = in_state[1];
+	//! signature of the batched kernels of the cell quantities
+	typedef void (*t_cellKernel)( idx, real const *, real const *, realCompute *, realCompute *, realCompute * );
 
-	out_flux[0] = momentum;
-	out_flux[1] = (momentum * momentum / height + real(0.5) * const_g * height * height);
-}
+	//! signature of the batched kernels of the wall edges
+	typedef void (*t_wallKernel)( idx, real const *, real const *, bool, real *, real *, real * );
 
-void FWave::computeDxPsi(real in_stateLeft[3], real in_stateRight[3], real & out_dxPsi) {
-	real heightLeft = in_stateLeft[0];
-	real heightRight = in_stateRight[0];
-	real bathymetryLeft = in_stateLeft[2];
-	real bathymetryRight = in_stateRight[2];
-	
-	//			   -g	  *	 bathymetryRight - bathymetryLeft  *  heightLeft + heightRight   / 2
-	out_dxPsi = -const_g * (bathymetryRight - bathymetryLeft) * (heightLeft + heightRight) / 2;
-}
+	//! gravity constant and its square root
+	realCompute const g = 9.80665;
+	realCompute const gSqrt = 3.131557121;
 
-void FWave::computeEigencoefficients(real in_stateLeft[3], real in_stateRight[3], real in_invertedEigenmatrix[2][2], real out_eigencoefficients[2]) {
-	real fluxJumpLeft[2];
-	real fluxJumpRight[2];
-	real dxPsi;
-
-	flux(in_stateLeft, fluxJumpLeft);
-	flux(in_stateRight, fluxJumpRight);
-	computeDxPsi(in_stateLeft, in_stateRight, dxPsi);
-	
-	real fluxJump[2] = {
-		fluxJumpRight[0] - fluxJumpLeft[0],
-		fluxJumpRight[1] - fluxJumpLeft[1] - dxPsi
-	};
-
-	out_eigencoefficients[0] = in_invertedEigenmatrix[0][0] * fluxJump[0] + in_invertedEigenmatrix[0][1] * fluxJump[1];
-	out_eigencoefficients[1] =	in_invertedEigenmatrix[1][0] * fluxJump[0] + in_invertedEigenmatrix[1][1] * fluxJump[1];
-}
+	/**
+	 * Particle velocity of a cell.
+	 **/
+	TSUNAMI_LAB_SIMD_INLINE realCompute particleVelocity( realCompute in_height,
+	                                                      realCompute in_momentum ) {
+		return in_momentum / in_height;
+	}
+
+	/**
+	 * Flux of the momentum of a cell.
+	 **/
+	TSUNAMI_LAB_SIMD_INLINE realCompute momentumFlux( realCompute in_height,
+	                                                  realCompute in_momentum ) {
+		return in_momentum * in_momentum / in_height + realCompute(0.5) * g * in_height * in_height;
+	}
+
+	/**
+	 * Branch-free f-wave solver for a single edge, given the states and the quantities of both cells.
+	 * Follows the operations of FWave::netUpdates step by step, also in realCompute.
+	 **/
+	TSUNAMI_LAB_SIMD_INLINE void solveEdge( realCompute in_heightLeft,
+	                                        realCompute in_heightRight,
+	                                        realCompute in_momentumLeft,
+	                                        realCompute in_momentumRight,
+	                                        realCompute in_bathymetryLeft,
+	                                        realCompute in_bathymetryRight,
+	                                        realCompute in_sqrtHeightLeft,
+	                                        realCompute in_sqrtHeightRight,
+	                                        realCompute in_particleVelocityLeft,
+	                                        realCompute in_particleVelocityRight,
+	                                        realCompute in_fluxLeft,
+	                                        realCompute in_fluxRight,
+	                                        real & out_netUpdateLeftHeight,
+	                                        real & out_netUpdateLeftMomentum,
+	                                        real & out_netUpdateRightHeight,
+	                                        real & out_netUpdateRightMomentum,
+	                                        real & out_waveSpeed ) {
+		// eigenvalues
+		realCompute heightRoe = realCompute(0.5) * (in_heightLeft + in_heightRight);
+		realCompute particleVelocityRoe = in_particleVelocityLeft * in_sqrtHeightLeft + in_particleVelocityRight * in_sqrtHeightRight;
+		particleVelocityRoe /= in_sqrtHeightLeft + in_sqrtHeightRight;
+
+		realCompute sqrtGTimesHeight = gSqrt * std::sqrt(heightRoe);
+		realCompute eigenvalue0 = particleVelocityRoe - sqrtGTimesHeight;
+		realCompute eigenvalue1 = particleVelocityRoe + sqrtGTimesHeight;
+
+		// inverted eigenmatrix
+		realCompute invertedMatrixDeterminant = 1 / (eigenvalue1 - eigenvalue0);
+		realCompute inverted00 =  invertedMatrixDeterminant * eigenvalue1;
+		realCompute inverted01 = -invertedMatrixDeterminant;
+		realCompute inverted10 = -invertedMatrixDeterminant * eigenvalue0;
+		realCompute inverted11 =  invertedMatrixDeterminant;
+
+		// jump in fluxes including the bathymetry source term
+		realCompute dxPsi = -g * (in_bathymetryRight - in_bathymetryLeft) * (in_heightLeft + in_heightRight) / 2;
+
+		realCompute fluxJump0 = in_momentumRight - in_momentumLeft;
+		realCompute fluxJump1 = in_fluxRight - in_fluxLeft - dxPsi;
+
+		// eigencoefficients and waves
+		realCompute eigencoefficient0 = inverted00 * fluxJump0 + inverted01 * fluxJump1;
+		realCompute eigencoefficient1 = inverted10 * fluxJump0 + inverted11 * fluxJump1;
+
+		realCompute wave0Height = eigencoefficient0;
+		realCompute wave0Momentum = eigencoefficient0 * eigenvalue0;
+		realCompute wave1Height = eigencoefficient1;
+		realCompute wave1Momentum = eigencoefficient1 * eigenvalue1;
 
-void FWave::netUpdates(real in_stateLeft[3], real in_stateRight[3], real out_netUpdateLeft[2], real out_netUpdateRight[2]) {
-	real eigenvalues[2];
-	computeEigenvalues(in_stateLeft, in_stateRight, eigenvalues);
+		// masked assignment of the waves to the left and right sides
+		bool left0 = eigenvalue0 < 0;
+		bool left1 = eigenvalue1 < 0;
 
-	real invertedEigenmatrix[2][2];
-	computeInvertedEigenmatrix(eigenvalues, invertedEigenmatrix);
+		out_netUpdateLeftHeight = real( (left0 ? wave0Height : realCompute(0)) + (left1 ? wave1Height : realCompute(0)) );
+		out_netUpdateLeftMomentum = real( (left0 ? wave0Momentum : realCompute(0)) + (left1 ? wave1Momentum : realCompute(0)) );
+		out_netUpdateRightHeight = real( (left0 ? realCompute(0) : wave0Height) + (left1 ? realCompute(0) : wave1Height) );
+		out_netUpdateRightMomentum = real( (left0 ? realCompute(0) : wave0Momentum) + (left1 ? realCompute(0) : wave1Momentum) );
 
-	real eigencoefficients[2];
-	computeEigencoefficients(in_stateLeft, in_stateRight, invertedEigenmatrix, eigencoefficients);
+		out_waveSpeed = real( std::max( std::abs(eigenvalue0), std::abs(eigenvalue1) ) );
+	}
 
-	real waves[2][2] = {
-		{ eigencoefficients[0], eigencoefficients[0] * eigenvalues[0] },
-		{ eigencoefficients[1], eigencoefficients[1] * eigenvalues[1] }
-	};
+	/**
+	 * Branch-free f-wave solver for a batch of edges.
+	 **/
+	TSUNAMI_LAB_SIMD_INLINE void netUpdatesBatchKernel( idx in_count,
+	                                                     real const * in_heightLeft,
+	                                                     real const * in_heightRight,
+	                                                     real const * in_momentumLeft,
+	                                                     real const * in_momentumRight,
+	                                                     real const * in_bathymetryLeft,
+	                                                     real const * in_bathymetryRight,
+	                                                     real * out_netUpdateLeftHeight,
+	                                                     real * out_netUpdateLeftMomentum,
+	                                                     real * out_netUpdateRightHeight,
+	                                                     real * out_netUpdateRightMomentum,
+	                                                     real * out_waveSpeed ) {
+#pragma omp simd
+		for( idx edge = 0; edge < in_count; edge++ ) {
+			realCompute heightLeft = in_heightLeft[edge];
+			realCompute heightRight = in_heightRight[edge];
+			realCompute momentumLeft = in_momentumLeft[edge];
+			realCompute momentumRight = in_momentumRight[edge];
 
-	out_netUpdateLeft[0] = 0;
-	out_netUpdateLeft[1] = 0;
-	out_netUpdateRight[0] = 0;
-	out_netUpdateRight[1] = 0;
+			solveEdge( heightLeft, heightRight, momentumLeft, momentumRight, in_bathymetryLeft[edge], in_bathymetryRight[edge],
+			           std::sqrt(heightLeft), std::sqrt(heightRight),
+			           particleVelocity( heightLeft, momentumLeft ), particleVelocity( heightRight, momentumRight ),
+			           momentumFlux( heightLeft, momentumLeft ), momentumFlux( heightRight, momentumRight ),
+			           out_netUpdateLeftHeight[edge], out_netUpdateLeftMomentum[edge],
+			           out_netUpdateRightHeight[edge], out_netUpdateRightMomentum[edge],
+			           out_waveSpeed[edge] );
+		}
+	}
+
+	/**
+	 * Branch-free f-wave solver for a batch of edges with cached cell quantities; saves two square roots and four divisions per edge.
+	 **/
+	TSUNAMI_LAB_SIMD_INLINE void netUpdatesBatchCachedKernel( idx in_count,
+	                                                           real const * in_heightLeft,
+	                                                           real const * in_heightRight,
+	                                                           real const * in_momentumLeft,
+	                                                           real const * in_momentumRight,
+	                                                           real const * in_bathymetryLeft,
+	                                                           real const * in_bathymetryRight,
+	                                                           realCompute const * in_sqrtHeightLeft,
+	                                                           realCompute const * in_sqrtHeightRight,
+	                                                           realCompute const * in_velocityLeft,
+	                                                           realCompute const * in_velocityRight,
+	                                                           realCompute const * in_fluxLeft,
+	                                                           realCompute const * in_fluxRight,
+	                                                           real * out_netUpdateLeftHeight,
+	                                                           real * out_netUpdateLeftMomentum,
+	                                                           real * out_netUpdateRightHeight,
+	                                                           real * out_netUpdateRightMomentum,
+	                                                           real * out_waveSpeed ) {
+#pragma omp simd
+		for( idx edge = 0; edge < in_count; edge++ ) {
+			solveEdge( in_heightLeft[edge], in_heightRight[edge], in_momentumLeft[edge], in_momentumRight[edge],
+			           in_bathymetryLeft[edge], in_bathymetryRight[edge],
+			           in_sqrtHeightLeft[edge], in_sqrtHeightRight[edge],
+			           in_velocityLeft[edge], in_velocityRight[edge],
+			           in_fluxLeft[edge], in_fluxRight[edge],
+			           out_netUpdateLeftHeight[edge], out_netUpdateLeftMomentum[edge],
+			           out_netUpdateRightHeight[edge], out_netUpdateRightMomentum[edge],
+			           out_waveSpeed[edge] );
+		}
+	}
 
-	for (int i = 0; i < 2; i++) {
+	/**
+	 * Quantities of a batch of cells which are shared by the edges of the cells.
+	 **/
+	TSUNAMI_LAB_SIMD_INLINE void cellQuantitiesBatchKernel( idx in_count,
+	                                                         real const * in_height,
+	                                                         real const * in_momentum,
+	                                                         realCompute * out_sqrtHeight,
+	                                                         realCompute * out_velocity,
+	                                                         realCompute * out_flux ) {
+#pragma omp simd
+		for( idx cell = 0; cell < in_count; cell++ ) {
+			realCompute height = in_height[cell];
+			realCompute momentum = in_momentum[cell];
 
-		if( eigenvalues[i] < 0 ) {
-			out_netUpdateLeft[0] += waves[i][0];
-			out_netUpdateLeft[1] += waves[i][1];
+			out_sqrtHeight[cell] = std::sqrt(height);
+			out_velocity[cell] = particleVelocity( height, momentum );
+			out_flux[cell] = momentumFlux( height, momentum );
 		}
-		else {
-			out_netUpdateRight[0] += waves[i][0];
-			out_netUpdateRight[1] += waves[i][1];
+	}
+
+	/**
+	 * Net-updates of the wet cells of a batch of wall edges; solveEdge on the mirrored states reduced to the operations which do not vanish.
+	 **/
+	TSUNAMI_LAB_SIMD_INLINE void wallNetUpdatesBatchKernel( idx in_count,
+	                                                         real const * in_height,
+	                                                         real const * in_momentum,
+	                                                         bool in_wallLeft,
+	                                                         real * out_netUpdateHeight,
+	                                                         real * out_netUpdateMomentum,
+	                                                         real * out_waveSpeed ) {
+		// a wall on the left is the mirror image of a wall on the right, the negations are exact
+		realCompute side = in_wallLeft ? -1 : 1;
+
+#pragma omp simd
+		for( idx edge = 0; edge < in_count; edge++ ) {
+			realCompute height = in_height[edge];
+			realCompute momentum = side * in_momentum[edge];
+
+			// eigenvalues -+sqrt(g*h) of the Roe height h and the Roe velocity 0
+			realCompute sqrtGTimesHeight = gSqrt * std::sqrt(height);
+			realCompute invertedMatrixDeterminant = 1 / (sqrtGTimesHeight + sqrtGTimesHeight);
+
+			// both eigencoefficients are equal, the jump in the flux of the momentum vanishes
+			realCompute eigencoefficient = (invertedMatrixDeterminant * sqrtGTimesHeight) * (-momentum - momentum);
+
+			out_netUpdateHeight[edge] = real( eigencoefficient );
+			out_netUpdateMomentum[edge] = real( side * (eigencoefficient * -sqrtGTimesHeight) );
+			out_waveSpeed[edge] = real( sqrtGTimesHeight );
 		}
-  }
+	}
+
+	void netUpdatesBatchGeneric( idx in_count,
+	                             real const * in_hL, real const * in_hR,
+	                             real const * in_huL, real const * in_huR,
+	                             real const * in_bL, real const * in_bR,
+	                             real * out_lH, real * out_lHu, real * out_rH, real * out_rHu, real * out_speed ) {
+		netUpdatesBatchKernel( in_count, in_hL, in_hR, in_huL, in_huR, in_bL, in_bR, out_lH, out_lHu, out_rH, out_rHu, out_speed );
+	}
+
+#ifdef TSUNAMI_LAB_SIMD_X86
+	TSUNAMI_LAB_SIMD_AVX2 void netUpdatesBatchAvx2( idx in_count,
+	                                                real const * in_hL, real const * in_hR,
+	                                                real const * in_huL, real const * in_huR,
+	                                                real const * in_bL, real const * in_bR,
+	                                                real * out_lH, real * out_lHu, real * out_rH, real * out_rHu, real * out_speed ) {
+		netUpdatesBatchKernel( in_count, in_hL, in_hR, in_huL, in_huR, in_bL, in_bR, out_lH, out_lHu, out_rH, out_rHu, out_speed );
+	}
+
+	TSUNAMI_LAB_SIMD_AVX512 void netUpdatesBatchAvx512( idx in_count,
+	                                                    real const * in_hL, real const * in_hR,
+	                                                    real const * in_huL, real const * in_huR,
+	                                                    real const * in_bL, real const * in_bR,
+	                                                    real * out_lH, real * out_lHu, real * out_rH, real * out_rHu, real * out_speed ) {
+		netUpdatesBatchKernel( in_count, in_hL, in_hR, in_huL, in_huR, in_bL, in_bR, out_lH, out_lHu, out_rH, out_rHu, out_speed );
+	}
+#endif
+
+	void netUpdatesBatchCachedGeneric( idx in_count,
+	                                   real const * in_hL, real const * in_hR,
+	                                   real const * in_huL, real const * in_huR,
+	                                   real const * in_bL, real const * in_bR,
+	                                   realCompute const * in_sL, realCompute const * in_sR,
+	                                   realCompute const * in_uL, realCompute const * in_uR,
+	                                   realCompute const * in_fL, realCompute const * in_fR,
+	                                   real * out_lH, real * out_lHu, real * out_rH, real * out_rHu, real * out_speed ) {
+		netUpdatesBatchCachedKernel( in_count, in_hL, in_hR, in_huL, in_huR, in_bL, in_bR, in_sL, in_sR, in_uL, in_uR, in_fL, in_fR,
+		                             out_lH, out_lHu, out_rH, out_rHu, out_speed );
+	}
+
+	void cellQuantitiesBatchGeneric( idx in_count, real const * in_h, real const * in_hu,
+	                                 realCompute * out_sqrtH, realCompute * out_u, realCompute * out_flux ) {
+		cellQuantitiesBatchKernel( in_count, in_h, in_hu, out_sqrtH, out_u, out_flux );
+	}
+
+	void wallNetUpdatesBatchGeneric( idx in_count, real const * in_h, real const * in_hu, bool in_wallLeft,
+	                                 real * out_h, real * out_hu, real * out_speed ) {
+		wallNetUpdatesBatchKernel( in_count, in_h, in_hu, in_wallLeft, out_h, out_hu, out_speed );
+	}
+
+#ifdef TSUNAMI_LAB_SIMD_X86
+	TSUNAMI_LAB_SIMD_AVX2 void netUpdatesBatchCachedAvx2( idx in_count,
+	                                                      real const * in_hL, real const * in_hR,
+	                                                      real const * in_huL, real const * in_huR,
+	                                                      real const * in_bL, real const * in_bR,
+	                                                      realCompute const * in_sL, realCompute const * in_sR,
+	                                                      realCompute const * in_uL, realCompute const * in_uR,
+	                                                      realCompute const * in_fL, realCompute const * in_fR,
+	                                                      real * out_lH, real * out_lHu, real * out_rH, real * out_rHu, real * out_speed ) {
+		netUpdatesBatchCachedKernel( in_count, in_hL, in_hR, in_huL, in_huR, in_bL, in_bR, in_sL, in_sR, in_uL, in_uR, in_fL, in_fR,
+		                             out_lH, out_lHu, out_rH, out_rHu, out_speed );
+	}
+
+	TSUNAMI_LAB_SIMD_AVX512 void netUpdatesBatchCachedAvx512( idx in_count,
+	                                                          real const * in_hL, real const * in_hR,
+	                                                          real const * in_huL, real const * in_huR,
+	                                                          real const * in_bL, real const * in_bR,
+	                                                          realCompute const * in_sL, realCompute const * in_sR,
+	                                                          realCompute const * in_uL, realCompute const * in_uR,
+	                                                          realCompute const * in_fL, realCompute const * in_fR,
+	                                                          real * out_lH, real * out_lHu, real * out_rH, real * out_rHu, real * out_speed ) {
+		netUpdatesBatchCachedKernel( in_count, in_hL, in_hR, in_huL, in_huR, in_bL, in_bR, in_sL, in_sR, in_uL, in_uR, in_fL, in_fR,
+		                             out_lH, out_lHu, out_rH, out_rHu, out_speed );
+	}
+
+	TSUNAMI_LAB_SIMD_AVX2 void cellQuantitiesBatchAvx2( idx in_count, real const * in_h, real const * in_hu,
+	                                                    realCompute * out_sqrtH, realCompute * out_u, realCompute * out_flux ) {
+		cellQuantitiesBatchKernel( in_count, in_h, in_hu, out_sqrtH, out_u, out_flux );
+	}
+
+	TSUNAMI_LAB_SIMD_AVX512 void cellQuantitiesBatchAvx512( idx in_count, real const * in_h, real const * in_hu,
+	                                                        realCompute * out_sqrtH, realCompute * out_u, realCompute * out_flux ) {
+		cellQuantitiesBatchKernel( in_count, in_h, in_hu, out_sqrtH, out_u, out_flux );
+	}
+
+	TSUNAMI_LAB_SIMD_AVX2 void wallNetUpdatesBatchAvx2( idx in_count, real const * in_h, real const * in_hu, bool in_wallLeft,
+	                                                    real * out_h, real * out_hu, real * out_speed ) {
+		wallNetUpdatesBatchKernel( in_count, in_h, in_hu, in_wallLeft, out_h, out_hu, out_speed );
+	}
+
+	TSUNAMI_LAB_SIMD_AVX512 void wallNetUpdatesBatchAvx512( idx in_count, real const * in_h, real const * in_hu, bool in_wallLeft,
+	                                                        real * out_h, real * out_hu, real * out_speed ) {
+		wallNetUpdatesBatchKernel( in_count, in_h, in_hu, in_wallLeft, out_h, out_hu, out_speed );
+	}
+#endif
+
+	t_batchKernel selectBatchKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+		Isa isa = detectIsa();
+		if( isa == AVX512 ) return netUpdatesBatchAvx512;
+		if( isa == AVX2 ) return netUpdatesBatchAvx2;
+#endif
+		return netUpdatesBatchGeneric;
+	}
+
+	t_batchCachedKernel selectBatchCachedKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+		Isa isa = detectIsa();
+		if( isa == AVX512 ) return netUpdatesBatchCachedAvx512;
+		if( isa == AVX2 ) return netUpdatesBatchCachedAvx2;
+#endif
+		return netUpdatesBatchCachedGeneric;
+	}
+
+	t_cellKernel selectCellKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+		Isa isa = detectIsa();
+		if( isa == AVX512 ) return cellQuantitiesBatchAvx512;
+		if( isa == AVX2 ) return cellQuantitiesBatchAvx2;
+#endif
+		return cellQuantitiesBatchGeneric;
+	}
+
+	t_wallKernel selectWallKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+		Isa isa = detectIsa();
+		if( isa == AVX512 ) return wallNetUpdatesBatchAvx512;
+		if( isa == AVX2 ) return wallNetUpdatesBatchAvx2;
+#endif
+		return wallNetUpdatesBatchGeneric;
+	}
+}
+
+void FWave::netUpdatesBatch( idx in_count,
+                             real const * in_heightLeft,
+                             real const * in_heightRight,
+                             real const * in_momentumLeft,
+                             real const * in_momentumRight,
+                             real const * in_bathymetryLeft,
+                             real const * in_bathymetryRight,
+                             real * out_netUpdateLeftHeight,
+                             real * out_netUpdateLeftMomentum,
+                             real * out_netUpdateRightHeight,
+                             real * out_netUpdateRightMomentum,
+                             real * out_waveSpeed ) {
+	static t_batchKernel const kernel = selectBatchKernel();
+
+	kernel( in_count,
+	        in_heightLeft, in_heightRight,
+	        in_momentumLeft, in_momentumRight,
+	        in_bathymetryLeft, in_bathymetryRight,
+	        out_netUpdateLeftHeight, out_netUpdateLeftMomentum,
+	        out_netUpdateRightHeight, out_netUpdateRightMomentum,
+	        out_waveSpeed );
+}
+
+void FWave::netUpdatesBatchCached( idx in_count,
+                                   real const * in_heightLeft,
+                                   real const * in_heightRight,
+                                   real const * in_momentumLeft,
+                                   real const * in_momentumRight,
+                                   real const * in_bathymetryLeft,
+                                   real const * in_bathymetryRight,
+                                   realCompute const * in_sqrtHeightLeft,
+                                   realCompute const * in_sqrtHeightRight,
+                                   realCompute const * in_velocityLeft,
+                                   realCompute const * in_velocityRight,
+                                   realCompute const * in_fluxLeft,
+                                   realCompute const * in_fluxRight,
+                                   real * out_netUpdateLeftHeight,
+                                   real * out_netUpdateLeftMomentum,
+                                   real * out_netUpdateRightHeight,
+                                   real * out_netUpdateRightMomentum,
+                                   real * out_waveSpeed ) {
+	static t_batchCachedKernel const kernel = selectBatchCachedKernel();
+
+	kernel( in_count,
+	        in_heightLeft, in_heightRight,
+	        in_momentumLeft, in_momentumRight,
+	        in_bathymetryLeft, in_bathymetryRight,
+	        in_sqrtHeightLeft, in_sqrtHeightRight,
+	        in_velocityLeft, in_velocityRight,
+	        in_fluxLeft, in_fluxRight,
+	        out_netUpdateLeftHeight, out_netUpdateLeftMomentum,
+	        out_netUpdateRightHeight, out_netUpdateRightMomentum,
+	        out_waveSpeed );
+}
+
+void FWave::cellQuantitiesBatch( idx in_count,
+                                 real const * in_height,
+                                 real const * in_momentum,
+                                 realCompute * out_sqrtHeight,
+                                 realCompute * out_velocity,
+                                 realCompute * out_flux ) {
+	static t_cellKernel const kernel = selectCellKernel();
+
+	kernel( in_count, in_height, in_momentum, out_sqrtHeight, out_velocity, out_flux );
+}
+
+void FWave::wallNetUpdatesBatch( idx in_count,
+                                 real const * in_height,
+                                 real const * in_momentum,
+                                 bool in_wallLeft,
+                                 real * out_netUpdateHeight,
+                                 real * out_netUpdateMomentum,
+                                 real * out_waveSpeed ) {
+	static t_wallKernel const kernel = selectWallKernel();
+
+	kernel( in_count, in_height, in_momentum, in_wallLeft, out_netUpdateHeight, out_netUpdateMomentum, out_waveSpeed );
+}
+
+char const * FWave::getBatchIsa() {
+	return isaName( detectIsa() );
 }
@@ -5,8 +5,12 @@
  * @section DESCRIPTION
  * F-Wave solver for the shallow water equations.
 **/
+#ifndef TSUNAMI_LAB_SOLVERS_FWAVE
+#define TSUNAMI_LAB_SOLVERS_FWAVE
 
 #include "../constants.h"
+#include <algorithm>
+#include <cmath>
 
 namespace tsunami_lab {
 	namespace solvers {
@@ -14,12 +18,18 @@ namespace tsunami_lab {
 	}
 }
 
+/**
+ * @brief F-wave solver for the shallow water equations with bathymetry.
+ *
+ * The states and net-updates are given in real, the solver computes in realCompute, i.e., in double precision
+ * for mixed precision builds, which reduces the cancellation in the jump of the fluxes of deep water.
+ **/
 class tsunami_lab::solvers::FWave {
 	private:
 		//! gravity constant
-		static real constexpr const_g = 9.80665;
+		static realCompute constexpr const_g = 9.80665;
 		//! squareroot of gravity constant
-		static real constexpr const_gSqrt = 3.131557121;
+		static realCompute constexpr const_gSqrt = 3.131557121;
 
 		/**
 		 * @brief Computes the Roe eigenvalues. 
@@ -28,9 +38,9 @@ class tsunami_lab::solvers::FWave {
 		 * @param in_stateRight state of the right side; 0: height, 1: momentum, 2: bathymetry.
 		 * @param out_eigenvaluesRoe will be set to the Roe eigenvalues; 0: lambda^Roe_1, 1: lambda^Roe_2.
 		 */
-		static void computeEigenvalues( real in_stateLeft[3], 
-												  real in_stateRight[3], 
-												  real out_eigenvaluesRoe[2] );
+		static void computeEigenvalues( realCompute in_stateLeft[3], 
+												  realCompute in_stateRight[3], 
+												  realCompute out_eigenvaluesRoe[2] );
 
 		/**
 		 * @brief Calculates the flux function as a vector.
@@ -38,8 +48,8 @@ class tsunami_lab::solvers::FWave {
 		 * @param in_state state of one cell; 0: height, 1: momentum, 2: bathymetry.
 		 * @param out_flux will be set to the flux function values; 0: hu, 1: hu^2+0.5gh^2.
 		 */
-		static void flux( real in_state[3], 
-								real out_flux[2] );
+		static void flux( realCompute in_state[3], 
+								realCompute out_flux[2] );
 		
 		/**
 		 * @brief Calculates the deltaxPsi (bathymetry) function.
@@ -48,9 +58,9 @@ class tsunami_lab::solvers::FWave {
 		 * @param in_stateRight state of the right side; 0: height, 1: momentum, 2: bathymetry.
 		 * @param out_dxPsi will be set to the dxPsi function; -g*(bathymetryRight-bathymetryLeft)*((heightLeft+heightRight) / 2).
 		 */
-		static void computeDxPsi( real in_stateLeft[3],
-										  real in_stateRight[3],
-										  real & out_dxPsi);
+		static void computeDxPsi( realCompute in_stateLeft[3],
+										  realCompute in_stateRight[3],
+										  realCompute & out_dxPsi);
 
 		/**
 		 * @brief Computes the inverted eigenmatrix.
@@ -58,8 +68,8 @@ class tsunami_lab::solvers::FWave {
 		 * @param in_eigenvalues Roe eigenvalues; 0: lambda^Roe_1, 1: lambda^Roe_2.
 		 * @param out_invertedEigenmatrix will be set to the inverted eigenmatrix; 0: eigenvector r1, 1: eigenvector r2.
 		 */
-		static void computeInvertedEigenmatrix( real in_eigenvalues[2], 
-															 real out_invertedEigenmatrix[2][2] );
+		static void computeInvertedEigenmatrix( realCompute in_eigenvalues[2], 
+															 realCompute out_invertedEigenmatrix[2][2] );
 
 		/**
 		 * @brief Computes the eigencoefficients.
@@ -69,10 +79,10 @@ class tsunami_lab::solvers::FWave {
 		 * @param in_invertedEigenmatrix inverted eigenmatrix; 0: eigenvector r1, 1: eigenvector r2.
 		 * @param out_eigencoefficients will be set to the eigencoefficients; 0: alpha_1, 1: alpha_2.
 		 */
-		static void computeEigencoefficients( real in_stateLeft[3], 
-														  real in_stateRight[3], 
-														  real in_invertedEigenmatrix[2][2], 
-														  real out_eigencoefficients[2] );
+		static void computeEigencoefficients( realCompute in_stateLeft[3], 
+														  realCompute in_stateRight[3], 
+														  realCompute in_invertedEigenmatrix[2][2], 
+														  realCompute out_eigencoefficients[2] );
 
 	public:
 		/**
@@ -87,4 +97,291 @@ class tsunami_lab::solvers::FWave {
 	 									real in_stateRight[3], 
 										real out_netUpdateLeft[2], 
 										real out_netUpdateRight[2] );
+
+		/**
+		 * @brief Computes the net-updates and the maximum wave speed of the edge.
+		 * 
+		 * @param in_stateLeft state of the left side; 0: height, 1: momentum, 2: bathymetry.
+		 * @param in_stateRight state of the right side; 0: height, 1: momentum, 2: bathymetry.
+		 * @param out_netUpdateLeft will be set to the net-updates for the left side; 0: height, 1: momentum.
+		 * @param out_netUpdateRight will be set to the net-updates for the left side; 0: height, 1: momentum.
+		 * @param out_waveSpeedMax will be set to the maximum absolute value of the Roe eigenvalues.
+		 */
+		static void netUpdates( real in_stateLeft[3], 
+	 									real in_stateRight[3], 
+										real out_netUpdateLeft[2], 
+										real out_netUpdateRight[2],
+										real & out_waveSpeedMax );
+
+		/**
+		 * @brief Computes the net-updates and the maximum wave speed of an edge given by the quantities of its cells.
+		 *
+		 * Common interface of the solvers, which is used by the patches templated on the solver.
+		 * 
+		 * @param in_heightLeft height of the left side.
+		 * @param in_heightRight height of the right side.
+		 * @param in_momentumLeft momentum of the left side.
+		 * @param in_momentumRight momentum of the right side.
+		 * @param in_bathymetryLeft bathymetry of the left side.
+		 * @param in_bathymetryRight bathymetry of the right side.
+		 * @param out_netUpdateLeft will be set to the net-updates for the left side; 0: height, 1: momentum.
+		 * @param out_netUpdateRight will be set to the net-updates for the left side; 0: height, 1: momentum.
+		 * @param out_waveSpeedMax will be set to the maximum absolute value of the Roe eigenvalues.
+		 */
+		static void netUpdates( real in_heightLeft,
+		                        real in_heightRight,
+		                        real in_momentumLeft,
+		                        real in_momentumRight,
+		                        real in_bathymetryLeft,
+		                        real in_bathymetryRight,
+		                        real out_netUpdateLeft[2],
+		                        real out_netUpdateRight[2],
+		                        real & out_waveSpeedMax );
+
+		/**
+		 * @brief Computes the net-updates of a batch of edges given as structure of arrays.
+		 *
+		 * The edges are solved branch-free in SIMD registers; the instruction set (AVX-512, AVX2 or the generic build target)
+		 * is selected once at runtime based on the features of the CPU.
+		 * The batch performs the same operations in the same order as netUpdates. Results are bitwise identical to the scalar
+		 * solver if floating point contraction is disabled (-ffp-contract=off, set by the build) and agree within a few ulp otherwise.
+		 *
+		 * @param in_count number of edges.
+		 * @param in_heightLeft heights of the left sides.
+		 * @param in_heightRight heights of the right sides.
+		 * @param in_momentumLeft momenta of the left sides.
+		 * @param in_momentumRight momenta of the right sides.
+		 * @param in_bathymetryLeft bathymetry of the left sides.
+		 * @param in_bathymetryRight bathymetry of the right sides.
+		 * @param out_netUpdateLeftHeight will be set to the net-updates of the height for the left sides.
+		 * @param out_netUpdateLeftMomentum will be set to the net-updates of the momentum for the left sides.
+		 * @param out_netUpdateRightHeight will be set to the net-updates of the height for the right sides.
+		 * @param out_netUpdateRightMomentum will be set to the net-updates of the momentum for the right sides.
+		 * @param out_waveSpeed will be set to the maximum absolute values of the Roe eigenvalues.
+		 */
+		static void netUpdatesBatch( idx in_count,
+		                             real const * in_heightLeft,
+		                             real const * in_heightRight,
+		                             real const * in_momentumLeft,
+		                             real const * in_momentumRight,
+		                             real const * in_bathymetryLeft,
+		                             real const * in_bathymetryRight,
+		                             real * out_netUpdateLeftHeight,
+		                             real * out_netUpdateLeftMomentum,
+		                             real * out_netUpdateRightHeight,
+		                             real * out_netUpdateRightMomentum,
+		                             real * out_waveSpeed );
+
+		/**
+		 * @brief Computes the quantities of a batch of cells which are shared by the edges of the cells.
+		 *
+		 * In 2D every cell is part of four edges. Computing the square root of the height, the particle velocity and the flux
+		 * of the momentum once per cell and sweep saves two square roots and four divisions per edge in netUpdatesBatchCached.
+		 *
+		 * @param in_count number of cells.
+		 * @param in_height heights of the cells.
+		 * @param in_momentum momenta of the cells in the direction of the sweep.
+		 * @param out_sqrtHeight will be set to the square roots of the heights.
+		 * @param out_velocity will be set to the particle velocities.
+		 * @param out_flux will be set to the fluxes of the momentum: hu^2/h+0.5gh^2.
+		 */
+		static void cellQuantitiesBatch( idx in_count,
+		                                 real const * in_height,
+		                                 real const * in_momentum,
+		                                 realCompute * out_sqrtHeight,
+		                                 realCompute * out_velocity,
+		                                 realCompute * out_flux );
+
+		/**
+		 * @brief Computes the net-updates of a batch of edges with the cell quantities of cellQuantitiesBatch.
+		 *
+		 * Results are bitwise identical to netUpdatesBatch.
+		 *
+		 * @param in_count number of edges.
+		 * @param in_heightLeft heights of the left sides.
+		 * @param in_heightRight heights of the right sides.
+		 * @param in_momentumLeft momenta of the left sides.
+		 * @param in_momentumRight momenta of the right sides.
+		 * @param in_bathymetryLeft bathymetry of the left sides.
+		 * @param in_bathymetryRight bathymetry of the right sides.
+		 * @param in_sqrtHeightLeft square roots of the heights of the left sides.
+		 * @param in_sqrtHeightRight square roots of the heights of the right sides.
+		 * @param in_velocityLeft particle velocities of the left sides.
+		 * @param in_velocityRight particle velocities of the right sides.
+		 * @param in_fluxLeft fluxes of the momentum of the left sides.
+		 * @param in_fluxRight fluxes of the momentum of the right sides.
+		 * @param out_netUpdateLeftHeight will be set to the net-updates of the height for the left sides.
+		 * @param out_netUpdateLeftMomentum will be set to the net-updates of the momentum for the left sides.
+		 * @param out_netUpdateRightHeight will be set to the net-updates of the height for the right sides.
+		 * @param out_netUpdateRightMomentum will be set to the net-updates of the momentum for the right sides.
+		 * @param out_waveSpeed will be set to the maximum absolute values of the Roe eigenvalues.
+		 */
+		static void netUpdatesBatchCached( idx in_count,
+		                                   real const * in_heightLeft,
+		                                   real const * in_heightRight,
+		                                   real const * in_momentumLeft,
+		                                   real const * in_momentumRight,
+		                                   real const * in_bathymetryLeft,
+		                                   real const * in_bathymetryRight,
+		                                   realCompute const * in_sqrtHeightLeft,
+		                                   realCompute const * in_sqrtHeightRight,
+		                                   realCompute const * in_velocityLeft,
+		                                   realCompute const * in_velocityRight,
+		                                   realCompute const * in_fluxLeft,
+		                                   realCompute const * in_fluxRight,
+		                                   real * out_netUpdateLeftHeight,
+		                                   real * out_netUpdateLeftMomentum,
+		                                   real * out_netUpdateRightHeight,
+		                                   real * out_netUpdateRightMomentum,
+		                                   real * out_waveSpeed );
+
+		/**
+		 * @brief Computes the net-updates of the wet cells of a batch of edges whose other cell is dry, i.e., a reflecting wall.
+		 *
+		 * The wall mirrors the wet cell with the negated momentum. Thus, the Roe velocity vanishes, the waves are +-sqrt(g*h)
+		 * and their strengths follow from the jump in the momentum only, which saves the square roots of the cells, three divisions
+		 * and the fluxes of netUpdatesBatch. Results are bitwise identical to netUpdatesBatch on the mirrored states.
+		 *
+		 * @param in_count number of edges.
+		 * @param in_height heights of the wet cells.
+		 * @param in_momentum momenta of the wet cells.
+		 * @param in_wallLeft true if the walls are left of the wet cells, false if they are right of them.
+		 * @param out_netUpdateHeight will be set to the net-updates of the height for the wet cells.
+		 * @param out_netUpdateMomentum will be set to the net-updates of the momentum for the wet cells.
+		 * @param out_waveSpeed will be set to the maximum absolute values of the Roe eigenvalues.
+		 */
+		static void wallNetUpdatesBatch( idx in_count,
+		                                 real const * in_height,
+		                                 real const * in_momentum,
+		                                 bool in_wallLeft,
+		                                 real * out_netUpdateHeight,
+		                                 real * out_netUpdateMomentum,
+		                                 real * out_waveSpeed );
+
+		/**
+		 * @brief Gets the instruction set used by netUpdatesBatch.
+		 *
+		 * @return name of the instruction set: avx512, avx2 or generic.
+		 */
+		static char const * getBatchIsa();
 };
+
+// the scalar solver is defined inline, such that it is inlined into the edge loops of the patches
+inline void tsunami_lab::solvers::FWave::computeEigenvalues(realCompute in_stateLeft[3], realCompute in_stateRight[3], realCompute out_eigenvaluesRoe[2]) {
+	realCompute heightLeft = in_stateLeft[0];
+	realCompute heightRight = in_stateRight[0];
+	realCompute momentumLeft = in_stateLeft[1];
+	realCompute momentumRight = in_stateRight[1];
+
+	realCompute sqrtHeightLeft = std::sqrt(heightLeft);
+	realCompute sqrtHeightRight = std::sqrt(heightRight);
+	realCompute particleVelocityLeft = momentumLeft / heightLeft;
+	realCompute particleVelocityRight = momentumRight / heightRight;
+	
+	realCompute heightRoe = realCompute(0.5) * (heightLeft + heightRight);
+	realCompute particleVelocityRoe = particleVelocityLeft * sqrtHeightLeft + particleVelocityRight * sqrtHeightRight;
+	particleVelocityRoe /= sqrtHeightLeft + sqrtHeightRight;
+
+	realCompute sqrtGTimesHeight = const_gSqrt * std::sqrt(heightRoe);
+	
+	out_eigenvaluesRoe[0] = particleVelocityRoe - sqrtGTimesHeight;
+	out_eigenvaluesRoe[1] = particleVelocityRoe + sqrtGTimesHeight;
+}
+
+inline void tsunami_lab::solvers::FWave::computeInvertedEigenmatrix(realCompute in_eigenvalues[2], realCompute out_invertedEigenmatrix[2][2]) {
+	realCompute invertedMatrixDeterminant = 1 / (in_eigenvalues[1] - in_eigenvalues[0]);
+
+	out_invertedEigenmatrix[0][0] =  invertedMatrixDeterminant * in_eigenvalues[1];
+	out_invertedEigenmatrix[0][1] = -invertedMatrixDeterminant;
+	out_invertedEigenmatrix[1][0] = -invertedMatrixDeterminant * in_eigenvalues[0];
+	out_invertedEigenmatrix[1][1] =  invertedMatrixDeterminant;
+}
+
+inline void tsunami_lab::solvers::FWave::flux(realCompute in_state[3], realCompute out_flux[2]) {
+	realCompute height = in_state[0];
+	realCompute momentum = in_state[1];
+
+	out_flux[0] = momentum;
+	out_flux[1] = (momentum * momentum / height + realCompute(0.5) * const_g * height * height);
+}
+
+inline void tsunami_lab::solvers::FWave::computeDxPsi(realCompute in_stateLeft[3], realCompute in_stateRight[3], realCompute & out_dxPsi) {
+	realCompute heightLeft = in_stateLeft[0];
+	realCompute heightRight = in_stateRight[0];
+	realCompute bathymetryLeft = in_stateLeft[2];
+	realCompute bathymetryRight = in_stateRight[2];
+	
+	//			   -g	  *	 bathymetryRight - bathymetryLeft  *  heightLeft + heightRight   / 2
+	out_dxPsi = -const_g * (bathymetryRight - bathymetryLeft) * (heightLeft + heightRight) / 2;
+}
+
+inline void tsunami_lab::solvers::FWave::computeEigencoefficients(realCompute in_stateLeft[3], realCompute in_stateRight[3], realCompute in_invertedEigenmatrix[2][2], realCompute out_eigencoefficients[2]) {
+	realCompute fluxJumpLeft[2];
+	realCompute fluxJumpRight[2];
+	realCompute dxPsi;
+
+	flux(in_stateLeft, fluxJumpLeft);
+	flux(in_stateRight, fluxJumpRight);
+	computeDxPsi(in_stateLeft, in_stateRight, dxPsi);
+	
+	realCompute fluxJump[2] = {
+		fluxJumpRight[0] - fluxJumpLeft[0],
+		fluxJumpRight[1] - fluxJumpLeft[1] - dxPsi
+	};
+
+	out_eigencoefficients[0] = in_invertedEigenmatrix[0][0] * fluxJump[0] + in_invertedEigenmatrix[0][1] * fluxJump[1];
+	out_eigencoefficients[1] =	in_invertedEigenmatrix[1][0] * fluxJump[0] + in_invertedEigenmatrix[1][1] * fluxJump[1];
+}
+
+inline void tsunami_lab::solvers::FWave::netUpdates(real in_stateLeft[3], real in_stateRight[3], real out_netUpdateLeft[2], real out_netUpdateRight[2]) {
+	real waveSpeedMax;
+	netUpdates(in_stateLeft, in_stateRight, out_netUpdateLeft, out_netUpdateRight, waveSpeedMax);
+}
+
+inline void tsunami_lab::solvers::FWave::netUpdates(real in_stateLeft[3], real in_stateRight[3], real out_netUpdateLeft[2], real out_netUpdateRight[2], real & out_waveSpeedMax) {
+	realCompute stateLeft[3] = { in_stateLeft[0], in_stateLeft[1], in_stateLeft[2] };
+	realCompute stateRight[3] = { in_stateRight[0], in_stateRight[1], in_stateRight[2] };
+
+	realCompute eigenvalues[2];
+	computeEigenvalues(stateLeft, stateRight, eigenvalues);
+	out_waveSpeedMax = real(std::max(std::abs(eigenvalues[0]), std::abs(eigenvalues[1])));
+
+	realCompute invertedEigenmatrix[2][2];
+	computeInvertedEigenmatrix(eigenvalues, invertedEigenmatrix);
+
+	realCompute eigencoefficients[2];
+	computeEigencoefficients(stateLeft, stateRight, invertedEigenmatrix, eigencoefficients);
+
+	realCompute waves[2][2] = {
+		{ eigencoefficients[0], eigencoefficients[0] * eigenvalues[0] },
+		{ eigencoefficients[1], eigencoefficients[1] * eigenvalues[1] }
+	};
+
+	realCompute netUpdateLeft[2] = { 0, 0 };
+	realCompute netUpdateRight[2] = { 0, 0 };
+
+	for (int i = 0; i < 2; i++) {
+
+		if( eigenvalues[i] < 0 ) {
+			netUpdateLeft[0] += waves[i][0];
+			netUpdateLeft[1] += waves[i][1];
+		}
+		else {
+			netUpdateRight[0] += waves[i][0];
+			netUpdateRight[1] += waves[i][1];
+		}
+  }
+
+	out_netUpdateLeft[0] = real(netUpdateLeft[0]);
+	out_netUpdateLeft[1] = real(netUpdateLeft[1]);
+	out_netUpdateRight[0] = real(netUpdateRight[0]);
+	out_netUpdateRight[1] = real(netUpdateRight[1]);
+}
+
+inline void tsunami_lab::solvers::FWave::netUpdates(real in_heightLeft, real in_heightRight, real in_momentumLeft, real in_momentumRight, real in_bathymetryLeft, real in_bathymetryRight, real out_netUpdateLeft[2], real out_netUpdateRight[2], real & out_waveSpeedMax) {
+	real stateLeft[3] = { in_heightLeft, in_momentumLeft, in_bathymetryLeft };
+	real stateRight[3] = { in_heightRight, in_momentumRight, in_bathymetryRight };
+	netUpdates(stateLeft, stateRight, out_netUpdateLeft, out_netUpdateRight, out_waveSpeedMax);
+}
+
+#endif
@@ -6,6 +6,9 @@
  * Unit tests of the F-Wave solver.
  **/
 #include <catch2/catch.hpp>
+#include <limits>
+#include <random>
+#include <vector>
 #define private public
 #include "FWave.h"
 #undef public
@@ -28,9 +31,9 @@ TEST_CASE("Test the computation of the Eigenvalues (FWave speeds).", "[FWaveEige
  * wolframalpha.com query: ((-3/10) * sqrt(10) + (3/9) * sqrt(9)) / (sqrt(10) + sqrt(9)) - sqrt(9.80665 * 9.5)
  */
 
-float stateLeft[3] =  {10, -3, 0};
-float stateRight[3] = {9, 3, 0};
-float eigenvaluesRoe[2];
+tsunami_lab::t_realCompute stateLeft[3] =  {10, -3, 0};
+tsunami_lab::t_realCompute stateRight[3] = {9, 3, 0};
+tsunami_lab::t_realCompute eigenvaluesRoe[2];
 tsunami_lab::solvers::FWave::computeEigenvalues( stateLeft,
                                                  stateRight,
                                                  eigenvaluesRoe );
@@ -67,8 +70,8 @@ TEST_CASE("Test the computation of the InvertedEigenmatrix.", "[FWaveInvertedEig
  *
  */
 
-float eigenvalues[2] = {-9.7311093998375095, 9.5731051658991654};
-float invertedEigenmatrix[2][2];
+tsunami_lab::t_realCompute eigenvalues[2] = {-9.7311093998375095, 9.5731051658991654};
+tsunami_lab::t_realCompute invertedEigenmatrix[2][2];
 tsunami_lab::solvers::FWave::computeInvertedEigenmatrix( eigenvalues,
                                                          invertedEigenmatrix );
 
@@ -100,10 +103,10 @@ TEST_CASE("Test the computation of the Eigencoefficients (wave strenghts).", "[F
  *
  */
 
-float eigenmatrix[2][2] = {{0.49590751974393229, -0.051802159398648326}, {0.50409248025606771, 0.051802159398648326}};
-float stateLeft[3] = {10, -30, 0};
-float stateRight[3] = {9, 27, 0};
-float eigencoefficients[2];
+tsunami_lab::t_realCompute eigenmatrix[2][2] = {{0.49590751974393229, -0.051802159398648326}, {0.50409248025606771, 0.051802159398648326}};
+tsunami_lab::t_realCompute stateLeft[3] = {10, -30, 0};
+tsunami_lab::t_realCompute stateRight[3] = {9, 27, 0};
+tsunami_lab::t_realCompute eigencoefficients[2];
 tsunami_lab::solvers::FWave::computeEigencoefficients( stateLeft,
                                                        stateRight,
                                                        eigenmatrix,
@@ -138,10 +141,10 @@ TEST_CASE("Test the derivation of the FWave net-updates.", "[FWaveUpdates]")
  *                      | s2 |   | 224.4031581938423361414   |
  */
 
-float stateLeft[3] = {10, -30, 0};
-float stateRight[3] = {9, 27, 0};
-float netUpdateLeft[2];
-float netUpdateRight[2];
+tsunami_lab::t_real stateLeft[3] = {10, -30, 0};
+tsunami_lab::t_real stateRight[3] = {9, 27, 0};
+tsunami_lab::t_real netUpdateLeft[2];
+tsunami_lab::t_real netUpdateRight[2];
 
 tsunami_lab::solvers::FWave::netUpdates( stateLeft,
                                          stateRight,
@@ -198,11 +201,13 @@ stateLeft[0] = 10;
 stateLeft[1] = 0;
 stateRight[0] = 8;
 stateRight[1] = 0;
+tsunami_lab::t_real waveSpeedMax = 0;
 
 tsunami_lab::solvers::FWave::netUpdates( stateLeft,
                                          stateRight,
                                          netUpdateLeft,
-                                         netUpdateRight );
+                                         netUpdateRight,
+                                         waveSpeedMax );
 
 REQUIRE(netUpdateLeft[0] == Approx(9.39468));
 REQUIRE(netUpdateLeft[1] == Approx(-88.2599));
@@ -210,6 +215,8 @@ REQUIRE(netUpdateLeft[1] == Approx(-88.2599));
 REQUIRE(netUpdateRight[0] == Approx(-9.39468));
 REQUIRE(netUpdateRight[1] == Approx(-88.2599));
 
+REQUIRE(waveSpeedMax == Approx(9.394671362));
+
 /*
  * Test case supersonic problem
  *
@@ -331,4 +338,141 @@ REQUIRE(netUpdateLeft[1] == Approx(-397.17));
 
 REQUIRE(netUpdateRight[0] == Approx(-42.2761));
 REQUIRE(netUpdateRight[1] == Approx(-397.17));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test the batched FWave net-updates against the scalar solver.", "[FWaveUpdatesBatch]")
+{
+/*
+ * The batch contains the states of the test cases above followed by pseudo-random wet states.
+ * The batch (vectorized, see getBatchIsa) agrees with the scalar solver within 1 ulp
+ * (bitwise with the build's -ffp-contract=off).
+ */
+const std::size_t count = 4 + 1000;
+std::vector< tsunami_lab::t_real > heightLeft( count ), heightRight( count );
+std::vector< tsunami_lab::t_real > momentumLeft( count ), momentumRight( count );
+std::vector< tsunami_lab::t_real > bathymetryLeft( count ), bathymetryRight( count );
+
+tsunami_lab::t_real states[4][6] = { {  10, 9, -30, 27,  0,   0 },
+                       {  10, 8,   0,  0,  0,   0 },
+                       {   1, 1, 100, 10,  0,   0 },
+                       {  10, 8,   0,  0, -6, -13 } };
+
+for( std::size_t edge = 0; edge < 4; edge++ ) {
+  heightLeft[edge] = states[edge][0];
+  heightRight[edge] = states[edge][1];
+  momentumLeft[edge] = states[edge][2];
+  momentumRight[edge] = states[edge][3];
+  bathymetryLeft[edge] = states[edge][4];
+  bathymetryRight[edge] = states[edge][5];
+}
+
+std::mt19937 generator( 42 );
+std::uniform_real_distribution< tsunami_lab::t_real > height( 0.1, 100 );
+std::uniform_real_distribution< tsunami_lab::t_real > velocity( -50, 50 );
+std::uniform_real_distribution< tsunami_lab::t_real > bathymetry( -100, 0 );
+for( std::size_t edge = 4; edge < count; edge++ ) {
+  heightLeft[edge] = height( generator );
+  heightRight[edge] = height( generator );
+  momentumLeft[edge] = heightLeft[edge] * velocity( generator );
+  momentumRight[edge] = heightRight[edge] * velocity( generator );
+  bathymetryLeft[edge] = bathymetry( generator );
+  bathymetryRight[edge] = bathymetry( generator );
+}
+
+std::vector< tsunami_lab::t_real > netUpdateLeftHeight( count ), netUpdateLeftMomentum( count );
+std::vector< tsunami_lab::t_real > netUpdateRightHeight( count ), netUpdateRightMomentum( count );
+std::vector< tsunami_lab::t_real > waveSpeed( count );
+
+tsunami_lab::solvers::FWave::netUpdatesBatch( count,
+                                              heightLeft.data(),
+                                              heightRight.data(),
+                                              momentumLeft.data(),
+                                              momentumRight.data(),
+                                              bathymetryLeft.data(),
+                                              bathymetryRight.data(),
+                                              netUpdateLeftHeight.data(),
+                                              netUpdateLeftMomentum.data(),
+                                              netUpdateRightHeight.data(),
+                                              netUpdateRightMomentum.data(),
+                                              waveSpeed.data() );
+
+for( std::size_t edge = 0; edge < count; edge++ ) {
+  tsunami_lab::t_real stateLeft[3] = { heightLeft[edge], momentumLeft[edge], bathymetryLeft[edge] };
+  tsunami_lab::t_real stateRight[3] = { heightRight[edge], momentumRight[edge], bathymetryRight[edge] };
+  tsunami_lab::t_real netUpdateLeft[2];
+  tsunami_lab::t_real netUpdateRight[2];
+  tsunami_lab::t_real waveSpeedMax;
+
+  tsunami_lab::solvers::FWave::netUpdates( stateLeft,
+                                           stateRight,
+                                           netUpdateLeft,
+                                           netUpdateRight,
+                                           waveSpeedMax );
+
+  tsunami_lab::t_real ulp = std::numeric_limits< tsunami_lab::t_real >::epsilon();
+  REQUIRE( netUpdateLeftHeight[edge] == Approx( netUpdateLeft[0] ).epsilon( ulp ).margin( ulp ) );
+  REQUIRE( netUpdateLeftMomentum[edge] == Approx( netUpdateLeft[1] ).epsilon( ulp ).margin( ulp ) );
+  REQUIRE( netUpdateRightHeight[edge] == Approx( netUpdateRight[0] ).epsilon( ulp ).margin( ulp ) );
+  REQUIRE( netUpdateRightMomentum[edge] == Approx( netUpdateRight[1] ).epsilon( ulp ).margin( ulp ) );
+  REQUIRE( waveSpeed[edge] == Approx( waveSpeedMax ).epsilon( ulp ).margin( ulp ) );
+}
+}
+
+TEST_CASE("Test the FWave net-updates of reflecting walls against the mirrored states.", "[FWaveUpdatesWall]")
+{
+/*
+ * A wall mirrors the wet cell with the negated momentum. The closed-form update of the wet side is bitwise identical to the batch.
+ */
+const std::size_t count = 1000;
+std::vector< tsunami_lab::t_real > heightWet( count ), momentumWet( count ), momentumMirror( count ), bathymetryWet( count );
+
+std::mt19937 generator( 42 );
+std::uniform_real_distribution< tsunami_lab::t_real > height( 0.1, 100 );
+std::uniform_real_distribution< tsunami_lab::t_real > velocity( -50, 50 );
+std::uniform_real_distribution< tsunami_lab::t_real > bathymetry( -100, 0 );
+for( std::size_t edge = 0; edge < count; edge++ ) {
+  heightWet[edge] = height( generator );
+  momentumWet[edge] = heightWet[edge] * velocity( generator );
+  momentumMirror[edge] = -momentumWet[edge];
+  bathymetryWet[edge] = bathymetry( generator );
+}
+
+std::vector< tsunami_lab::t_real > netUpdateLeftHeight( count ), netUpdateLeftMomentum( count );
+std::vector< tsunami_lab::t_real > netUpdateRightHeight( count ), netUpdateRightMomentum( count );
+std::vector< tsunami_lab::t_real > waveSpeed( count );
+std::vector< tsunami_lab::t_real > netUpdateWallHeight( count ), netUpdateWallMomentum( count ), waveSpeedWall( count );
+
+for( unsigned short side = 0; side < 2; side++ ) {
+  // wall right of the wet cells (side 0) or left of them (side 1)
+  bool wallLeft = side == 1;
+  tsunami_lab::t_real const * momentumLeft = wallLeft ? momentumMirror.data() : momentumWet.data();
+  tsunami_lab::t_real const * momentumRight = wallLeft ? momentumWet.data() : momentumMirror.data();
+
+  tsunami_lab::solvers::FWave::netUpdatesBatch( count,
+                                                heightWet.data(),
+                                                heightWet.data(),
+                                                momentumLeft,
+                                                momentumRight,
+                                                bathymetryWet.data(),
+                                                bathymetryWet.data(),
+                                                netUpdateLeftHeight.data(),
+                                                netUpdateLeftMomentum.data(),
+                                                netUpdateRightHeight.data(),
+                                                netUpdateRightMomentum.data(),
+                                                waveSpeed.data() );
+
+  tsunami_lab::solvers::FWave::wallNetUpdatesBatch( count,
+                                                    heightWet.data(),
+                                                    momentumWet.data(),
+                                                    wallLeft,
+                                                    netUpdateWallHeight.data(),
+                                                    netUpdateWallMomentum.data(),
+                                                    waveSpeedWall.data() );
+
+  for( std::size_t edge = 0; edge < count; edge++ ) {
+    REQUIRE( netUpdateWallHeight[edge] == ( wallLeft ? netUpdateRightHeight[edge] : netUpdateLeftHeight[edge] ) );
+    REQUIRE( netUpdateWallMomentum[edge] == ( wallLeft ? netUpdateRightMomentum[edge] : netUpdateLeftMomentum[edge] ) );
+    REQUIRE( waveSpeedWall[edge] == waveSpeed[edge] );
+  }
+}
+}
@@ -0,0 +1,124 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Micro-benchmarks of the Riemann solvers.
+ **/
+#include "../benchmarks/Benchmark.h"
+#include "FWave.h"
+#include "Roe.h"
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  //! number of edges of a batch; the states and net-updates (11 values per edge) stay in the L2 cache
+  tsunami_lab::idx const edgeCount = 4096;
+
+  //! number of passes over the batch per measured run
+  tsunami_lab::idx const passCount = 64;
+
+  //! number of measured runs
+  unsigned int const repetitionCount = 9;
+
+  /**
+   * Randomized states of ocean-like edges: depths of 1 m to 5 km (uniform in the exponent), surface elevations of +-1 m,
+   * velocities of +-2 m/s and neighbouring cells whose depths differ by up to 10%.
+   * The generator is seeded, such that all runs and versions solve the same edges.
+   **/
+  struct Edges {
+    std::vector< tsunami_lab::real > heightLeft, heightRight;
+    std::vector< tsunami_lab::real > momentumLeft, momentumRight;
+    std::vector< tsunami_lab::real > bathymetryLeft, bathymetryRight;
+
+    Edges() {
+      std::mt19937 generator( 2023 );
+      std::uniform_real_distribution< double > exponent( 0, std::log10( 5000.0 ) );
+      std::uniform_real_distribution< double > elevation( -1, 1 );
+      std::uniform_real_distribution< double > velocity( -2, 2 );
+      std::uniform_real_distribution< double > ratio( 0.9, 1.1 );
+
+      for( tsunami_lab::idx edge = 0; edge < edgeCount; edge++ ) {
+        double depthLeft = std::pow( 10.0, exponent( generator ) );
+        double depthRight = depthLeft * ratio( generator );
+        double hL = depthLeft + elevation( generator );
+        double hR = depthRight + elevation( generator );
+
+        heightLeft.push_back( tsunami_lab::real( hL ) );
+        heightRight.push_back( tsunami_lab::real( hR ) );
+        momentumLeft.push_back( tsunami_lab::real( hL * velocity( generator ) ) );
+        momentumRight.push_back( tsunami_lab::real( hR * velocity( generator ) ) );
+        bathymetryLeft.push_back( tsunami_lab::real( -depthLeft ) );
+        bathymetryRight.push_back( tsunami_lab::real( -depthRight ) );
+      }
+    }
+  };
+
+  /**
+   * Measures the time per edge of the scalar solver (called per edge, as by the patches before batching) and of the batched solver.
+   *
+   * @param in_name name of the solver in the report.
+   * @param io_stream stream to which the results are written.
+   *
+   * @tparam t_solver Riemann solver.
+   **/
+  template< typename t_solver >
+  void benchSolver( std::string const & in_name,
+                    std::ostream & io_stream ) {
+    Edges edges;
+    std::vector< tsunami_lab::real > netUpdateLeftHeight( edgeCount ), netUpdateLeftMomentum( edgeCount );
+    std::vector< tsunami_lab::real > netUpdateRightHeight( edgeCount ), netUpdateRightMomentum( edgeCount );
+    std::vector< tsunami_lab::real > waveSpeed( edgeCount );
+
+    double timeScalar = tsunami_lab::benchmarks::Benchmark::median( repetitionCount, [&]() {
+      for( tsunami_lab::idx pass = 0; pass < passCount; pass++ ) {
+        for( tsunami_lab::idx edge = 0; edge < edgeCount; edge++ ) {
+          tsunami_lab::real netUpdateLeft[2];
+          tsunami_lab::real netUpdateRight[2];
+          t_solver::netUpdates( edges.heightLeft[edge], edges.heightRight[edge],
+                                edges.momentumLeft[edge], edges.momentumRight[edge],
+                                edges.bathymetryLeft[edge], edges.bathymetryRight[edge],
+                                netUpdateLeft, netUpdateRight, waveSpeed[edge] );
+          netUpdateLeftHeight[edge] = netUpdateLeft[0];
+          netUpdateLeftMomentum[edge] = netUpdateLeft[1];
+          netUpdateRightHeight[edge] = netUpdateRight[0];
+          netUpdateRightMomentum[edge] = netUpdateRight[1];
+        }
+      }
+    } );
+
+    double timeBatch = tsunami_lab::benchmarks::Benchmark::median( repetitionCount, [&]() {
+      for( tsunami_lab::idx pass = 0; pass < passCount; pass++ ) {
+        t_solver::netUpdatesBatch( edgeCount,
+                                   edges.heightLeft.data(), edges.heightRight.data(),
+                                   edges.momentumLeft.data(), edges.momentumRight.data(),
+                                   edges.bathymetryLeft.data(), edges.bathymetryRight.data(),
+                                   netUpdateLeftHeight.data(), netUpdateLeftMomentum.data(),
+                                   netUpdateRightHeight.data(), netUpdateRightMomentum.data(),
+                                   waveSpeed.data() );
+      }
+    } );
+
+    double edgesSolved = double(edgeCount) * passCount;
+
+    std::string name = in_name + "/net_updates";
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/scalar", "time_per_edge", timeScalar / edgesSolved * 1E9, "ns" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/scalar", "edges_per_second", edgesSolved / timeScalar, "1/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/batch", "time_per_edge", timeBatch / edgesSolved * 1E9, "ns" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name + "/batch", "edges_per_second", edgesSolved / timeBatch, "1/s" );
+    tsunami_lab::benchmarks::Benchmark::report( io_stream, name, "speedup_batch", timeScalar / timeBatch, "" );
+  }
+
+  void benchFWave( std::ostream & io_stream ) {
+    benchSolver< tsunami_lab::solvers::FWave >( "FWave", io_stream );
+  }
+
+  void benchRoe( std::ostream & io_stream ) {
+    benchSolver< tsunami_lab::solvers::Roe >( "Roe", io_stream );
+  }
+
+  tsunami_lab::benchmarks::Benchmark fWave( "FWave/net_updates", benchFWave );
+  tsunami_lab::benchmarks::Benchmark roe( "Roe/net_updates", benchRoe );
+}
@@ -5,122 +5,394 @@
  * Roe Riemann solver for the shallow water equations.
  **/
 #include "Roe.h"
+#include "Simd.h"
+#include <algorithm>
 #include <cmath>
 
-void tsunami_lab::solvers::Roe::waveSpeeds( t_real   i_hL,
-                                            t_real   i_hR,
-                                            t_real   i_uL,
-                                            t_real   i_uR,
-                                            t_real & o_waveSpeedL,
-                                            t_real & o_waveSpeedR ) {
-  // pre-compute square-root ops
-  t_real l_hSqrtL = std::sqrt( i_hL );
-  t_real l_hSqrtR = std::sqrt( i_hR );
-
-  // compute Roe averages
-  t_real l_hRoe = 0.5f * ( i_hL + i_hR );
-  t_real l_uRoe = l_hSqrtL * i_uL + l_hSqrtR * i_uR;
-  l_uRoe /= l_hSqrtL + l_hSqrtR;
-
-  // compute wave speeds
-  t_real l_ghSqrtRoe = m_gSqrt * std::sqrt( l_hRoe );
-  o_waveSpeedL = l_uRoe - l_ghSqrtRoe;
-  o_waveSpeedR = l_uRoe + l_ghSqrtRoe;
-}
+namespace {
+  using tsunami_lab::t_idx;
+  using tsunami_lab::t_real;
+  using tsunami_lab::t_realCompute;
 
-void tsunami_lab::solvers::Roe::waveStrengths( t_real   i_hL,
-                                               t_real   i_hR,
-                                               t_real   i_huL,
-                                               t_real   i_huR,
-                                               t_real   i_waveSpeedL,
-                                               t_real   i_waveSpeedR,
-                                               t_real & o_strengthL,
-                                               t_real & o_strengthR ) {
-  // compute inverse of right eigenvector-matrix
-  t_real l_detInv = 1 / (i_waveSpeedR - i_waveSpeedL);
-
-  t_real l_rInv[2][2] = {0};
-  l_rInv[0][0] =  l_detInv * i_waveSpeedR;
-  l_rInv[0][1] = -l_detInv;
-  l_rInv[1][0] = -l_detInv * i_waveSpeedL;
-  l_rInv[1][1] =  l_detInv;
-
-  // compute jump in quantities
-  t_real l_hJump  = i_hR  - i_hL;
-  t_real l_huJump = i_huR - i_huL;
-
-  // compute wave strengths
-  o_strengthL  = l_rInv[0][0] * l_hJump;
-  o_strengthL += l_rInv[0][1] * l_huJump;
-
-  o_strengthR  = l_rInv[1][0] * l_hJump;
-  o_strengthR += l_rInv[1][1] * l_huJump;
-}
+  //! signature of the batched kernels
+  typedef void (*t_batchKernel)( t_idx,
+                                 t_real const *, t_real const *, t_real const *, t_real const *,
+                                 t_real *, t_real *, t_real *, t_real *, t_real * );
+
+  //! signature of the batched kernels which consume cached cell quantities
+  typedef void (*t_batchCachedKernel)( t_idx,
+                                       t_real const *, t_real const *, t_real const *, t_real const *,
+                                       t_realCompute const *, t_realCompute const *, t_realCompute const *, t_realCompute const *,
+                                       t_real *, t_real *, t_real *, t_real *, t_real * );
+
+  //! signature of the batched kernels of the cell quantities
+  typedef void (*t_cellKernel)( t_idx, t_real const *, t_real const *, t_realCompute *, t_realCompute * );
+
+  //! signature of the batched kernels of the wall edges
+  typedef void (*t_wallKernel)( t_idx, t_real const *, t_real const *, bool, t_real *, t_real *, t_real * );
+
+  /**
+   * Branch-free Roe solver for a single edge, given the states and the square roots of the heights and particle velocities of both cells.
+   * Follows the operations of Roe::netUpdates step by step.
+   **/
+  TSUNAMI_LAB_SIMD_INLINE void solveEdge( t_real   i_hL,
+                                          t_real   i_hR,
+                                          t_real   i_huL,
+                                          t_real   i_huR,
+                                          t_real   i_hSqrtL,
+                                          t_real   i_hSqrtR,
+                                          t_real   i_uL,
+                                          t_real   i_uR,
+                                          t_real & o_netUpdateLH,
+                                          t_real & o_netUpdateLHu,
+                                          t_real & o_netUpdateRH,
+                                          t_real & o_netUpdateRHu,
+                                          t_real & o_waveSpeed ) {
+    t_real const l_gSqrt = 3.131557121;
+
+    // compute wave speeds
+    t_real l_hRoe = 0.5f * ( i_hL + i_hR );
+    t_real l_uRoe = i_hSqrtL * i_uL + i_hSqrtR * i_uR;
+    l_uRoe /= i_hSqrtL + i_hSqrtR;
+
+    t_real l_ghSqrtRoe = l_gSqrt * std::sqrt( l_hRoe );
+    t_real l_sL = l_uRoe - l_ghSqrtRoe;
+    t_real l_sR = l_uRoe + l_ghSqrtRoe;
+
+    // compute wave strengths
+    t_real l_detInv = 1 / (l_sR - l_sL);
+
+    t_real l_hJump  = i_hR  - i_hL;
+    t_real l_huJump = i_huR - i_huL;
 
-void tsunami_lab::solvers::Roe::netUpdates( t_real i_hL,
-                                            t_real i_hR,
-                                            t_real i_huL,
-                                            t_real i_huR,
-                                            t_real o_netUpdateL[2],
-                                            t_real o_netUpdateR[2] ) {
-  // compute particle velocities
-  t_real l_uL = i_huL / i_hL;
-  t_real l_uR = i_huR / i_hR;
-
-  // compute wave speeds
-  t_real l_sL = 0;
-  t_real l_sR = 0;
-
-  waveSpeeds( i_hL,
-              i_hR,
-              l_uL,
-              l_uR,
-              l_sL,
-              l_sR );
-
-  // compute wave strengths
-  t_real l_aL = 0;
-  t_real l_aR = 0;
-
-  waveStrengths( i_hL,
-                 i_hR,
-                 i_huL,
-                 i_huR,
-                 l_sL,
-                 l_sR,
-                 l_aL,
-                 l_aR );
-
-  // compute scaled waves
-  t_real l_waveL[2] = {0};
-  t_real l_waveR[2] = {0};
-
-  l_waveL[0] = l_sL * l_aL;
-  l_waveL[1] = l_sL * l_aL * l_sL;
-
-  l_waveR[0] = l_sR * l_aR;
-  l_waveR[1] = l_sR * l_aR * l_sR;
-
-  // set net-updates depending on wave speeds
-  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
-    // init
-    o_netUpdateL[l_qt] = 0;
-    o_netUpdateR[l_qt] = 0;
-
-    // 1st wave
-    if( l_sL < 0 ) {
-      o_netUpdateL[l_qt] = l_waveL[l_qt];
+    t_real l_aL  = l_detInv * l_sR * l_hJump;
+    l_aL += -l_detInv * l_huJump;
+
+    t_real l_aR  = -l_detInv * l_sL * l_hJump;
+    l_aR += l_detInv * l_huJump;
+
+    // compute scaled waves
+    t_real l_waveL[2] = { l_sL * l_aL, l_sL * l_aL * l_sL };
+    t_real l_waveR[2] = { l_sR * l_aR, l_sR * l_aR * l_sR };
+
+    // masked blends of the waves, the 2nd wave overrides the 1st one as in the scalar solver
+    bool l_leftL = l_sL < 0;
+    bool l_rightR = l_sR > 0;
+
+    o_netUpdateLH  = l_rightR ? ( l_leftL ? l_waveL[0] : t_real(0) ) : l_waveR[0];
+    o_netUpdateLHu = l_rightR ? ( l_leftL ? l_waveL[1] : t_real(0) ) : l_waveR[1];
+    o_netUpdateRH  = l_rightR ? l_waveR[0] : ( l_leftL ? t_real(0) : l_waveL[0] );
+    o_netUpdateRHu = l_rightR ? l_waveR[1] : ( l_leftL ? t_real(0) : l_waveL[1] );
+
+    o_waveSpeed = std::max( std::abs( l_sL ), std::abs( l_sR ) );
+  }
+
+  /**
+   * Branch-free Roe solver for a batch of edges.
+   **/
+  TSUNAMI_LAB_SIMD_INLINE void netUpdatesBatchKernel( t_idx          i_count,
+                                                       t_real const * i_hL,
+                                                       t_real const * i_hR,
+                                                       t_real const * i_huL,
+                                                       t_real const * i_huR,
+                                                       t_real       * o_netUpdateLH,
+                                                       t_real       * o_netUpdateLHu,
+                                                       t_real       * o_netUpdateRH,
+                                                       t_real       * o_netUpdateRHu,
+                                                       t_real       * o_waveSpeed ) {
+#pragma omp simd
+    for( t_idx l_ed = 0; l_ed < i_count; l_ed++ ) {
+      t_real l_hL = i_hL[l_ed];
+      t_real l_hR = i_hR[l_ed];
+      t_real l_huL = i_huL[l_ed];
+      t_real l_huR = i_huR[l_ed];
+
+      solveEdge( l_hL, l_hR, l_huL, l_huR,
+                 std::sqrt( l_hL ), std::sqrt( l_hR ),
+                 l_huL / l_hL, l_huR / l_hR,
+                 o_netUpdateLH[l_ed], o_netUpdateLHu[l_ed],
+                 o_netUpdateRH[l_ed], o_netUpdateRHu[l_ed],
+                 o_waveSpeed[l_ed] );
     }
-    else {
-      o_netUpdateR[l_qt] = l_waveL[l_qt];
+  }
+
+  /**
+   * Branch-free Roe solver for a batch of edges with cached cell quantities; saves two square roots and two divisions per edge.
+   **/
+  TSUNAMI_LAB_SIMD_INLINE void netUpdatesBatchCachedKernel( t_idx                 i_count,
+                                                             t_real        const * i_hL,
+                                                             t_real        const * i_hR,
+                                                             t_real        const * i_huL,
+                                                             t_real        const * i_huR,
+                                                             t_realCompute const * i_hSqrtL,
+                                                             t_realCompute const * i_hSqrtR,
+                                                             t_realCompute const * i_uL,
+                                                             t_realCompute const * i_uR,
+                                                             t_real              * o_netUpdateLH,
+                                                             t_real              * o_netUpdateLHu,
+                                                             t_real              * o_netUpdateRH,
+                                                             t_real              * o_netUpdateRHu,
+                                                             t_real              * o_waveSpeed ) {
+#pragma omp simd
+    for( t_idx l_ed = 0; l_ed < i_count; l_ed++ ) {
+      solveEdge( i_hL[l_ed], i_hR[l_ed], i_huL[l_ed], i_huR[l_ed],
+                 t_real( i_hSqrtL[l_ed] ), t_real( i_hSqrtR[l_ed] ),
+                 t_real( i_uL[l_ed] ), t_real( i_uR[l_ed] ),
+                 o_netUpdateLH[l_ed], o_netUpdateLHu[l_ed],
+                 o_netUpdateRH[l_ed], o_netUpdateRHu[l_ed],
+                 o_waveSpeed[l_ed] );
     }
+  }
 
-    // 2nd wave
-    if( l_sR > 0 ) {
-      o_netUpdateR[l_qt] = l_waveR[l_qt];
+  /**
+   * Square roots of the heights and particle velocities of a batch of cells; computed in t_real as by the solver.
+   **/
+  TSUNAMI_LAB_SIMD_INLINE void cellQuantitiesBatchKernel( t_idx           i_count,
+                                                           t_real  const * i_h,
+                                                           t_real  const * i_hu,
+                                                           t_realCompute * o_hSqrt,
+                                                           t_realCompute * o_u ) {
+#pragma omp simd
+    for( t_idx l_ce = 0; l_ce < i_count; l_ce++ ) {
+      o_hSqrt[l_ce] = std::sqrt( i_h[l_ce] );
+      o_u[l_ce] = i_hu[l_ce] / i_h[l_ce];
     }
-    else {
-      o_netUpdateL[l_qt] = l_waveR[l_qt];
+  }
+
+  /**
+   * Net-updates of the wet cells of a batch of wall edges; solveEdge on the mirrored states reduced to the operations which do not vanish.
+   **/
+  TSUNAMI_LAB_SIMD_INLINE void wallNetUpdatesBatchKernel( t_idx          i_count,
+                                                           t_real const * i_h,
+                                                           t_real const * i_hu,
+                                                           bool           i_wallLeft,
+                                                           t_real       * o_netUpdateH,
+                                                           t_real       * o_netUpdateHu,
+                                                           t_real       * o_waveSpeed ) {
+    t_real const l_gSqrt = 3.131557121;
+
+    // a wall on the left is the mirror image of a wall on the right, the negations are exact
+    t_real l_side = i_wallLeft ? -1 : 1;
+
+#pragma omp simd
+    for( t_idx l_ed = 0; l_ed < i_count; l_ed++ ) {
+      t_real l_hu = l_side * i_hu[l_ed];
+
+      // wave speeds -+sqrt(g*h) of the Roe height h and the Roe velocity 0
+      t_real l_ghSqrtRoe = l_gSqrt * std::sqrt( i_h[l_ed] );
+      t_real l_detInv = 1 / ( l_ghSqrtRoe + l_ghSqrtRoe );
+
+      // the jump in the height vanishes, only the left-going wave reaches the wet cell
+      t_real l_aL = -l_detInv * ( -l_hu - l_hu );
+      t_real l_waveL = -l_ghSqrtRoe * l_aL;
+
+      o_netUpdateH[l_ed] = l_waveL;
+      o_netUpdateHu[l_ed] = l_side * ( l_waveL * -l_ghSqrtRoe );
+      o_waveSpeed[l_ed] = l_ghSqrtRoe;
     }
   }
-}
\ No newline at end of file
+
+  void netUpdatesBatchGeneric( t_idx i_count,
+                               t_real const * i_hL, t_real const * i_hR,
+                               t_real const * i_huL, t_real const * i_huR,
+                               t_real * o_lH, t_real * o_lHu, t_real * o_rH, t_real * o_rHu, t_real * o_speed ) {
+    netUpdatesBatchKernel( i_count, i_hL, i_hR, i_huL, i_huR, o_lH, o_lHu, o_rH, o_rHu, o_speed );
+  }
+
+#ifdef TSUNAMI_LAB_SIMD_X86
+  TSUNAMI_LAB_SIMD_AVX2 void netUpdatesBatchAvx2( t_idx i_count,
+                                                  t_real const * i_hL, t_real const * i_hR,
+                                                  t_real const * i_huL, t_real const * i_huR,
+                                                  t_real * o_lH, t_real * o_lHu, t_real * o_rH, t_real * o_rHu, t_real * o_speed ) {
+    netUpdatesBatchKernel( i_count, i_hL, i_hR, i_huL, i_huR, o_lH, o_lHu, o_rH, o_rHu, o_speed );
+  }
+
+  TSUNAMI_LAB_SIMD_AVX512 void netUpdatesBatchAvx512( t_idx i_count,
+                                                      t_real const * i_hL, t_real const * i_hR,
+                                                      t_real const * i_huL, t_real const * i_huR,
+                                                      t_real * o_lH, t_real * o_lHu, t_real * o_rH, t_real * o_rHu, t_real * o_speed ) {
+    netUpdatesBatchKernel( i_count, i_hL, i_hR, i_huL, i_huR, o_lH, o_lHu, o_rH, o_rHu, o_speed );
+  }
+#endif
+
+  void netUpdatesBatchCachedGeneric( t_idx i_count,
+                                     t_real const * i_hL, t_real const * i_hR,
+                                     t_real const * i_huL, t_real const * i_huR,
+                                     t_realCompute const * i_sL, t_realCompute const * i_sR,
+                                     t_realCompute const * i_uL, t_realCompute const * i_uR,
+                                     t_real * o_lH, t_real * o_lHu, t_real * o_rH, t_real * o_rHu, t_real * o_speed ) {
+    netUpdatesBatchCachedKernel( i_count, i_hL, i_hR, i_huL, i_huR, i_sL, i_sR, i_uL, i_uR, o_lH, o_lHu, o_rH, o_rHu, o_speed );
+  }
+
+  void cellQuantitiesBatchGeneric( t_idx i_count, t_real const * i_h, t_real const * i_hu, t_realCompute * o_hSqrt, t_realCompute * o_u ) {
+    cellQuantitiesBatchKernel( i_count, i_h, i_hu, o_hSqrt, o_u );
+  }
+
+  void wallNetUpdatesBatchGeneric( t_idx i_count, t_real const * i_h, t_real const * i_hu, bool i_wallLeft,
+                                   t_real * o_h, t_real * o_hu, t_real * o_speed ) {
+    wallNetUpdatesBatchKernel( i_count, i_h, i_hu, i_wallLeft, o_h, o_hu, o_speed );
+  }
+
+#ifdef TSUNAMI_LAB_SIMD_X86
+  TSUNAMI_LAB_SIMD_AVX2 void netUpdatesBatchCachedAvx2( t_idx i_count,
+                                                        t_real const * i_hL, t_real const * i_hR,
+                                                        t_real const * i_huL, t_real const * i_huR,
+                                                        t_realCompute const * i_sL, t_realCompute const * i_sR,
+                                                        t_realCompute const * i_uL, t_realCompute const * i_uR,
+                                                        t_real * o_lH, t_real * o_lHu, t_real * o_rH, t_real * o_rHu, t_real * o_speed ) {
+    netUpdatesBatchCachedKernel( i_count, i_hL, i_hR, i_huL, i_huR, i_sL, i_sR, i_uL, i_uR, o_lH, o_lHu, o_rH, o_rHu, o_speed );
+  }
+
+  TSUNAMI_LAB_SIMD_AVX512 void netUpdatesBatchCachedAvx512( t_idx i_count,
+                                                            t_real const * i_hL, t_real const * i_hR,
+                                                            t_real const * i_huL, t_real const * i_huR,
+                                                            t_realCompute const * i_sL, t_realCompute const * i_sR,
+                                                            t_realCompute const * i_uL, t_realCompute const * i_uR,
+                                                            t_real * o_lH, t_real * o_lHu, t_real * o_rH, t_real * o_rHu, t_real * o_speed ) {
+    netUpdatesBatchCachedKernel( i_count, i_hL, i_hR, i_huL, i_huR, i_sL, i_sR, i_uL, i_uR, o_lH, o_lHu, o_rH, o_rHu, o_speed );
+  }
+
+  TSUNAMI_LAB_SIMD_AVX2 void cellQuantitiesBatchAvx2( t_idx i_count, t_real const * i_h, t_real const * i_hu, t_realCompute * o_hSqrt, t_realCompute * o_u ) {
+    cellQuantitiesBatchKernel( i_count, i_h, i_hu, o_hSqrt, o_u );
+  }
+
+  TSUNAMI_LAB_SIMD_AVX512 void cellQuantitiesBatchAvx512( t_idx i_count, t_real const * i_h, t_real const * i_hu, t_realCompute * o_hSqrt, t_realCompute * o_u ) {
+    cellQuantitiesBatchKernel( i_count, i_h, i_hu, o_hSqrt, o_u );
+  }
+
+  TSUNAMI_LAB_SIMD_AVX2 void wallNetUpdatesBatchAvx2( t_idx i_count, t_real const * i_h, t_real const * i_hu, bool i_wallLeft,
+                                                      t_real * o_h, t_real * o_hu, t_real * o_speed ) {
+    wallNetUpdatesBatchKernel( i_count, i_h, i_hu, i_wallLeft, o_h, o_hu, o_speed );
+  }
+
+  TSUNAMI_LAB_SIMD_AVX512 void wallNetUpdatesBatchAvx512( t_idx i_count, t_real const * i_h, t_real const * i_hu, bool i_wallLeft,
+                                                          t_real * o_h, t_real * o_hu, t_real * o_speed ) {
+    wallNetUpdatesBatchKernel( i_count, i_h, i_hu, i_wallLeft, o_h, o_hu, o_speed );
+  }
+#endif
+
+  t_batchKernel selectBatchKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+    tsunami_lab::solvers::Isa l_isa = tsunami_lab::solvers::detectIsa();
+    if( l_isa == tsunami_lab::solvers::AVX512 ) return netUpdatesBatchAvx512;
+    if( l_isa == tsunami_lab::solvers::AVX2 ) return netUpdatesBatchAvx2;
+#endif
+    return netUpdatesBatchGeneric;
+  }
+
+  t_batchCachedKernel selectBatchCachedKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+    tsunami_lab::solvers::Isa l_isa = tsunami_lab::solvers::detectIsa();
+    if( l_isa == tsunami_lab::solvers::AVX512 ) return netUpdatesBatchCachedAvx512;
+    if( l_isa == tsunami_lab::solvers::AVX2 ) return netUpdatesBatchCachedAvx2;
+#endif
+    return netUpdatesBatchCachedGeneric;
+  }
+
+  t_cellKernel selectCellKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+    tsunami_lab::solvers::Isa l_isa = tsunami_lab::solvers::detectIsa();
+    if( l_isa == tsunami_lab::solvers::AVX512 ) return cellQuantitiesBatchAvx512;
+    if( l_isa == tsunami_lab::solvers::AVX2 ) return cellQuantitiesBatchAvx2;
+#endif
+    return cellQuantitiesBatchGeneric;
+  }
+
+  t_wallKernel selectWallKernel() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+    tsunami_lab::solvers::Isa l_isa = tsunami_lab::solvers::detectIsa();
+    if( l_isa == tsunami_lab::solvers::AVX512 ) return wallNetUpdatesBatchAvx512;
+    if( l_isa == tsunami_lab::solvers::AVX2 ) return wallNetUpdatesBatchAvx2;
+#endif
+    return wallNetUpdatesBatchGeneric;
+  }
+}
+
+void tsunami_lab::solvers::Roe::netUpdatesBatch( t_idx          i_count,
+                                                 t_real const * i_hL,
+                                                 t_real const * i_hR,
+                                                 t_real const * i_huL,
+                                                 t_real const * i_huR,
+                                                 t_real       * o_netUpdateLH,
+                                                 t_real       * o_netUpdateLHu,
+                                                 t_real       * o_netUpdateRH,
+                                                 t_real       * o_netUpdateRHu,
+                                                 t_real       * o_waveSpeed ) {
+  static t_batchKernel const l_kernel = selectBatchKernel();
+
+  l_kernel( i_count,
+            i_hL,
+            i_hR,
+            i_huL,
+            i_huR,
+            o_netUpdateLH,
+            o_netUpdateLHu,
+            o_netUpdateRH,
+            o_netUpdateRHu,
+            o_waveSpeed );
+}
+
+void tsunami_lab::solvers::Roe::netUpdatesBatchCached( t_idx                 i_count,
+                                                       t_real        const * i_hL,
+                                                       t_real        const * i_hR,
+                                                       t_real        const * i_huL,
+                                                       t_real        const * i_huR,
+                                                       t_realCompute const * i_hSqrtL,
+                                                       t_realCompute const * i_hSqrtR,
+                                                       t_realCompute const * i_uL,
+                                                       t_realCompute const * i_uR,
+                                                       t_real              * o_netUpdateLH,
+                                                       t_real              * o_netUpdateLHu,
+                                                       t_real              * o_netUpdateRH,
+                                                       t_real              * o_netUpdateRHu,
+                                                       t_real              * o_waveSpeed ) {
+  static t_batchCachedKernel const l_kernel = selectBatchCachedKernel();
+
+  l_kernel( i_count,
+            i_hL,
+            i_hR,
+            i_huL,
+            i_huR,
+            i_hSqrtL,
+            i_hSqrtR,
+            i_uL,
+            i_uR,
+            o_netUpdateLH,
+            o_netUpdateLHu,
+            o_netUpdateRH,
+            o_netUpdateRHu,
+            o_waveSpeed );
+}
+
+void tsunami_lab::solvers::Roe::cellQuantitiesBatch( t_idx                 i_count,
+                                                     t_real        const * i_h,
+                                                     t_real        const * i_hu,
+                                                     t_realCompute       * o_hSqrt,
+                                                     t_realCompute       * o_u,
+                                                     t_realCompute       * ) {
+  static t_cellKernel const l_kernel = selectCellKernel();
+
+  l_kernel( i_count,
+            i_h,
+            i_hu,
+            o_hSqrt,
+            o_u );
+}
+
+void tsunami_lab::solvers::Roe::wallNetUpdatesBatch( t_idx          i_count,
+                                                     t_real const * i_h,
+                                                     t_real const * i_hu,
+                                                     bool           i_wallLeft,
+                                                     t_real       * o_netUpdateH,
+                                                     t_real       * o_netUpdateHu,
+                                                     t_real       * o_waveSpeed ) {
+  static t_wallKernel const l_kernel = selectWallKernel();
+
+  l_kernel( i_count,
+            i_h,
+            i_hu,
+            i_wallLeft,
+            o_netUpdateH,
+            o_netUpdateHu,
+            o_waveSpeed );
+}
@@ -8,6 +8,8 @@
 #define TSUNAMI_LAB_SOLVERS_ROE
 
 #include "../constants.h"
+#include <algorithm>
+#include <cmath>
 
 namespace tsunami_lab {
   namespace solvers {
@@ -75,6 +77,423 @@ class tsunami_lab::solvers::Roe {
                             t_real i_huR,
                             t_real o_netUpdateL[2],
                             t_real o_netUpdateR[2] );
+
+    /**
+     * Computes the net-updates and the maximum wave speed of the edge.
+     *
+     * @param i_hL height of the left side.
+     * @param i_hR height of the right side.
+     * @param i_huL momentum of the left side.
+     * @param i_huR momentum of the right side.
+     * @param o_netUpdateL will be set to the net-updates for the left side; 0: height, 1: momentum.
+     * @param o_netUpdateR will be set to the net-updates for the right side; 0: height, 1: momentum.
+     * @param o_waveSpeedMax will be set to the maximum absolute value of the two wave speeds.
+     **/
+    static void netUpdates( t_real   i_hL,
+                            t_real   i_hR,
+                            t_real   i_huL,
+                            t_real   i_huR,
+                            t_real   o_netUpdateL[2],
+                            t_real   o_netUpdateR[2],
+                            t_real & o_waveSpeedMax );
+
+    /**
+     * Computes the net-updates and the maximum wave speed of an edge given by the quantities of its cells.
+     *
+     * Common interface of the solvers, which is used by the patches templated on the solver.
+     * The Roe solver does not support bathymetry, thus the bathymetry is ignored.
+     *
+     * @param i_hL height of the left side.
+     * @param i_hR height of the right side.
+     * @param i_huL momentum of the left side.
+     * @param i_huR momentum of the right side.
+     * @param i_bL bathymetry of the left side (ignored).
+     * @param i_bR bathymetry of the right side (ignored).
+     * @param o_netUpdateL will be set to the net-updates for the left side; 0: height, 1: momentum.
+     * @param o_netUpdateR will be set to the net-updates for the right side; 0: height, 1: momentum.
+     * @param o_waveSpeedMax will be set to the maximum absolute value of the two wave speeds.
+     **/
+    static void netUpdates( t_real   i_hL,
+                            t_real   i_hR,
+                            t_real   i_huL,
+                            t_real   i_huR,
+                            t_real   i_bL,
+                            t_real   i_bR,
+                            t_real   o_netUpdateL[2],
+                            t_real   o_netUpdateR[2],
+                            t_real & o_waveSpeedMax );
+
+    /**
+     * Computes the net-updates of a batch of edges given as contiguous arrays.
+     *
+     * Branch-free version of netUpdates: the selection of the waves by the sign of the wave speeds is done
+     * through masked blends, the instruction set (AVX-512, AVX2 or generic) is selected once at runtime.
+     * Results are bitwise identical to netUpdates (without floating point contraction, see SConstruct).
+     *
+     * @param i_count number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param o_netUpdateLH will be set to the net-updates of the height for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momentum for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the height for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momentum for the right sides.
+     * @param o_waveSpeed will be set to the maximum absolute values of the two wave speeds.
+     **/
+    static void netUpdatesBatch( t_idx          i_count,
+                                 t_real const * i_hL,
+                                 t_real const * i_hR,
+                                 t_real const * i_huL,
+                                 t_real const * i_huR,
+                                 t_real       * o_netUpdateLH,
+                                 t_real       * o_netUpdateLHu,
+                                 t_real       * o_netUpdateRH,
+                                 t_real       * o_netUpdateRHu,
+                                 t_real       * o_waveSpeed );
+
+    /**
+     * Computes the net-updates of a batch of edges given by the quantities of their cells.
+     *
+     * Common interface of the solvers, which is used by the patches templated on the solver.
+     * The Roe solver does not support bathymetry, thus the bathymetry is ignored.
+     *
+     * @param i_count number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_bL bathymetry of the left sides (ignored).
+     * @param i_bR bathymetry of the right sides (ignored).
+     * @param o_netUpdateLH will be set to the net-updates of the height for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momentum for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the height for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momentum for the right sides.
+     * @param o_waveSpeed will be set to the maximum absolute values of the two wave speeds.
+     **/
+    static void netUpdatesBatch( t_idx          i_count,
+                                 t_real const * i_hL,
+                                 t_real const * i_hR,
+                                 t_real const * i_huL,
+                                 t_real const * i_huR,
+                                 t_real const * i_bL,
+                                 t_real const * i_bR,
+                                 t_real       * o_netUpdateLH,
+                                 t_real       * o_netUpdateLHu,
+                                 t_real       * o_netUpdateRH,
+                                 t_real       * o_netUpdateRHu,
+                                 t_real       * o_waveSpeed ) {
+      (void) i_bL;
+      (void) i_bR;
+      netUpdatesBatch( i_count,
+                       i_hL,
+                       i_hR,
+                       i_huL,
+                       i_huR,
+                       o_netUpdateLH,
+                       o_netUpdateLHu,
+                       o_netUpdateRH,
+                       o_netUpdateRHu,
+                       o_waveSpeed );
+    }
+
+    /**
+     * Computes the square roots of the heights and the particle velocities of a batch of cells,
+     * which are shared by the edges of the cells.
+     *
+     * Common interface of the solvers, which is used by the patches templated on the solver.
+     * The Roe solver does not use the flux, thus the flux is not written.
+     *
+     * @param i_count number of cells.
+     * @param i_h heights of the cells.
+     * @param i_hu momenta of the cells in the direction of the sweep.
+     * @param o_hSqrt will be set to the square roots of the heights.
+     * @param o_u will be set to the particle velocities.
+     * @param o_flux fluxes of the momentum (not written).
+     **/
+    static void cellQuantitiesBatch( t_idx                 i_count,
+                                     t_real        const * i_h,
+                                     t_real        const * i_hu,
+                                     t_realCompute       * o_hSqrt,
+                                     t_realCompute       * o_u,
+                                     t_realCompute       * o_flux );
+
+    /**
+     * Computes the net-updates of a batch of edges with the cell quantities of cellQuantitiesBatch.
+     * Results are bitwise identical to netUpdatesBatch.
+     *
+     * @param i_count number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_hSqrtL square roots of the heights of the left sides.
+     * @param i_hSqrtR square roots of the heights of the right sides.
+     * @param i_uL particle velocities of the left sides.
+     * @param i_uR particle velocities of the right sides.
+     * @param o_netUpdateLH will be set to the net-updates of the height for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momentum for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the height for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momentum for the right sides.
+     * @param o_waveSpeed will be set to the maximum absolute values of the two wave speeds.
+     **/
+    static void netUpdatesBatchCached( t_idx                 i_count,
+                                       t_real        const * i_hL,
+                                       t_real        const * i_hR,
+                                       t_real        const * i_huL,
+                                       t_real        const * i_huR,
+                                       t_realCompute const * i_hSqrtL,
+                                       t_realCompute const * i_hSqrtR,
+                                       t_realCompute const * i_uL,
+                                       t_realCompute const * i_uR,
+                                       t_real              * o_netUpdateLH,
+                                       t_real              * o_netUpdateLHu,
+                                       t_real              * o_netUpdateRH,
+                                       t_real              * o_netUpdateRHu,
+                                       t_real              * o_waveSpeed );
+
+    /**
+     * Computes the net-updates of a batch of edges given by the quantities of their cells and the cached cell quantities.
+     *
+     * Common interface of the solvers, which is used by the patches templated on the solver.
+     * The Roe solver does not support bathymetry and does not use the flux, thus both are ignored.
+     *
+     * @param i_count number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_bL bathymetry of the left sides (ignored).
+     * @param i_bR bathymetry of the right sides (ignored).
+     * @param i_hSqrtL square roots of the heights of the left sides.
+     * @param i_hSqrtR square roots of the heights of the right sides.
+     * @param i_uL particle velocities of the left sides.
+     * @param i_uR particle velocities of the right sides.
+     * @param i_fluxL fluxes of the momentum of the left sides (ignored).
+     * @param i_fluxR fluxes of the momentum of the right sides (ignored).
+     * @param o_netUpdateLH will be set to the net-updates of the height for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momentum for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the height for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momentum for the right sides.
+     * @param o_waveSpeed will be set to the maximum absolute values of the two wave speeds.
+     **/
+    static void netUpdatesBatchCached( t_idx                 i_count,
+                                       t_real        const * i_hL,
+                                       t_real        const * i_hR,
+                                       t_real        const * i_huL,
+                                       t_real        const * i_huR,
+                                       t_real        const * i_bL,
+                                       t_real        const * i_bR,
+                                       t_realCompute const * i_hSqrtL,
+                                       t_realCompute const * i_hSqrtR,
+                                       t_realCompute const * i_uL,
+                                       t_realCompute const * i_uR,
+                                       t_realCompute const * i_fluxL,
+                                       t_realCompute const * i_fluxR,
+                                       t_real              * o_netUpdateLH,
+                                       t_real              * o_netUpdateLHu,
+                                       t_real              * o_netUpdateRH,
+                                       t_real              * o_netUpdateRHu,
+                                       t_real              * o_waveSpeed ) {
+      (void) i_bL;
+      (void) i_bR;
+      (void) i_fluxL;
+      (void) i_fluxR;
+      netUpdatesBatchCached( i_count,
+                             i_hL,
+                             i_hR,
+                             i_huL,
+                             i_huR,
+                             i_hSqrtL,
+                             i_hSqrtR,
+                             i_uL,
+                             i_uR,
+                             o_netUpdateLH,
+                             o_netUpdateLHu,
+                             o_netUpdateRH,
+                             o_netUpdateRHu,
+                             o_waveSpeed );
+    }
+
+    /**
+     * Computes the net-updates of the wet cells of a batch of edges whose other cell is dry, i.e., a reflecting wall.
+     *
+     * The wall mirrors the wet cell with the negated momentum. Thus, the Roe velocity and the jump in the height vanish,
+     * which saves the square roots of the cells and the divisions of netUpdatesBatch.
+     * Results are bitwise identical to netUpdatesBatch on the mirrored states.
+     *
+     * @param i_count number of edges.
+     * @param i_h heights of the wet cells.
+     * @param i_hu momenta of the wet cells.
+     * @param i_wallLeft true if the walls are left of the wet cells, false if they are right of them.
+     * @param o_netUpdateH will be set to the net-updates of the height for the wet cells.
+     * @param o_netUpdateHu will be set to the net-updates of the momentum for the wet cells.
+     * @param o_waveSpeed will be set to the maximum absolute values of the two wave speeds.
+     **/
+    static void wallNetUpdatesBatch( t_idx          i_count,
+                                     t_real const * i_h,
+                                     t_real const * i_hu,
+                                     bool           i_wallLeft,
+                                     t_real       * o_netUpdateH,
+                                     t_real       * o_netUpdateHu,
+                                     t_real       * o_waveSpeed );
 };
 
+// the scalar solver is defined inline, such that it is inlined into the edge loops of the patches
+inline void tsunami_lab::solvers::Roe::waveSpeeds( t_real   i_hL,
+                                            t_real   i_hR,
+                                            t_real   i_uL,
+                                            t_real   i_uR,
+                                            t_real & o_waveSpeedL,
+                                            t_real & o_waveSpeedR ) {
+  // pre-compute square-root ops
+  t_real l_hSqrtL = std::sqrt( i_hL );
+  t_real l_hSqrtR = std::sqrt( i_hR );
+
+  // compute Roe averages
+  t_real l_hRoe = 0.5f * ( i_hL + i_hR );
+  t_real l_uRoe = l_hSqrtL * i_uL + l_hSqrtR * i_uR;
+  l_uRoe /= l_hSqrtL + l_hSqrtR;
+
+  // compute wave speeds
+  t_real l_ghSqrtRoe = m_gSqrt * std::sqrt( l_hRoe );
+  o_waveSpeedL = l_uRoe - l_ghSqrtRoe;
+  o_waveSpeedR = l_uRoe + l_ghSqrtRoe;
+}
+
+inline void tsunami_lab::solvers::Roe::waveStrengths( t_real   i_hL,
+                                               t_real   i_hR,
+                                               t_real   i_huL,
+                                               t_real   i_huR,
+                                               t_real   i_waveSpeedL,
+                                               t_real   i_waveSpeedR,
+                                               t_real & o_strengthL,
+                                               t_real & o_strengthR ) {
+  // compute inverse of right eigenvector-matrix
+  t_real l_detInv = 1 / (i_waveSpeedR - i_waveSpeedL);
+
+  t_real l_rInv[2][2] = {0};
+  l_rInv[0][0] =  l_detInv * i_waveSpeedR;
+  l_rInv[0][1] = -l_detInv;
+  l_rInv[1][0] = -l_detInv * i_waveSpeedL;
+  l_rInv[1][1] =  l_detInv;
+
+  // compute jump in quantities
+  t_real l_hJump  = i_hR  - i_hL;
+  t_real l_huJump = i_huR - i_huL;
+
+  // compute wave strengths
+  o_strengthL  = l_rInv[0][0] * l_hJump;
+  o_strengthL += l_rInv[0][1] * l_huJump;
+
+  o_strengthR  = l_rInv[1][0] * l_hJump;
+  o_strengthR += l_rInv[1][1] * l_huJump;
+}
+
+inline void tsunami_lab::solvers::Roe::netUpdates( t_real i_hL,
+                                            t_real i_hR,
+                                            t_real i_huL,
+                                            t_real i_huR,
+                                            t_real o_netUpdateL[2],
+                                            t_real o_netUpdateR[2] ) {
+  t_real l_waveSpeedMax = 0;
+
+  netUpdates( i_hL,
+              i_hR,
+              i_huL,
+              i_huR,
+              o_netUpdateL,
+              o_netUpdateR,
+              l_waveSpeedMax );
+}
+
+inline void tsunami_lab::solvers::Roe::netUpdates( t_real   i_hL,
+                                            t_real   i_hR,
+                                            t_real   i_huL,
+                                            t_real   i_huR,
+                                            t_real   o_netUpdateL[2],
+                                            t_real   o_netUpdateR[2],
+                                            t_real & o_waveSpeedMax ) {
+  // compute particle velocities
+  t_real l_uL = i_huL / i_hL;
+  t_real l_uR = i_huR / i_hR;
+
+  // compute wave speeds
+  t_real l_sL = 0;
+  t_real l_sR = 0;
+
+  waveSpeeds( i_hL,
+              i_hR,
+              l_uL,
+              l_uR,
+              l_sL,
+              l_sR );
+
+  o_waveSpeedMax = std::max( std::abs( l_sL ), std::abs( l_sR ) );
+
+  // compute wave strengths
+  t_real l_aL = 0;
+  t_real l_aR = 0;
+
+  waveStrengths( i_hL,
+                 i_hR,
+                 i_huL,
+                 i_huR,
+                 l_sL,
+                 l_sR,
+                 l_aL,
+                 l_aR );
+
+  // compute scaled waves
+  t_real l_waveL[2] = {0};
+  t_real l_waveR[2] = {0};
+
+  l_waveL[0] = l_sL * l_aL;
+  l_waveL[1] = l_sL * l_aL * l_sL;
+
+  l_waveR[0] = l_sR * l_aR;
+  l_waveR[1] = l_sR * l_aR * l_sR;
+
+  // set net-updates depending on wave speeds
+  for( unsigned short l_qt = 0; l_qt < 2; l_qt++ ) {
+    // init
+    o_netUpdateL[l_qt] = 0;
+    o_netUpdateR[l_qt] = 0;
+
+    // 1st wave
+    if( l_sL < 0 ) {
+      o_netUpdateL[l_qt] = l_waveL[l_qt];
+    }
+    else {
+      o_netUpdateR[l_qt] = l_waveL[l_qt];
+    }
+
+    // 2nd wave
+    if( l_sR > 0 ) {
+      o_netUpdateR[l_qt] = l_waveR[l_qt];
+    }
+    else {
+      o_netUpdateL[l_qt] = l_waveR[l_qt];
+    }
+  }
+}
+
+inline void tsunami_lab::solvers::Roe::netUpdates( t_real   i_hL,
+                                                   t_real   i_hR,
+                                                   t_real   i_huL,
+                                                   t_real   i_huR,
+                                                   t_real,
+                                                   t_real,
+                                                   t_real   o_netUpdateL[2],
+                                                   t_real   o_netUpdateR[2],
+                                                   t_real & o_waveSpeedMax ) {
+  netUpdates( i_hL,
+              i_hR,
+              i_huL,
+              i_huR,
+              o_netUpdateL,
+              o_netUpdateR,
+              o_waveSpeedMax );
+}
+
 #endif
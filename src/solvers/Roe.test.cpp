@@ -5,6 +5,8 @@
  * Unit tests of the Roe Riemann solver.
  **/
 #include <catch2/catch.hpp>
+#include <random>
+#include <vector>
 #define private public
 #include "Roe.h"
 #undef public
@@ -21,8 +23,8 @@ TEST_CASE( "Test the derivation of the Roe speeds.", "[RoeSpeeds]" ) {
     * roe speeds: s1 = -0.079002116969172024 - sqrt(9.80665 * 9.5) = -9.7311093998375095
     *             s2 = -0.079002116969172024 + sqrt(9.80665 * 9.5) =  9.5731051658991654
     */
-  float l_waveSpeedL = 0;
-  float l_waveSpeedR = 0;
+  tsunami_lab::t_real l_waveSpeedL = 0;
+  tsunami_lab::t_real l_waveSpeedR = 0;
   tsunami_lab::solvers::Roe::waveSpeeds( 10,
                                          9,
                                          -3,
@@ -66,8 +68,8 @@ TEST_CASE( "Test the derivation of the Roe wave speeds.", "[RoeStrengths]" ) {
    * Rinv * |          | = |                     |
    *        | 27 - -30 |   |  2.4486306054668869 |
    */
-  float l_strengthL = 0;
-  float l_strengthR = 0;
+  tsunami_lab::t_real l_strengthL = 0;
+  tsunami_lab::t_real l_strengthR = 0;
 
   tsunami_lab::solvers::Roe::waveStrengths( 10,
                                             9,
@@ -103,8 +105,8 @@ TEST_CASE( "Test the derivation of the Roe net-updates.", "[RoeUpdates]" ) {
    * update #2: s2 * a2 * |    | = |                           |
    *                      | s2 |   | 224.403141905910928927533 |
    */
-  float l_netUpdatesL[2] = { -5, 3 };
-  float l_netUpdatesR[2] = {  4, 7 };
+  tsunami_lab::t_real l_netUpdatesL[2] = { -5, 3 };
+  tsunami_lab::t_real l_netUpdatesR[2] = {  4, 7 };
 
   tsunami_lab::solvers::Roe::netUpdates( 10,
                                          9,
@@ -155,12 +157,15 @@ TEST_CASE( "Test the derivation of the Roe net-updates.", "[RoeUpdates]" ) {
    * update #2: s2 * a2 * |    | = |               |
    *                      | s2 |   | -88.25985     |
    */
+  tsunami_lab::t_real l_waveSpeedMax = 0;
+
   tsunami_lab::solvers::Roe::netUpdates( 10,
                                          8,
                                          0,
                                          0,
                                          l_netUpdatesL,
-                                         l_netUpdatesR ); 
+                                         l_netUpdatesR,
+                                         l_waveSpeedMax ); 
 
   REQUIRE( l_netUpdatesL[0] ==  Approx(9.394671362) );
   REQUIRE( l_netUpdatesL[1] == -Approx(88.25985)    );
@@ -168,6 +173,8 @@ TEST_CASE( "Test the derivation of the Roe net-updates.", "[RoeUpdates]" ) {
   REQUIRE( l_netUpdatesR[0] == -Approx(9.394671362) );
   REQUIRE( l_netUpdatesR[1] == -Approx(88.25985)    );
 
+  REQUIRE( l_waveSpeedMax == Approx(9.394671362) );
+
   /*
    * Test case (trivial steady state):
    *
@@ -187,4 +194,124 @@ TEST_CASE( "Test the derivation of the Roe net-updates.", "[RoeUpdates]" ) {
 
   REQUIRE( l_netUpdatesR[0] == Approx(0) );
   REQUIRE( l_netUpdatesR[1] == Approx(0) );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Test the batched Roe net-updates against the scalar solver.", "[RoeUpdatesBatch]" ) {
+  /*
+   * The batch contains the states of the test cases above, a supersonic state in each direction
+   * and pseudo-random wet states. Batched and scalar net-updates are bitwise identical.
+   */
+  const std::size_t l_count = 5 + 1000;
+  std::vector< tsunami_lab::t_real > l_hL( l_count ), l_hR( l_count );
+  std::vector< tsunami_lab::t_real > l_huL( l_count ), l_huR( l_count );
+
+  tsunami_lab::t_real l_states[5][4] = { { 10,  9, -30,   27 },
+                           { 10,  8,   0,    0 },
+                           { 10, 10,   0,    0 },
+                           {  1,  1, 100,   10 },
+                           {  1,  1, -10, -100 } };
+
+  for( std::size_t l_ed = 0; l_ed < 5; l_ed++ ) {
+    l_hL[l_ed]  = l_states[l_ed][0];
+    l_hR[l_ed]  = l_states[l_ed][1];
+    l_huL[l_ed] = l_states[l_ed][2];
+    l_huR[l_ed] = l_states[l_ed][3];
+  }
+
+  std::mt19937 l_generator( 42 );
+  std::uniform_real_distribution< tsunami_lab::t_real > l_height( 0.1, 100 );
+  std::uniform_real_distribution< tsunami_lab::t_real > l_velocity( -50, 50 );
+  for( std::size_t l_ed = 5; l_ed < l_count; l_ed++ ) {
+    l_hL[l_ed]  = l_height( l_generator );
+    l_hR[l_ed]  = l_height( l_generator );
+    l_huL[l_ed] = l_hL[l_ed] * l_velocity( l_generator );
+    l_huR[l_ed] = l_hR[l_ed] * l_velocity( l_generator );
+  }
+
+  std::vector< tsunami_lab::t_real > l_netUpdateLH( l_count ), l_netUpdateLHu( l_count );
+  std::vector< tsunami_lab::t_real > l_netUpdateRH( l_count ), l_netUpdateRHu( l_count );
+  std::vector< tsunami_lab::t_real > l_waveSpeed( l_count );
+
+  tsunami_lab::solvers::Roe::netUpdatesBatch( l_count,
+                                              l_hL.data(),
+                                              l_hR.data(),
+                                              l_huL.data(),
+                                              l_huR.data(),
+                                              l_netUpdateLH.data(),
+                                              l_netUpdateLHu.data(),
+                                              l_netUpdateRH.data(),
+                                              l_netUpdateRHu.data(),
+                                              l_waveSpeed.data() );
+
+  for( std::size_t l_ed = 0; l_ed < l_count; l_ed++ ) {
+    tsunami_lab::t_real l_netUpdatesL[2];
+    tsunami_lab::t_real l_netUpdatesR[2];
+    tsunami_lab::t_real l_waveSpeedMax;
+
+    tsunami_lab::solvers::Roe::netUpdates( l_hL[l_ed],
+                                           l_hR[l_ed],
+                                           l_huL[l_ed],
+                                           l_huR[l_ed],
+                                           l_netUpdatesL,
+                                           l_netUpdatesR,
+                                           l_waveSpeedMax );
+
+    REQUIRE( l_netUpdateLH[l_ed]  == l_netUpdatesL[0] );
+    REQUIRE( l_netUpdateLHu[l_ed] == l_netUpdatesL[1] );
+    REQUIRE( l_netUpdateRH[l_ed]  == l_netUpdatesR[0] );
+    REQUIRE( l_netUpdateRHu[l_ed] == l_netUpdatesR[1] );
+    REQUIRE( l_waveSpeed[l_ed]    == l_waveSpeedMax );
+  }
+}
+
+TEST_CASE( "Test the Roe net-updates of reflecting walls against the mirrored states.", "[RoeUpdatesWall]" ) {
+  /*
+   * A wall mirrors the wet cell with the negated momentum. The closed-form update of the wet side is bitwise identical to the batch.
+   */
+  const std::size_t l_count = 1000;
+  std::vector< tsunami_lab::t_real > l_h( l_count ), l_hu( l_count ), l_huMirror( l_count );
+
+  std::mt19937 l_generator( 42 );
+  std::uniform_real_distribution< tsunami_lab::t_real > l_height( 0.1, 100 );
+  std::uniform_real_distribution< tsunami_lab::t_real > l_velocity( -50, 50 );
+  for( std::size_t l_ed = 0; l_ed < l_count; l_ed++ ) {
+    l_h[l_ed] = l_height( l_generator );
+    l_hu[l_ed] = l_h[l_ed] * l_velocity( l_generator );
+    l_huMirror[l_ed] = -l_hu[l_ed];
+  }
+
+  std::vector< tsunami_lab::t_real > l_netUpdateLH( l_count ), l_netUpdateLHu( l_count );
+  std::vector< tsunami_lab::t_real > l_netUpdateRH( l_count ), l_netUpdateRHu( l_count );
+  std::vector< tsunami_lab::t_real > l_waveSpeed( l_count );
+  std::vector< tsunami_lab::t_real > l_netUpdateWallH( l_count ), l_netUpdateWallHu( l_count ), l_waveSpeedWall( l_count );
+
+  for( unsigned short l_si = 0; l_si < 2; l_si++ ) {
+    // wall right of the wet cells (0) or left of them (1)
+    bool l_wallLeft = l_si == 1;
+
+    tsunami_lab::solvers::Roe::netUpdatesBatch( l_count,
+                                                l_h.data(),
+                                                l_h.data(),
+                                                l_wallLeft ? l_huMirror.data() : l_hu.data(),
+                                                l_wallLeft ? l_hu.data() : l_huMirror.data(),
+                                                l_netUpdateLH.data(),
+                                                l_netUpdateLHu.data(),
+                                                l_netUpdateRH.data(),
+                                                l_netUpdateRHu.data(),
+                                                l_waveSpeed.data() );
+
+    tsunami_lab::solvers::Roe::wallNetUpdatesBatch( l_count,
+                                                    l_h.data(),
+                                                    l_hu.data(),
+                                                    l_wallLeft,
+                                                    l_netUpdateWallH.data(),
+                                                    l_netUpdateWallHu.data(),
+                                                    l_waveSpeedWall.data() );
+
+    for( std::size_t l_ed = 0; l_ed < l_count; l_ed++ ) {
+      REQUIRE( l_netUpdateWallH[l_ed]  == ( l_wallLeft ? l_netUpdateRH[l_ed] : l_netUpdateLH[l_ed] ) );
+      REQUIRE( l_netUpdateWallHu[l_ed] == ( l_wallLeft ? l_netUpdateRHu[l_ed] : l_netUpdateLHu[l_ed] ) );
+      REQUIRE( l_waveSpeedWall[l_ed]   == l_waveSpeed[l_ed] );
+    }
+  }
+}
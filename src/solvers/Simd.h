@@ -0,0 +1,57 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Runtime selection of the instruction set for the batched solvers.
+ **/
+#ifndef TSUNAMI_LAB_SOLVERS_SIMD
+#define TSUNAMI_LAB_SOLVERS_SIMD
+
+/*
+ * The batched kernels are written once as branch-free loops and compiled for several instruction sets
+ * by placing them in functions with different target attributes. Only supported for GCC-compatible compilers on x86.
+ */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define TSUNAMI_LAB_SIMD_X86
+#define TSUNAMI_LAB_SIMD_AVX2 __attribute__((target("avx2")))
+#define TSUNAMI_LAB_SIMD_AVX512 __attribute__((target("avx512f")))
+#define TSUNAMI_LAB_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define TSUNAMI_LAB_SIMD_INLINE inline
+#endif
+
+namespace tsunami_lab {
+	namespace solvers {
+		//! instruction sets of the batched kernels
+		enum Isa { GENERIC, AVX2, AVX512 };
+
+		/**
+		 * @brief Detects the widest instruction set supported by the CPU.
+		 *
+		 * @return instruction set.
+		 **/
+		inline Isa detectIsa() {
+#ifdef TSUNAMI_LAB_SIMD_X86
+			__builtin_cpu_init();
+			if( __builtin_cpu_supports( "avx512f" ) ) return AVX512;
+			if( __builtin_cpu_supports( "avx2" ) ) return AVX2;
+#endif
+			return GENERIC;
+		}
+
+		/**
+		 * @brief Gets the name of an instruction set.
+		 *
+		 * @param in_isa instruction set.
+		 * @return name of the instruction set.
+		 **/
+		inline char const * isaName( Isa in_isa ) {
+			if( in_isa == AVX512 ) return "avx512";
+			if( in_isa == AVX2 ) return "avx2";
+			return "generic";
+		}
+	}
+}
+
+#endif
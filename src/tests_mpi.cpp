@@ -0,0 +1,26 @@
+/**
+ * @author Marek Sommerfeld (marek.sommerfeld AT uni-jena.de)
+ * @author Moritz Rätz (moritz.raetz AT uni-jena.de)
+ *
+ * @section DESCRIPTION
+ * Entry-point for the unit tests of the distributed runs, e.g., mpirun -np 4 ./build/tests_mpi
+ **/
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+#undef CATCH_CONFIG_RUNNER
+#include <mpi.h>
+
+int main( int   i_argc,
+          char* i_argv[] ) {
+  // the split schemes of the distributed patch exchange halos within OpenMP single regions
+  int l_provided = 0;
+  MPI_Init_thread( &i_argc, &i_argv, MPI_THREAD_SERIALIZED, &l_provided );
+  if( l_provided < MPI_THREAD_SERIALIZED ) {
+    MPI_Abort( MPI_COMM_WORLD, 1 );
+  }
+
+  int l_result = Catch::Session().run( i_argc, i_argv );
+
+  MPI_Finalize();
+  return ( l_result < 0xff ? l_result : 0xff );
+}